@@ -0,0 +1,5 @@
+-- Stat runs look up every league rostering a changed player in one
+-- player_id = ANY(...) query. uq_rosters_league_player leads with league_id,
+-- so without this index that lookup scans rosters.
+CREATE INDEX IF NOT EXISTS idx_rosters_player
+  ON rosters (player_id, league_id);
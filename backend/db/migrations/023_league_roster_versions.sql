@@ -0,0 +1,41 @@
+-- Free-agent pools are cached in memory per league and keyed by a roster
+-- version. Every statement that inserts or deletes rosters rows bumps the
+-- version of each league it touched, whichever code path or replica ran it.
+-- Slot-only updates do not change who is rostered and are not tracked.
+CREATE TABLE IF NOT EXISTS league_roster_versions (
+  league_id TEXT PRIMARY KEY,
+  version BIGINT NOT NULL DEFAULT 0,
+  updated_at TIMESTAMPTZ NOT NULL DEFAULT NOW()
+);
+
+CREATE OR REPLACE FUNCTION cff_bump_league_roster_versions()
+RETURNS TRIGGER AS $$
+BEGIN
+  IF TG_OP = 'INSERT' THEN
+    INSERT INTO league_roster_versions (league_id, version)
+    SELECT DISTINCT league_id, 1 FROM cff_changed_rosters_new ORDER BY league_id
+    ON CONFLICT (league_id) DO UPDATE
+      SET version = league_roster_versions.version + 1, updated_at = NOW();
+  ELSE
+    INSERT INTO league_roster_versions (league_id, version)
+    SELECT DISTINCT league_id, 1 FROM cff_changed_rosters_old ORDER BY league_id
+    ON CONFLICT (league_id) DO UPDATE
+      SET version = league_roster_versions.version + 1, updated_at = NOW();
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS trg_cff_roster_versions_insert ON rosters;
+CREATE TRIGGER trg_cff_roster_versions_insert
+AFTER INSERT ON rosters
+REFERENCING NEW TABLE AS cff_changed_rosters_new
+FOR EACH STATEMENT
+EXECUTE FUNCTION cff_bump_league_roster_versions();
+
+DROP TRIGGER IF EXISTS trg_cff_roster_versions_delete ON rosters;
+CREATE TRIGGER trg_cff_roster_versions_delete
+AFTER DELETE ON rosters
+REFERENCING OLD TABLE AS cff_changed_rosters_old
+FOR EACH STATEMENT
+EXECUTE FUNCTION cff_bump_league_roster_versions();
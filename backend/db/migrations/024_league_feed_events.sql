@@ -0,0 +1,222 @@
+-- League feeds read from one append-only event log instead of merging posts,
+-- transactions, waivers, trades and final matchups on every request. Rows are
+-- appended by triggers when the source row is written, so every code path that
+-- mutates those tables feeds the log. Weekly awards are appended once when a
+-- week is finalized (cff_append_weekly_awards). Reads page newest first by id.
+CREATE TABLE IF NOT EXISTS league_feed_events (
+  id BIGSERIAL PRIMARY KEY,
+  league_id TEXT NOT NULL REFERENCES leagues(id) ON DELETE CASCADE,
+  event_type TEXT NOT NULL,
+  summary TEXT NOT NULL,
+  manager_email TEXT NOT NULL DEFAULT '',
+  badge TEXT NOT NULL DEFAULT '',
+  source_key TEXT NOT NULL DEFAULT '',
+  created_at TIMESTAMPTZ NOT NULL DEFAULT NOW()
+);
+
+CREATE INDEX IF NOT EXISTS idx_league_feed_events_league_id
+  ON league_feed_events (league_id, id DESC);
+CREATE UNIQUE INDEX IF NOT EXISTS idx_league_feed_events_source_key
+  ON league_feed_events (league_id, source_key) WHERE source_key <> '';
+
+CREATE OR REPLACE FUNCTION cff_feed_status_label(status TEXT)
+RETURNS TEXT AS $$
+  SELECT CASE
+    WHEN status IN ('processed', 'accepted', 'approved', 'declined', 'vetoed',
+                    'expired', 'cancelled', 'active', 'removed', 'invited') THEN initcap(status)
+    ELSE 'Pending'
+  END;
+$$ LANGUAGE sql IMMUTABLE;
+
+CREATE OR REPLACE FUNCTION cff_feed_points(points NUMERIC)
+RETURNS TEXT AS $$
+  SELECT to_char(COALESCE(points, 0), 'FM9999999990.0');
+$$ LANGUAGE sql IMMUTABLE;
+
+CREATE OR REPLACE FUNCTION cff_append_league_feed_event()
+RETURNS TRIGGER AS $$
+DECLARE
+  status_label TEXT;
+  winner TEXT;
+  loser TEXT;
+BEGIN
+  IF TG_TABLE_NAME = 'league_feed_posts' THEN
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id,
+            CASE WHEN NEW.post_type = 'commissioner_post' THEN 'Commissioner Post' ELSE NEW.post_type END,
+            NEW.body, NEW.manager_email, 'Post', NEW.created_at);
+  ELSIF TG_TABLE_NAME = 'transactions' THEN
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id, NEW.transaction_type, NEW.summary, COALESCE(NEW.manager_email, ''),
+            'Transaction', NEW.created_at);
+  ELSIF TG_TABLE_NAME = 'waiver_claims' THEN
+    IF TG_OP = 'UPDATE' AND NEW.status IS NOT DISTINCT FROM OLD.status THEN
+      RETURN NULL;
+    END IF;
+    status_label := cff_feed_status_label(NEW.status);
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id, 'Waiver ' || status_label,
+            status_label || ': ' || COALESCE(NEW.add_player_snapshot->>'name', 'player')
+              || CASE WHEN COALESCE(NEW.drop_player_id, '') = '' THEN '' ELSE ' with a drop' END,
+            NEW.manager_email, 'Waiver', COALESCE(NEW.processed_at, NEW.created_at));
+  ELSIF TG_TABLE_NAME = 'trade_offers' THEN
+    IF TG_OP = 'UPDATE' AND NEW.status IS NOT DISTINCT FROM OLD.status THEN
+      RETURN NULL;
+    END IF;
+    status_label := cff_feed_status_label(NEW.status);
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id, 'Trade ' || status_label,
+            status_label || ': ' || COALESCE(NEW.offer_player_snapshot->>'name', 'player') || ' for '
+              || COALESCE(NEW.request_player_snapshot->>'name', NULLIF(NEW.request_player_name, ''), 'return'),
+            NEW.offered_by_email, 'Trade', COALESCE(NEW.resolved_at, NEW.created_at));
+  ELSIF TG_TABLE_NAME = 'league_matchups' THEN
+    IF NEW.status <> 'final' OR (TG_OP = 'UPDATE' AND OLD.status = 'final') THEN
+      RETURN NULL;
+    END IF;
+    IF NEW.home_score >= NEW.away_score THEN
+      winner := NEW.home_manager_email;
+      loser := COALESCE(NEW.away_manager_email, '');
+    ELSE
+      winner := COALESCE(NEW.away_manager_email, '');
+      loser := NEW.home_manager_email;
+    END IF;
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, source_key, created_at)
+    VALUES (NEW.league_id, 'Final Score',
+            winner || ' beat ' || loser || ' '
+              || cff_feed_points(GREATEST(NEW.home_score, NEW.away_score)) || '-'
+              || cff_feed_points(LEAST(NEW.home_score, NEW.away_score)) || '.',
+            winner, 'Final', 'final:' || NEW.id, COALESCE(NEW.finalized_at, NEW.updated_at))
+    ON CONFLICT (league_id, source_key) WHERE source_key <> '' DO NOTHING;
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+-- Highest score, lowest score and largest margin of one finalized week, as
+-- feed rows. Keyed by season and week, so appending the same week again adds
+-- nothing.
+CREATE OR REPLACE FUNCTION cff_weekly_award_rows(target_league TEXT, target_season INTEGER, target_week INTEGER)
+RETURNS TABLE (summary TEXT, manager_email TEXT, badge TEXT, source_key TEXT, created_at TIMESTAMPTZ, ordinal INTEGER) AS $$
+  WITH week_matchups AS (
+    SELECT home_manager_email AS home, COALESCE(away_manager_email, '') AS away,
+           home_score, away_score, COALESCE(finalized_at, updated_at) AS final_at
+    FROM league_matchups
+    WHERE league_id = target_league AND season = target_season AND week = target_week AND status = 'final'
+  ), sides AS (
+    SELECT home AS manager, home_score AS score FROM week_matchups
+    UNION ALL
+    SELECT away, away_score FROM week_matchups WHERE away <> ''
+  ), awarded_at AS (
+    SELECT MAX(final_at) AS at FROM week_matchups
+  ), awards AS (
+    (SELECT 'high' AS award, manager,
+            manager || ' posted the high score with ' || cff_feed_points(score) || ' points.' AS summary,
+            'Highest Score' AS badge, 1 AS ordinal
+     FROM sides ORDER BY score DESC, manager LIMIT 1)
+    UNION ALL
+    (SELECT 'low', manager,
+            manager || ' survived the lowest score at ' || cff_feed_points(score) || ' points.',
+            'Lowest Score', 2
+     FROM sides ORDER BY score ASC, manager LIMIT 1)
+    UNION ALL
+    (SELECT 'margin', CASE WHEN home_score >= away_score THEN home ELSE away END,
+            CASE WHEN home_score >= away_score THEN home ELSE away END || ' won by '
+              || cff_feed_points(abs(home_score - away_score)) || ' points over '
+              || CASE WHEN home_score >= away_score THEN away ELSE home END || '.',
+            'Largest Margin', 3
+     FROM week_matchups WHERE home_score <> away_score
+     ORDER BY abs(home_score - away_score) DESC, home LIMIT 1)
+  )
+  SELECT awards.summary, awards.manager, awards.badge,
+         'award:' || target_season || ':' || target_week || ':' || awards.award,
+         COALESCE(awarded_at.at, NOW()), awards.ordinal
+  FROM awards CROSS JOIN awarded_at
+  ORDER BY awards.ordinal;
+$$ LANGUAGE sql STABLE;
+
+-- Appends a week's awards once when it is finalized.
+CREATE OR REPLACE FUNCTION cff_append_weekly_awards(target_league TEXT, target_season INTEGER, target_week INTEGER)
+RETURNS VOID AS $$
+BEGIN
+  INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, source_key, created_at)
+  SELECT target_league, 'Weekly Award', awards.summary, awards.manager_email, awards.badge,
+         awards.source_key, awards.created_at
+  FROM cff_weekly_award_rows(target_league, target_season, target_week) AS awards
+  ORDER BY awards.ordinal
+  ON CONFLICT (league_id, source_key) WHERE source_key <> '' DO NOTHING;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_posts ON league_feed_posts;
+CREATE TRIGGER trg_cff_feed_events_posts
+AFTER INSERT ON league_feed_posts
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_transactions ON transactions;
+CREATE TRIGGER trg_cff_feed_events_transactions
+AFTER INSERT ON transactions
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_waivers ON waiver_claims;
+CREATE TRIGGER trg_cff_feed_events_waivers
+AFTER INSERT OR UPDATE OF status ON waiver_claims
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_trades ON trade_offers;
+CREATE TRIGGER trg_cff_feed_events_trades
+AFTER INSERT OR UPDATE OF status ON trade_offers
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_matchups ON league_matchups;
+CREATE TRIGGER trg_cff_feed_events_matchups
+AFTER INSERT OR UPDATE OF status ON league_matchups
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+-- Backfill existing history once, oldest first, so ids follow time. Weekly
+-- awards are merged into the same ordered insert, after the week's final
+-- scores. Waivers and trades contribute their current status only.
+INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, source_key, created_at)
+SELECT league_id, event_type, summary, manager_email, badge, source_key, created_at
+FROM (
+  SELECT league_id,
+         CASE WHEN post_type = 'commissioner_post' THEN 'Commissioner Post' ELSE post_type END AS event_type,
+         body AS summary, manager_email, 'Post' AS badge, '' AS source_key, created_at, 0 AS ordinal
+  FROM league_feed_posts
+  UNION ALL
+  SELECT league_id, transaction_type, summary, COALESCE(manager_email, ''), 'Transaction', '', created_at, 0
+  FROM transactions
+  UNION ALL
+  SELECT league_id, 'Waiver ' || cff_feed_status_label(status),
+         cff_feed_status_label(status) || ': ' || COALESCE(add_player_snapshot->>'name', 'player')
+           || CASE WHEN COALESCE(drop_player_id, '') = '' THEN '' ELSE ' with a drop' END,
+         manager_email, 'Waiver', '', COALESCE(processed_at, created_at), 0
+  FROM waiver_claims
+  UNION ALL
+  SELECT league_id, 'Trade ' || cff_feed_status_label(status),
+         cff_feed_status_label(status) || ': ' || COALESCE(offer_player_snapshot->>'name', 'player') || ' for '
+           || COALESCE(request_player_snapshot->>'name', NULLIF(request_player_name, ''), 'return'),
+         offered_by_email, 'Trade', '', COALESCE(resolved_at, created_at), 0
+  FROM trade_offers
+  UNION ALL
+  SELECT league_id, 'Final Score',
+         CASE WHEN home_score >= away_score THEN home_manager_email ELSE COALESCE(away_manager_email, '') END
+           || ' beat '
+           || CASE WHEN home_score >= away_score THEN COALESCE(away_manager_email, '') ELSE home_manager_email END
+           || ' ' || cff_feed_points(GREATEST(home_score, away_score)) || '-'
+           || cff_feed_points(LEAST(home_score, away_score)) || '.',
+         CASE WHEN home_score >= away_score THEN home_manager_email ELSE COALESCE(away_manager_email, '') END,
+         'Final', 'final:' || id, COALESCE(finalized_at, updated_at), 0
+  FROM league_matchups
+  WHERE status = 'final'
+  UNION ALL
+  SELECT finals.league_id, 'Weekly Award', awards.summary, awards.manager_email, awards.badge,
+         awards.source_key, awards.created_at, awards.ordinal
+  FROM (
+    SELECT DISTINCT league_id, season, week
+    FROM league_matchups
+    WHERE status = 'final'
+  ) AS finals
+  CROSS JOIN LATERAL cff_weekly_award_rows(finals.league_id, finals.season, finals.week) AS awards
+) AS history
+WHERE NOT EXISTS (SELECT 1 FROM league_feed_events)
+ORDER BY created_at, ordinal, event_type;
@@ -415,6 +415,7 @@ CREATE TABLE IF NOT EXISTS fantasy_player_scores (
 );
 
 CREATE INDEX IF NOT EXISTS idx_rosters_league ON rosters(league_id);
+CREATE INDEX IF NOT EXISTS idx_rosters_player ON rosters(player_id, league_id);
 CREATE INDEX IF NOT EXISTS idx_draft_picks_league_pick ON draft_picks(league_id, pick_number);
 CREATE INDEX IF NOT EXISTS idx_waivers_league_status ON waiver_claims(league_id, status);
 CREATE INDEX IF NOT EXISTS idx_waiver_priorities_league ON waiver_priorities(league_id, priority);
@@ -423,3 +424,202 @@ CREATE INDEX IF NOT EXISTS idx_transactions_league_created ON transactions(leagu
 CREATE INDEX IF NOT EXISTS idx_league_feed_posts_league_created ON league_feed_posts(league_id, created_at DESC);
 CREATE INDEX IF NOT EXISTS idx_matchups_league_week ON league_matchups(league_id, week);
 CREATE INDEX IF NOT EXISTS idx_fantasy_scores_league_week ON fantasy_player_scores(league_id, season, week);
+
+-- Bumped on every rosters insert/delete; keys the in-memory free-agent pools.
+CREATE TABLE IF NOT EXISTS league_roster_versions (
+  league_id TEXT PRIMARY KEY,
+  version BIGINT NOT NULL DEFAULT 0,
+  updated_at TIMESTAMPTZ NOT NULL DEFAULT NOW()
+);
+
+CREATE OR REPLACE FUNCTION cff_bump_league_roster_versions()
+RETURNS TRIGGER AS $$
+BEGIN
+  IF TG_OP = 'INSERT' THEN
+    INSERT INTO league_roster_versions (league_id, version)
+    SELECT DISTINCT league_id, 1 FROM cff_changed_rosters_new ORDER BY league_id
+    ON CONFLICT (league_id) DO UPDATE
+      SET version = league_roster_versions.version + 1, updated_at = NOW();
+  ELSE
+    INSERT INTO league_roster_versions (league_id, version)
+    SELECT DISTINCT league_id, 1 FROM cff_changed_rosters_old ORDER BY league_id
+    ON CONFLICT (league_id) DO UPDATE
+      SET version = league_roster_versions.version + 1, updated_at = NOW();
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS trg_cff_roster_versions_insert ON rosters;
+CREATE TRIGGER trg_cff_roster_versions_insert
+AFTER INSERT ON rosters
+REFERENCING NEW TABLE AS cff_changed_rosters_new
+FOR EACH STATEMENT
+EXECUTE FUNCTION cff_bump_league_roster_versions();
+
+DROP TRIGGER IF EXISTS trg_cff_roster_versions_delete ON rosters;
+CREATE TRIGGER trg_cff_roster_versions_delete
+AFTER DELETE ON rosters
+REFERENCING OLD TABLE AS cff_changed_rosters_old
+FOR EACH STATEMENT
+EXECUTE FUNCTION cff_bump_league_roster_versions();
+
+-- Append-only league feed, written by triggers and at week finalization.
+CREATE TABLE IF NOT EXISTS league_feed_events (
+  id BIGSERIAL PRIMARY KEY,
+  league_id TEXT NOT NULL REFERENCES leagues(id) ON DELETE CASCADE,
+  event_type TEXT NOT NULL,
+  summary TEXT NOT NULL,
+  manager_email TEXT NOT NULL DEFAULT '',
+  badge TEXT NOT NULL DEFAULT '',
+  source_key TEXT NOT NULL DEFAULT '',
+  created_at TIMESTAMPTZ NOT NULL DEFAULT NOW()
+);
+
+CREATE INDEX IF NOT EXISTS idx_league_feed_events_league_id
+  ON league_feed_events (league_id, id DESC);
+CREATE UNIQUE INDEX IF NOT EXISTS idx_league_feed_events_source_key
+  ON league_feed_events (league_id, source_key) WHERE source_key <> '';
+
+CREATE OR REPLACE FUNCTION cff_feed_status_label(status TEXT)
+RETURNS TEXT AS $$
+  SELECT CASE
+    WHEN status IN ('processed', 'accepted', 'approved', 'declined', 'vetoed',
+                    'expired', 'cancelled', 'active', 'removed', 'invited') THEN initcap(status)
+    ELSE 'Pending'
+  END;
+$$ LANGUAGE sql IMMUTABLE;
+
+CREATE OR REPLACE FUNCTION cff_feed_points(points NUMERIC)
+RETURNS TEXT AS $$
+  SELECT to_char(COALESCE(points, 0), 'FM9999999990.0');
+$$ LANGUAGE sql IMMUTABLE;
+
+CREATE OR REPLACE FUNCTION cff_append_league_feed_event()
+RETURNS TRIGGER AS $$
+DECLARE
+  status_label TEXT;
+  winner TEXT;
+  loser TEXT;
+BEGIN
+  IF TG_TABLE_NAME = 'league_feed_posts' THEN
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id,
+            CASE WHEN NEW.post_type = 'commissioner_post' THEN 'Commissioner Post' ELSE NEW.post_type END,
+            NEW.body, NEW.manager_email, 'Post', NEW.created_at);
+  ELSIF TG_TABLE_NAME = 'transactions' THEN
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id, NEW.transaction_type, NEW.summary, COALESCE(NEW.manager_email, ''),
+            'Transaction', NEW.created_at);
+  ELSIF TG_TABLE_NAME = 'waiver_claims' THEN
+    IF TG_OP = 'UPDATE' AND NEW.status IS NOT DISTINCT FROM OLD.status THEN
+      RETURN NULL;
+    END IF;
+    status_label := cff_feed_status_label(NEW.status);
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id, 'Waiver ' || status_label,
+            status_label || ': ' || COALESCE(NEW.add_player_snapshot->>'name', 'player')
+              || CASE WHEN COALESCE(NEW.drop_player_id, '') = '' THEN '' ELSE ' with a drop' END,
+            NEW.manager_email, 'Waiver', COALESCE(NEW.processed_at, NEW.created_at));
+  ELSIF TG_TABLE_NAME = 'trade_offers' THEN
+    IF TG_OP = 'UPDATE' AND NEW.status IS NOT DISTINCT FROM OLD.status THEN
+      RETURN NULL;
+    END IF;
+    status_label := cff_feed_status_label(NEW.status);
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, created_at)
+    VALUES (NEW.league_id, 'Trade ' || status_label,
+            status_label || ': ' || COALESCE(NEW.offer_player_snapshot->>'name', 'player') || ' for '
+              || COALESCE(NEW.request_player_snapshot->>'name', NULLIF(NEW.request_player_name, ''), 'return'),
+            NEW.offered_by_email, 'Trade', COALESCE(NEW.resolved_at, NEW.created_at));
+  ELSIF TG_TABLE_NAME = 'league_matchups' THEN
+    IF NEW.status <> 'final' OR (TG_OP = 'UPDATE' AND OLD.status = 'final') THEN
+      RETURN NULL;
+    END IF;
+    IF NEW.home_score >= NEW.away_score THEN
+      winner := NEW.home_manager_email;
+      loser := COALESCE(NEW.away_manager_email, '');
+    ELSE
+      winner := COALESCE(NEW.away_manager_email, '');
+      loser := NEW.home_manager_email;
+    END IF;
+    INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, source_key, created_at)
+    VALUES (NEW.league_id, 'Final Score',
+            winner || ' beat ' || loser || ' '
+              || cff_feed_points(GREATEST(NEW.home_score, NEW.away_score)) || '-'
+              || cff_feed_points(LEAST(NEW.home_score, NEW.away_score)) || '.',
+            winner, 'Final', 'final:' || NEW.id, COALESCE(NEW.finalized_at, NEW.updated_at))
+    ON CONFLICT (league_id, source_key) WHERE source_key <> '' DO NOTHING;
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+-- Highest score, lowest score and largest margin of one finalized week. Keyed
+-- by season and week, so finalizing the same week again appends nothing.
+CREATE OR REPLACE FUNCTION cff_append_weekly_awards(target_league TEXT, target_season INTEGER, target_week INTEGER)
+RETURNS VOID AS $$
+BEGIN
+  WITH week_matchups AS (
+    SELECT home_manager_email AS home, COALESCE(away_manager_email, '') AS away,
+           home_score, away_score, COALESCE(finalized_at, updated_at) AS final_at
+    FROM league_matchups
+    WHERE league_id = target_league AND season = target_season AND week = target_week AND status = 'final'
+  ), sides AS (
+    SELECT home AS manager, home_score AS score FROM week_matchups
+    UNION ALL
+    SELECT away, away_score FROM week_matchups WHERE away <> ''
+  ), awarded_at AS (
+    SELECT MAX(final_at) AS at FROM week_matchups
+  ), awards AS (
+    (SELECT 'high' AS award, manager,
+            manager || ' posted the high score with ' || cff_feed_points(score) || ' points.' AS summary,
+            'Highest Score' AS badge, 1 AS ordinal
+     FROM sides ORDER BY score DESC, manager LIMIT 1)
+    UNION ALL
+    (SELECT 'low', manager,
+            manager || ' survived the lowest score at ' || cff_feed_points(score) || ' points.',
+            'Lowest Score', 2
+     FROM sides ORDER BY score ASC, manager LIMIT 1)
+    UNION ALL
+    (SELECT 'margin', CASE WHEN home_score >= away_score THEN home ELSE away END,
+            CASE WHEN home_score >= away_score THEN home ELSE away END || ' won by '
+              || cff_feed_points(abs(home_score - away_score)) || ' points over '
+              || CASE WHEN home_score >= away_score THEN away ELSE home END || '.',
+            'Largest Margin', 3
+     FROM week_matchups WHERE home_score <> away_score
+     ORDER BY abs(home_score - away_score) DESC, home LIMIT 1)
+  )
+  INSERT INTO league_feed_events (league_id, event_type, summary, manager_email, badge, source_key, created_at)
+  SELECT target_league, 'Weekly Award', awards.summary, awards.manager, awards.badge,
+         'award:' || target_season || ':' || target_week || ':' || awards.award,
+         COALESCE(awarded_at.at, NOW())
+  FROM awards CROSS JOIN awarded_at
+  ORDER BY awards.ordinal
+  ON CONFLICT (league_id, source_key) WHERE source_key <> '' DO NOTHING;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_posts ON league_feed_posts;
+CREATE TRIGGER trg_cff_feed_events_posts
+AFTER INSERT ON league_feed_posts
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_transactions ON transactions;
+CREATE TRIGGER trg_cff_feed_events_transactions
+AFTER INSERT ON transactions
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_waivers ON waiver_claims;
+CREATE TRIGGER trg_cff_feed_events_waivers
+AFTER INSERT OR UPDATE OF status ON waiver_claims
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_trades ON trade_offers;
+CREATE TRIGGER trg_cff_feed_events_trades
+AFTER INSERT OR UPDATE OF status ON trade_offers
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
+
+DROP TRIGGER IF EXISTS trg_cff_feed_events_matchups ON league_matchups;
+CREATE TRIGGER trg_cff_feed_events_matchups
+AFTER INSERT OR UPDATE OF status ON league_matchups
+FOR EACH ROW EXECUTE FUNCTION cff_append_league_feed_event();
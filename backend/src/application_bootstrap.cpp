@@ -9,7 +9,9 @@
 #include "app_config.h"
 #include "cfbd_ingest.h"
 #include "ingest_runtime.h"
+#include "live_scores.h"
 #include "live_stat_worker.h"
+#include "player_catalog.h"
 #include "server_runtime.h"
 #endif
 
@@ -35,7 +37,11 @@ int runApplication() {
         runtimeConfig.ingestIntervalHours,
         cff::runCfbdIngestOnce
     );
+    // Before the worker, so its first ingest is never overwritten by the
+    // empty placeholder snapshot.
+    cff::startLiveScoreSnapshotLoader();
     cff::live_stats::configureLiveStatWorker();
+    cff::startPlayerSearchIndexLoader();
 
     cff::server_runtime::configureListener(
         app,
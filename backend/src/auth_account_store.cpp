@@ -11,6 +11,8 @@
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 namespace cff::auth {
@@ -20,14 +22,6 @@ std::mutex accountMutex;
 std::unordered_map<std::string, std::string> inMemoryPasswordHashes;
 
 #ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *conn) const {
-        if (conn) {
-            PQfinish(conn);
-        }
-    }
-};
-
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
         if (result) {
@@ -36,20 +30,11 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 
 PgConnPtr connectToDatabase() {
-    const auto url = cff::config::readEnv("DB_URL");
-    if (!url || url->empty()) {
-        return nullptr;
-    }
-    auto conn = PgConnPtr{PQconnectdb(url->c_str())};
-    if (PQstatus(conn.get()) != CONNECTION_OK) {
-        std::cerr << "[auth] Failed to connect to Postgres: " << PQerrorMessage(conn.get()) << std::endl;
-        return nullptr;
-    }
-    return conn;
+    return cff::db::acquireConnection();
 }
 
 PgResultPtr executeParameters(PGconn *conn,
@@ -15,6 +15,8 @@
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 namespace cff::auth {
@@ -58,15 +60,7 @@ bool sendPasswordResetEmail(const std::string &email, const std::string &token)
 
 
 #ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *conn) const {
-        if (conn) {
-            PQfinish(conn);
-        }
-    }
-};
-
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 
 bool databaseConfigured() {
     const auto url = readEnv("DB_URL");
@@ -74,17 +68,7 @@ bool databaseConfigured() {
 }
 
 PgConnPtr connectToDatabase() {
-    const auto url = readEnv("DB_URL");
-    if (!url || url->empty()) {
-        return nullptr;
-    }
-    auto conn = PgConnPtr{PQconnectdb(url->c_str())};
-    if (PQstatus(conn.get()) != CONNECTION_OK) {
-        std::cerr << "[auth] Failed to connect to Postgres: "
-                  << PQerrorMessage(conn.get()) << std::endl;
-        return nullptr;
-    }
-    return conn;
+    return cff::db::acquireConnection();
 }
 #endif
 
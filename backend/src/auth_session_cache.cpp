@@ -0,0 +1,146 @@
+#include "auth_session_cache.h"
+
+#include <drogon/utils/Utilities.h>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <utility>
+
+namespace cff::auth {
+
+std::string tokenDigest(const std::string &token) {
+    auto digest = drogon::utils::getSha256(token.data(), token.size());
+    std::transform(digest.begin(), digest.end(), digest.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return digest;
+}
+
+SessionTokenCache::SessionTokenCache(SessionCacheSettings settings)
+    : settings_(settings),
+      shardCapacity_(std::max<std::size_t>(1, (settings.capacity + kShards - 1) / kShards)) {}
+
+SessionTokenCache::Shard &SessionTokenCache::shardFor(const std::string &digest) {
+    return shards_[std::hash<std::string>{}(digest) % kShards];
+}
+
+SessionTokenCache::Lookup SessionTokenCache::find(const std::string &token, Clock::time_point now) {
+    const auto digest = tokenDigest(token);
+    auto &shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (const auto revoked = shard.revoked.find(digest); revoked != shard.revoked.end()) {
+        if (revoked->second > now) {
+            ++shard.negativeHits;
+            return Lookup{State::Invalid, {}};
+        }
+        shard.revoked.erase(revoked);
+    }
+
+    const auto it = shard.entries.find(digest);
+    if (it == shard.entries.end()) {
+        ++shard.misses;
+        return Lookup{};
+    }
+    if (it->second.expiresAt <= now) {
+        shard.recency.erase(it->second.recency);
+        shard.entries.erase(it);
+        ++shard.misses;
+        return Lookup{};
+    }
+    shard.recency.splice(shard.recency.begin(), shard.recency, it->second.recency);
+    if (!it->second.valid) {
+        ++shard.negativeHits;
+        return Lookup{State::Invalid, {}};
+    }
+    ++shard.hits;
+    return Lookup{State::Valid, it->second.email};
+}
+
+void SessionTokenCache::insertLocked(Shard &shard, const std::string &digest, Entry entry) {
+    if (const auto existing = shard.entries.find(digest); existing != shard.entries.end()) {
+        shard.recency.erase(existing->second.recency);
+        shard.entries.erase(existing);
+    }
+    while (shard.entries.size() >= shardCapacity_ && !shard.recency.empty()) {
+        shard.entries.erase(shard.recency.back());
+        shard.recency.pop_back();
+        ++shard.evictions;
+    }
+    shard.recency.push_front(digest);
+    entry.recency = shard.recency.begin();
+    shard.entries.emplace(digest, std::move(entry));
+}
+
+bool SessionTokenCache::storeValid(const std::string &token,
+                                   const std::string &email,
+                                   Clock::time_point expiresAt,
+                                   Clock::time_point now) {
+    const auto digest = tokenDigest(token);
+    auto &shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (const auto revoked = shard.revoked.find(digest);
+        revoked != shard.revoked.end() && revoked->second > now) {
+        return false;
+    }
+    const auto cachedUntil = std::min(expiresAt, now + settings_.ttl);
+    if (cachedUntil <= now) return true;
+    insertLocked(shard, digest, Entry{email, true, cachedUntil, {}});
+    return true;
+}
+
+void SessionTokenCache::storeInvalid(const std::string &token, Clock::time_point now) {
+    if (settings_.negativeTtl.count() <= 0) return;
+    const auto digest = tokenDigest(token);
+    auto &shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    insertLocked(shard, digest, Entry{{}, false, now + settings_.negativeTtl, {}});
+}
+
+void SessionTokenCache::revoke(const std::string &token, Clock::time_point until) {
+    const auto digest = tokenDigest(token);
+    auto &shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (const auto existing = shard.entries.find(digest); existing != shard.entries.end()) {
+        shard.recency.erase(existing->second.recency);
+        shard.entries.erase(existing);
+    }
+    auto &deniedUntil = shard.revoked[digest];
+    deniedUntil = std::max(deniedUntil, until);
+}
+
+void SessionTokenCache::sweep(Clock::time_point now) {
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            if (it->second.expiresAt <= now) {
+                shard.recency.erase(it->second.recency);
+                it = shard.entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (auto it = shard.revoked.begin(); it != shard.revoked.end();) {
+            if (it->second <= now) {
+                it = shard.revoked.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+SessionCacheMetrics SessionTokenCache::metrics() const {
+    SessionCacheMetrics metrics;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        metrics.entries += shard.entries.size();
+        metrics.revoked += shard.revoked.size();
+        metrics.hits += shard.hits;
+        metrics.negativeHits += shard.negativeHits;
+        metrics.misses += shard.misses;
+        metrics.evictions += shard.evictions;
+    }
+    return metrics;
+}
+
+} // namespace cff::auth
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cff::auth {
+
+struct SessionCacheSettings {
+    std::size_t capacity{10000};
+    std::chrono::seconds ttl{60};
+    std::chrono::seconds negativeTtl{5};
+};
+
+struct SessionCacheMetrics {
+    std::size_t entries{0};
+    std::size_t revoked{0};
+    std::uint64_t hits{0};
+    std::uint64_t negativeHits{0};
+    std::uint64_t misses{0};
+    std::uint64_t evictions{0};
+};
+
+// Lowercase hex SHA-256 of a session token: the same key auth_tokens stores
+// (encode(digest(token, 'sha256'), 'hex')).
+std::string tokenDigest(const std::string &token);
+
+// Lock-striped LRU of session token digest -> account, placed in front of the
+// auth_tokens table. Every call hashes the bearer token first, so live
+// credentials are never kept in process memory. Positive entries live for at
+// most `ttl` (and never past the token's own expiry), so a logout on another
+// instance is honoured within that bound. Unknown tokens are cached as
+// negative entries for `negativeTtl` to absorb retries with a stale token.
+// Revocations made in this process are kept outside the LRU until the token
+// would have expired, so eviction can never resurrect a revoked session.
+class SessionTokenCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State { Miss, Valid, Invalid };
+
+    struct Lookup {
+        State state{State::Miss};
+        std::string email;
+    };
+
+    explicit SessionTokenCache(SessionCacheSettings settings);
+
+    Lookup find(const std::string &token, Clock::time_point now);
+
+    // Returns false when the token was revoked meanwhile; a lookup racing a
+    // logout must not re-admit the session.
+    bool storeValid(const std::string &token,
+                    const std::string &email,
+                    Clock::time_point expiresAt,
+                    Clock::time_point now);
+    void storeInvalid(const std::string &token, Clock::time_point now);
+    void revoke(const std::string &token, Clock::time_point until);
+    void sweep(Clock::time_point now);
+
+    SessionCacheSettings settings() const { return settings_; }
+    SessionCacheMetrics metrics() const;
+
+private:
+    static constexpr std::size_t kShards = 16;
+
+    struct Entry {
+        std::string email;
+        bool valid{false};
+        Clock::time_point expiresAt{};
+        std::list<std::string>::iterator recency;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<std::string> recency;
+        std::unordered_map<std::string, Entry> entries;
+        std::unordered_map<std::string, Clock::time_point> revoked;
+        std::uint64_t hits{0};
+        std::uint64_t negativeHits{0};
+        std::uint64_t misses{0};
+        std::uint64_t evictions{0};
+    };
+
+    Shard &shardFor(const std::string &digest);
+    void insertLocked(Shard &shard, const std::string &digest, Entry entry);
+
+    SessionCacheSettings settings_;
+    std::size_t shardCapacity_{1};
+    std::array<Shard, kShards> shards_;
+};
+
+} // namespace cff::auth
@@ -4,31 +4,53 @@
 #include "auth_core.h"
 
 #include <chrono>
+#include <exception>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 namespace cff::auth {
 namespace {
 
+using Clock = std::chrono::steady_clock;
+
 struct TokenRecord {
     std::string email;
-    std::chrono::steady_clock::time_point expiresAt;
+    Clock::time_point expiresAt;
 };
 
 std::mutex sessionMutex;
 std::unordered_map<std::string, TokenRecord> activeTokens;
-std::unordered_map<std::string, std::chrono::steady_clock::time_point> revokedTokens;
 constexpr std::chrono::hours kTokenTtl{24};
 
-void cleanupExpiredMemoryTokensLocked(std::chrono::steady_clock::time_point now) {
+SessionCacheSettings loadSessionCacheSettings() {
+    SessionCacheSettings settings;
+    settings.capacity = cff::config::readSizeEnv("CFF_SESSION_CACHE_CAPACITY", 10000, 1000000);
+    settings.ttl = std::chrono::seconds{
+        cff::config::readSizeEnv("CFF_SESSION_CACHE_TTL_SECONDS", 60, 3600)};
+    settings.negativeTtl = std::chrono::seconds{
+        cff::config::readSizeEnv("CFF_SESSION_CACHE_NEGATIVE_TTL_SECONDS", 5, 300)};
+    return settings;
+}
+
+SessionTokenCache &sessionCache() {
+    static SessionTokenCache cache{loadSessionCacheSettings()};
+    return cache;
+}
+
+void cleanupExpiredMemoryTokens(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(sessionMutex);
     for (auto it = activeTokens.begin(); it != activeTokens.end();) {
         if (it->second.expiresAt <= now) {
             it = activeTokens.erase(it);
@@ -36,31 +58,9 @@ void cleanupExpiredMemoryTokensLocked(std::chrono::steady_clock::time_point now)
             ++it;
         }
     }
-    for (auto it = revokedTokens.begin(); it != revokedTokens.end();) {
-        if (it->second <= now) {
-            it = revokedTokens.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
-bool tokenRevokedInMemory(const std::string &token) {
-    std::lock_guard<std::mutex> lock(sessionMutex);
-    const auto now = std::chrono::steady_clock::now();
-    cleanupExpiredMemoryTokensLocked(now);
-    return revokedTokens.find(token) != revokedTokens.end();
 }
 
 #ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *conn) const {
-        if (conn) {
-            PQfinish(conn);
-        }
-    }
-};
-
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
         if (result) {
@@ -69,7 +69,7 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 
 bool databaseConfigured() {
@@ -78,16 +78,7 @@ bool databaseConfigured() {
 }
 
 PgConnPtr connectToDatabase() {
-    const auto url = cff::config::readEnv("DB_URL");
-    if (!url || url->empty()) {
-        return nullptr;
-    }
-    auto conn = PgConnPtr{PQconnectdb(url->c_str())};
-    if (PQstatus(conn.get()) != CONNECTION_OK) {
-        std::cerr << "[auth] Failed to connect to Postgres: " << PQerrorMessage(conn.get()) << std::endl;
-        return nullptr;
-    }
-    return conn;
+    return cff::db::acquireConnection();
 }
 
 PgResultPtr executeParameters(PGconn *conn,
@@ -112,10 +103,14 @@ bool resultOk(PGresult *result, ExecStatusType expected) {
     return result && PQresultStatus(result) == expected;
 }
 
-void cleanupExpiredDatabaseTokens(PGconn *conn) {
-    auto cleanupAuth = executeParameters(conn, "DELETE FROM auth_tokens WHERE expires_at <= NOW()", {});
+void cleanupExpiredDatabaseTokens() {
+    auto conn = connectToDatabase();
+    if (!conn) {
+        return;
+    }
+    auto cleanupAuth = executeParameters(conn.get(), "DELETE FROM auth_tokens WHERE expires_at <= NOW()", {});
     (void)cleanupAuth;
-    auto cleanupUsers = executeParameters(conn,
+    auto cleanupUsers = executeParameters(conn.get(),
                                           "UPDATE users SET "
                                           "email_verification_token = CASE WHEN email_verification_expires_at <= NOW() THEN NULL ELSE email_verification_token END, "
                                           "email_verification_expires_at = CASE WHEN email_verification_expires_at <= NOW() THEN NULL ELSE email_verification_expires_at END, "
@@ -131,7 +126,6 @@ bool persistDatabaseToken(const std::string &token, const std::string &email) {
     if (!conn) {
         return false;
     }
-    cleanupExpiredDatabaseTokens(conn.get());
     auto result = executeParameters(conn.get(),
                                     "INSERT INTO auth_tokens (token, email, expires_at) "
                                     "VALUES (encode(digest($1, 'sha256'), 'hex'), $2, NOW() + INTERVAL '24 hours') "
@@ -144,19 +138,31 @@ bool persistDatabaseToken(const std::string &token, const std::string &email) {
     return true;
 }
 
-std::optional<std::string> databaseEmailForToken(const std::string &token) {
+struct DatabaseSession {
+    bool queried{false};
+    std::optional<std::string> email;
+    std::chrono::seconds remaining{0};
+};
+
+DatabaseSession databaseSessionForToken(const std::string &token) {
     auto conn = connectToDatabase();
     if (!conn) {
-        return std::nullopt;
+        return {};
     }
-    cleanupExpiredDatabaseTokens(conn.get());
     auto result = executeParameters(conn.get(),
-                                    "SELECT email FROM auth_tokens WHERE token = encode(digest($1, 'sha256'), 'hex') AND expires_at > NOW()",
+                                    "SELECT email, GREATEST(0, FLOOR(EXTRACT(EPOCH FROM expires_at - NOW())))::bigint "
+                                    "FROM auth_tokens WHERE token = encode(digest($1, 'sha256'), 'hex') AND expires_at > NOW()",
                                     {token});
-    if (!resultOk(result.get(), PGRES_TUPLES_OK) || PQntuples(result.get()) == 0) {
-        return std::nullopt;
+    if (!resultOk(result.get(), PGRES_TUPLES_OK)) {
+        return {};
+    }
+    DatabaseSession session;
+    session.queried = true;
+    if (PQntuples(result.get()) > 0) {
+        session.email = std::string{PQgetvalue(result.get(), 0, 0)};
+        session.remaining = std::chrono::seconds{std::stoll(PQgetvalue(result.get(), 0, 1))};
     }
-    return std::string{PQgetvalue(result.get(), 0, 0)};
+    return session;
 }
 
 bool revokeDatabaseToken(const std::string &token) {
@@ -175,16 +181,51 @@ bool revokeDatabaseToken(const std::string &token) {
 }
 #endif
 
+// Expired rows used to be purged inline on every token lookup and issue.
+// That work now runs here on an interval so validation stays a read.
+void sweepExpiredSessions() {
+    const auto now = Clock::now();
+    cleanupExpiredMemoryTokens(now);
+    sessionCache().sweep(now);
+#ifdef CFF_HAS_POSTGRES
+    if (databaseConfigured()) {
+        cleanupExpiredDatabaseTokens();
+    }
+#endif
+}
+
+void startSessionSweeper() {
+    static std::once_flag started;
+    std::call_once(started, [] {
+        const std::chrono::seconds interval{
+            cff::config::readSizeEnv("CFF_SESSION_SWEEP_INTERVAL_SECONDS", 300, 86400)};
+        std::thread([interval] {
+            for (;;) {
+                std::this_thread::sleep_for(interval);
+                try {
+                    sweepExpiredSessions();
+                } catch (const std::exception &error) {
+                    std::cerr << "[auth] session sweep failed: " << error.what() << std::endl;
+                }
+            }
+        }).detach();
+    });
+}
+
 } // namespace
 
 std::optional<std::string> issueSessionToken(const std::string &email) {
+    startSessionSweeper();
     const auto token = randomToken();
-    const auto expiresAt = std::chrono::steady_clock::now() + kTokenTtl;
+    const auto now = Clock::now();
+    const auto expiresAt = now + kTokenTtl;
 #ifdef CFF_HAS_POSTGRES
     if (databaseConfigured()) {
         if (!persistDatabaseToken(token, email)) {
             return std::nullopt;
         }
+        sessionCache().storeValid(token, email, expiresAt, now);
+        return token;
     } else if (cff::config::persistentDbRequired()) {
         return std::nullopt;
     }
@@ -195,14 +236,15 @@ std::optional<std::string> issueSessionToken(const std::string &email) {
 #endif
 
     std::lock_guard<std::mutex> lock(sessionMutex);
-    cleanupExpiredMemoryTokensLocked(std::chrono::steady_clock::now());
-    revokedTokens.erase(token);
     activeTokens[token] = TokenRecord{email, expiresAt};
     return token;
 }
 
 std::optional<std::string> emailForSessionToken(const std::string &token) {
-    if (tokenRevokedInMemory(token)) {
+    startSessionSweeper();
+    const auto now = Clock::now();
+    const auto cached = sessionCache().find(token, now);
+    if (cached.state == SessionTokenCache::State::Invalid) {
         return std::nullopt;
     }
 #ifdef CFF_HAS_POSTGRES
@@ -210,7 +252,21 @@ std::optional<std::string> emailForSessionToken(const std::string &token) {
         return std::nullopt;
     }
     if (databaseConfigured()) {
-        return databaseEmailForToken(token);
+        if (cached.state == SessionTokenCache::State::Valid) {
+            return cached.email;
+        }
+        const auto session = databaseSessionForToken(token);
+        if (!session.queried) {
+            return std::nullopt;
+        }
+        if (!session.email) {
+            sessionCache().storeInvalid(token, now);
+            return std::nullopt;
+        }
+        if (!sessionCache().storeValid(token, *session.email, now + session.remaining, now)) {
+            return std::nullopt;
+        }
+        return session.email;
     }
 #else
     if (cff::config::persistentDbRequired()) {
@@ -219,8 +275,6 @@ std::optional<std::string> emailForSessionToken(const std::string &token) {
 #endif
 
     std::lock_guard<std::mutex> lock(sessionMutex);
-    const auto now = std::chrono::steady_clock::now();
-    cleanupExpiredMemoryTokensLocked(now);
     auto it = activeTokens.find(token);
     if (it == activeTokens.end()) {
         return std::nullopt;
@@ -233,12 +287,11 @@ std::optional<std::string> emailForSessionToken(const std::string &token) {
 }
 
 void revokeSessionToken(const std::string &token) {
+    const auto now = Clock::now();
+    sessionCache().revoke(token, now + kTokenTtl);
     {
         std::lock_guard<std::mutex> lock(sessionMutex);
-        const auto now = std::chrono::steady_clock::now();
-        cleanupExpiredMemoryTokensLocked(now);
         activeTokens.erase(token);
-        revokedTokens[token] = now + kTokenTtl;
     }
 #ifdef CFF_HAS_POSTGRES
     if (databaseConfigured() && !revokeDatabaseToken(token)) {
@@ -248,4 +301,8 @@ void revokeSessionToken(const std::string &token) {
 #endif
 }
 
+SessionCacheMetrics sessionCacheMetrics() {
+    return sessionCache().metrics();
+}
+
 } // namespace cff::auth
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "auth_session_cache.h"
+
 #include <optional>
 #include <string>
 
@@ -8,5 +10,6 @@ namespace cff::auth {
 std::optional<std::string> issueSessionToken(const std::string &email);
 std::optional<std::string> emailForSessionToken(const std::string &token);
 void revokeSessionToken(const std::string &token);
+SessionCacheMetrics sessionCacheMetrics();
 
 } // namespace cff::auth
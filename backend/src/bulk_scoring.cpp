@@ -0,0 +1,166 @@
+#include "bulk_scoring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <tuple>
+#include <utility>
+
+namespace cff::bulk_scoring {
+namespace {
+
+std::string profileKey(const Json::Value &settings) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, settings);
+}
+
+} // namespace
+
+void WeekStatTable::add(const std::string &playerId,
+                        const std::string &category,
+                        const std::string &statName,
+                        double value) {
+    auto found = index_.find(playerId);
+    if (found == index_.end()) {
+        found = index_.emplace(playerId, stats_.size()).first;
+        stats_.emplace_back(Json::objectValue);
+    }
+    const auto player = found->second;
+    if (category.empty() || statName.empty()) return;
+    stats_[player][category + "." + statName] = value;
+    rowPlayer_.push_back(static_cast<std::uint32_t>(player));
+    rowStat_.push_back(cff::scoring_lifecycle::internStat(category, statName));
+    rowValue_.push_back(value);
+}
+
+std::optional<std::size_t> WeekStatTable::index(const std::string &playerId) const {
+    const auto found = index_.find(playerId);
+    if (found == index_.end()) return std::nullopt;
+    return found->second;
+}
+
+std::vector<double> WeekStatTable::points(const cff::scoring_lifecycle::CompiledScoring &scoring) const {
+    std::vector<double> totals(stats_.size(), 0.0);
+    for (std::size_t row = 0; row < rowValue_.size(); ++row) {
+        auto &total = totals[rowPlayer_[row]];
+        total = scoring.accumulate(total, rowStat_[row], rowValue_[row]);
+    }
+    return totals;
+}
+
+std::shared_ptr<const std::vector<double>> ProfilePoints::pointsFor(const Json::Value &settings) {
+    const auto key = profileKey(settings);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto found = byProfile_.find(key);
+        if (found != byProfile_.end()) return found->second;
+    }
+    auto computed = std::make_shared<const std::vector<double>>(
+        table_.points(cff::scoring_lifecycle::CompiledScoring{settings}));
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byProfile_.emplace(key, std::move(computed)).first->second;
+}
+
+std::size_t ProfilePoints::profiles() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byProfile_.size();
+}
+
+LeagueScores scoreLineup(const Json::Value &lineup,
+                         const WeekStatTable &table,
+                         const std::vector<double> &points) {
+    std::vector<const Json::Value *> entries;
+    if (lineup.isArray()) {
+        for (const auto &entry : lineup) {
+            const auto slot = cff::scoring_lifecycle::canonicalStatToken(entry.get("rosterSlot", "bench").asString());
+            if (slot != "bench") entries.push_back(&entry);
+        }
+    }
+    const auto sortKey = [](const Json::Value *entry) {
+        return std::make_tuple(cff::scoring_lifecycle::canonicalEmail(entry->get("managerEmail", "").asString()),
+                               entry->get("playerId", "").asString());
+    };
+    std::stable_sort(entries.begin(), entries.end(), [&sortKey](const Json::Value *left, const Json::Value *right) {
+        return sortKey(left) < sortKey(right);
+    });
+
+    LeagueScores scores;
+    for (const auto *entry : entries) {
+        const auto manager = cff::scoring_lifecycle::canonicalEmail(entry->get("managerEmail", "").asString());
+        const auto playerId = entry->get("playerId", "").asString();
+        const auto player = table.index(playerId);
+        const auto fantasyPoints = player ? points[*player] : 0.0;
+
+        Json::Value snapshot = entry->get("player", Json::Value{Json::objectValue});
+        if (!snapshot.isObject()) snapshot = Json::Value{Json::objectValue};
+        snapshot["id"] = playerId;
+        snapshot["playerId"] = playerId;
+        Json::Value score(Json::objectValue);
+        score["managerEmail"] = manager;
+        score["playerId"] = playerId;
+        score["player"] = snapshot;
+        score["rosterSlot"] = entry->get("rosterSlot", "").asString();
+        score["fantasyPoints"] = fantasyPoints;
+        score["stats"] = player ? table.stats(*player) : Json::Value{Json::objectValue};
+        scores.playerScores.append(score);
+        scores.managerTotals[manager] += fantasyPoints;
+    }
+    return scores;
+}
+
+void forEachPartitioned(std::size_t count,
+                        std::size_t partitions,
+                        const Submit &submit,
+                        const std::function<void(std::size_t)> &work) {
+    partitions = std::max<std::size_t>(1, std::min(partitions, count));
+    if (partitions <= 1) {
+        for (std::size_t index = 0; index < count; ++index) work(index);
+        return;
+    }
+    struct Progress {
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable idle;
+        std::size_t running{0};
+    };
+    const auto progress = std::make_shared<Progress>();
+    // A helper that starts after the range is exhausted claims nothing and
+    // never touches `work`, so it may outlive this call.
+    const auto drain = [progress, count, &work] {
+        {
+            std::lock_guard<std::mutex> lock(progress->mutex);
+            ++progress->running;
+        }
+        struct Leave {
+            Progress &progress;
+            ~Leave() {
+                {
+                    std::lock_guard<std::mutex> lock(progress.mutex);
+                    --progress.running;
+                }
+                progress.idle.notify_all();
+            }
+        } leave{*progress};
+        for (auto index = progress->next++; index < count; index = progress->next++) work(index);
+    };
+    for (std::size_t helper = 1; helper < partitions; ++helper) {
+        if (!submit(drain)) break;
+    }
+
+    std::exception_ptr failure;
+    try {
+        drain();
+    } catch (...) {
+        failure = std::current_exception();
+        progress->next = count;
+    }
+    std::unique_lock<std::mutex> lock(progress->mutex);
+    progress->idle.wait(lock, [&progress] { return progress->running == 0; });
+    lock.unlock();
+    if (failure) std::rethrow_exception(failure);
+}
+
+} // namespace cff::bulk_scoring
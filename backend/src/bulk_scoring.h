@@ -0,0 +1,85 @@
+#pragma once
+
+#include "scoring_lifecycle.h"
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cff::bulk_scoring {
+
+// One week's player_stats held column-wise: a row is (player index, interned
+// stat, value). Loaded once per week and shared by every league being
+// rescored, instead of each league joining rosters to player_stats.
+class WeekStatTable {
+public:
+    void add(const std::string &playerId, const std::string &category, const std::string &statName, double value);
+
+    std::optional<std::size_t> index(const std::string &playerId) const;
+    std::size_t players() const { return stats_.size(); }
+    std::size_t rows() const { return rowValue_.size(); }
+
+    // The "category.stat" map the scoring snapshot stores for a player.
+    const Json::Value &stats(std::size_t player) const { return stats_[player]; }
+
+    // Points for every player under one compiled profile, indexed like index().
+    std::vector<double> points(const cff::scoring_lifecycle::CompiledScoring &scoring) const;
+
+private:
+    std::unordered_map<std::string, std::size_t> index_;
+    std::vector<Json::Value> stats_;
+    std::vector<std::uint32_t> rowPlayer_;
+    std::vector<cff::scoring_lifecycle::StatKey> rowStat_;
+    std::vector<double> rowValue_;
+};
+
+// Per-player points computed once per distinct scoring_settings profile.
+// Leagues on the default settings all share one vector. Thread-safe.
+class ProfilePoints {
+public:
+    explicit ProfilePoints(const WeekStatTable &table) : table_(table) {}
+
+    std::shared_ptr<const std::vector<double>> pointsFor(const Json::Value &settings);
+    std::size_t profiles() const;
+
+private:
+    const WeekStatTable &table_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const std::vector<double>>> byProfile_;
+};
+
+struct LeagueScores {
+    Json::Value playerScores{Json::arrayValue};
+    std::unordered_map<std::string, double> managerTotals;
+};
+
+// Prices a league's lineup snapshot against the shared table. Entries come out
+// in byte-wise (manager, player) order -- the per-league scorer sorts with
+// COLLATE "C" -- with the same fields it writes, so the input hash matches a
+// manual rescore of the same data.
+LeagueScores scoreLineup(const Json::Value &lineup,
+                         const WeekStatTable &table,
+                         const std::vector<double> &points);
+
+// Queues a task on a shared worker pool (cff::db::submit in the server);
+// returns false when the task was not queued.
+using Submit = std::function<bool(std::function<void()>)>;
+
+// Runs work(0..count-1) on the calling thread plus up to `partitions - 1`
+// helpers queued through `submit`. Items are claimed one at a time, so the
+// caller finishes the range itself if helpers are rejected or never start;
+// it returns once every claimed item is done.
+void forEachPartitioned(std::size_t count,
+                        std::size_t partitions,
+                        const Submit &submit,
+                        const std::function<void(std::size_t)> &work);
+
+} // namespace cff::bulk_scoring
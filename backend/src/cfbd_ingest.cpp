@@ -1,16 +1,25 @@
 #include "cfbd_ingest.h"
 
+#include "json_array_stream.h"
+#include "player_catalog.h"
+
 #include <algorithm>
 #include <chrono>
 #include <cctype>
 #include <cpr/cpr.h>
 #include <cstdlib>
 #include <ctime>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
 #include <optional>
 #include <pqxx/pqxx>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -29,10 +38,28 @@ struct CfbdQuota {
 
 struct JsonRequestResult {
     nlohmann::json payload;
+    // Array elements delivered by streamJsonArray; payload stays empty there.
+    std::size_t elements = 0;
     bool ok = false;
     bool rateLimited = false;
 };
 
+// Thrown inside the player transaction to roll it back when an operator
+// cancels the refresh.
+struct IngestCancelled : std::runtime_error {
+    IngestCancelled() : std::runtime_error("ingest cancelled") {}
+};
+
+bool cancelled(const cff::IngestProgress *progress) {
+    return progress && progress->cancelled();
+}
+
+void report(cff::IngestProgress *progress, cff::IngestPhase phase, std::size_t apiCalls) {
+    if (!progress) return;
+    progress->phase.store(phase, std::memory_order_relaxed);
+    progress->apiCalls.store(apiCalls, std::memory_order_relaxed);
+}
+
 std::optional<std::string> readEnv(const std::string &key) {
     const char *value = std::getenv(key.c_str());
     if (!value || std::string{value}.empty()) return std::nullopt;
@@ -143,55 +170,66 @@ std::string responseHeader(const cpr::Response &response, const std::string &nam
     return "";
 }
 
-std::string responseDetail(const cpr::Response &response) {
-    const auto payload = nlohmann::json::parse(response.text, nullptr, false);
+std::string responseDetail(const std::string &body) {
+    const auto payload = nlohmann::json::parse(body, nullptr, false);
     if (!payload.is_object()) return "";
     return stringFromKeys(payload, {"message", "error", "detail"});
 }
 
-JsonRequestResult requestJson(const std::string &url,
-                              const std::string &apiKey,
-                              const cpr::Parameters &parameters,
-                              const std::string &label,
-                              std::vector<std::string> &errors,
-                              std::size_t &apiCalls) {
-    const auto response = cpr::Get(
-        cpr::Url{url},
-        cpr::Header{{"Authorization", "Bearer " + apiKey}},
-        parameters,
-        cpr::Timeout{60000}
-    );
-    ++apiCalls;
-
-    JsonRequestResult result;
+// Records the failure for a non-2xx or network error and returns false.
+// `body` is the (possibly truncated) response body used for CFBD's message.
+bool acceptResponse(const cpr::Response &response,
+                    const std::string &body,
+                    const std::string &label,
+                    std::vector<std::string> &errors,
+                    bool &rateLimited) {
     if (response.error) {
         errors.push_back(label + " network error: " + response.error.message);
-        return result;
+        return false;
     }
     if (response.status_code == 401 || response.status_code == 403) {
         errors.push_back(label + " authentication failed with status " +
                          std::to_string(response.status_code) + ".");
-        return result;
+        return false;
     }
     if (response.status_code == 429) {
         std::string message = label + " was rate-limited by CFBD (429)";
-        const auto detail = responseDetail(response);
+        const auto detail = responseDetail(body);
         const auto retryAfter = responseHeader(response, "Retry-After");
         if (!detail.empty()) message += ": " + detail;
         if (!retryAfter.empty()) message += "; retry after " + retryAfter;
         message += ". The roster refresh stopped immediately and the existing player catalog was preserved.";
         errors.push_back(std::move(message));
-        result.rateLimited = true;
-        return result;
+        rateLimited = true;
+        return false;
     }
     if (response.status_code < 200 || response.status_code >= 300) {
         std::string message = label + " failed with status " +
                               std::to_string(response.status_code);
-        const auto detail = responseDetail(response);
+        const auto detail = responseDetail(body);
         if (!detail.empty()) message += ": " + detail;
         errors.push_back(message + ".");
-        return result;
+        return false;
     }
+    return true;
+}
+
+JsonRequestResult requestJson(const std::string &url,
+                              const std::string &apiKey,
+                              const cpr::Parameters &parameters,
+                              const std::string &label,
+                              std::vector<std::string> &errors,
+                              std::size_t &apiCalls) {
+    const auto response = cpr::Get(
+        cpr::Url{url},
+        cpr::Header{{"Authorization", "Bearer " + apiKey}},
+        parameters,
+        cpr::Timeout{60000}
+    );
+    ++apiCalls;
+
+    JsonRequestResult result;
+    if (!acceptResponse(response, response.text, label, errors, result.rateLimited)) return result;
 
     result.payload = nlohmann::json::parse(response.text, nullptr, false);
     if (result.payload.is_discarded()) {
@@ -202,6 +240,61 @@ JsonRequestResult requestJson(const std::string &url,
     return result;
 }
 
+// Streams a JSON array response element by element into `onElement` while
+// it downloads; neither the body nor a document for it is ever held whole.
+// Elements already delivered must be discarded by the caller when this
+// returns !ok (a truncated or non-array body). A cancelled `progress` aborts
+// the download and returns !ok without an error.
+JsonRequestResult streamJsonArray(const std::string &url,
+                                  const std::string &apiKey,
+                                  const cpr::Parameters &parameters,
+                                  const std::string &label,
+                                  std::vector<std::string> &errors,
+                                  std::size_t &apiCalls,
+                                  const std::function<void(const nlohmann::json &)> &onElement,
+                                  const cff::IngestProgress *progress = nullptr) {
+    // Error bodies are small objects; a prefix is enough for CFBD's message.
+    constexpr std::size_t kDetailBytes = 4096;
+    std::string detail;
+    std::size_t invalidElements = 0;
+    cff::json_stream::ArraySplitter splitter{[&](std::string_view text) {
+        const auto element = nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+        if (element.is_discarded()) {
+            ++invalidElements;
+            return;
+        }
+        onElement(element);
+    }};
+
+    const auto response = cpr::Get(
+        cpr::Url{url},
+        cpr::Header{{"Authorization", "Bearer " + apiKey}},
+        parameters,
+        cpr::Timeout{60000},
+        cpr::WriteCallback{[&](std::string_view data, intptr_t) {
+            if (detail.size() < kDetailBytes) detail.append(data.substr(0, kDetailBytes - detail.size()));
+            splitter.feed(data);
+            return !cancelled(progress);
+        }}
+    );
+    ++apiCalls;
+
+    JsonRequestResult result;
+    if (cancelled(progress)) return result;
+    if (!acceptResponse(response, detail, label, errors, result.rateLimited)) return result;
+    if (!splitter.finish()) {
+        errors.push_back(label + " returned an unexpected response shape (" + splitter.error() + ").");
+        return result;
+    }
+    if (invalidElements > 0) {
+        errors.push_back(label + " returned invalid JSON.");
+        return result;
+    }
+    result.elements = splitter.elements();
+    result.ok = true;
+    return result;
+}
+
 std::optional<CfbdQuota> fetchQuota(const std::string &baseUrl,
                                     const std::string &apiKey,
                                     std::vector<std::string> &errors,
@@ -318,7 +411,9 @@ void recordIngestionRun(const std::string &dbUrl,
     try {
         pqxx::connection connection{dbUrl};
         pqxx::work transaction{connection};
-        const auto status = result.complete && result.errors.empty() ? "success" : "partial";
+        const auto status = result.cancelled
+            ? "cancelled"
+            : result.complete && result.errors.empty() ? "success" : "partial";
         transaction.exec_params(
             "INSERT INTO ingestion_runs (resource, season, finished_at, status, call_count, row_count, error_message) "
             "VALUES ('players', $1, NOW(), $2, $3, $4, NULLIF($5, ''))",
@@ -345,7 +440,8 @@ std::vector<CfbdPlayer> fetchPlayersFromCFBD(const std::string &baseUrl,
                                              std::vector<std::string> &errors,
                                              std::size_t &apiCalls,
                                              std::size_t &teamsExpected,
-                                             std::size_t &teamsFetched) {
+                                             std::size_t &teamsFetched,
+                                             IngestProgress *progress) {
     const auto normalizedBase = trimTrailingSlash(
         baseUrl.empty() ? "https://api.collegefootballdata.com" : baseUrl
     );
@@ -356,8 +452,9 @@ std::vector<CfbdPlayer> fetchPlayersFromCFBD(const std::string &baseUrl,
     // roster request. Keep one additional call in reserve so the job does not
     // intentionally consume the last available request in the monthly pool.
     constexpr long long kCallsRequiredAfterPreflight = 3;
+    report(progress, IngestPhase::Preflight, apiCalls);
     const auto quota = fetchQuota(normalizedBase, apiKey, errors, apiCalls);
-    if (!quota) return {};
+    if (!quota || cancelled(progress)) return {};
     if (*quota->remainingCalls < kCallsRequiredAfterPreflight) {
         std::string message = "CFBD quota preflight found " +
                               std::to_string(*quota->remainingCalls) +
@@ -370,7 +467,9 @@ std::vector<CfbdPlayer> fetchPlayersFromCFBD(const std::string &baseUrl,
         return {};
     }
 
+    report(progress, IngestPhase::FetchingTeams, apiCalls);
     const auto teams = fetchFbsTeams(normalizedBase, apiKey, season, errors, apiCalls);
+    if (cancelled(progress)) return {};
     if (teams.empty()) {
         if (errors.empty()) errors.push_back("CFBD returned no FBS teams for season " + season + ".");
         return {};
@@ -381,6 +480,7 @@ std::vector<CfbdPlayer> fetchPlayersFromCFBD(const std::string &baseUrl,
         static_cast<std::size_t>(std::max(1, maxTeams))
     );
     teamsExpected = fetchLimit;
+    if (progress) progress->teamsExpected.store(fetchLimit, std::memory_order_relaxed);
     if (fetchLimit < teams.size()) {
         errors.push_back("CFBD_MAX_TEAMS limited the refresh to " + std::to_string(fetchLimit) +
                          " of " + std::to_string(teams.size()) + " FBS teams; stale players were not retired.");
@@ -395,74 +495,75 @@ std::vector<CfbdPlayer> fetchPlayersFromCFBD(const std::string &baseUrl,
         if (index < fetchLimit) selectedTeams.insert(teams[index].school);
     }
 
-    const auto rosterResponse = requestJson(
+    std::vector<CfbdPlayer> players;
+    std::unordered_map<std::string, std::size_t> playerIndexes;
+    std::unordered_set<std::string> rosterTeams;
+    rosterTeams.reserve(fetchLimit);
+
+    // Each roster entry is parsed, trimmed to a CfbdPlayer and dropped as it
+    // arrives, so peak memory follows the kept players, not the response.
+    report(progress, IngestPhase::FetchingRosters, apiCalls);
+    const auto rosterResponse = streamJsonArray(
         normalizedBase + "/roster",
         apiKey,
         cpr::Parameters{{"year", season}, {"classification", "fbs"}},
         "CFBD bulk FBS roster",
         errors,
-        apiCalls
+        apiCalls,
+        [&](const nlohmann::json &entry) {
+            const auto teamName = stringFromKeys(entry, {"team", "school"});
+            if (teamName.empty() || selectedTeams.find(teamName) == selectedTeams.end()) return;
+            if (rosterTeams.insert(teamName).second && progress) {
+                progress->teamsFetched.store(rosterTeams.size(), std::memory_order_relaxed);
+            }
+
+            CfbdPlayer player;
+            player.id = stringFromKeys(entry, {"id", "athleteId", "playerId"});
+            if (player.id.empty()) {
+                std::cerr << "[cfbd] Skipping a " << teamName
+                          << " roster entry without a player id." << std::endl;
+                return;
+            }
+            player.firstName = stringFromKeys(entry, {"first_name", "firstName"});
+            player.lastName = stringFromKeys(entry, {"last_name", "lastName"});
+            player.fullName = stringFromKeys(entry, {"name", "full_name", "fullName"});
+            if (player.fullName.empty()) {
+                player.fullName = player.firstName;
+                if (!player.fullName.empty() && !player.lastName.empty()) player.fullName += " ";
+                player.fullName += player.lastName;
+            }
+            if (player.fullName.empty()) player.fullName = "Player " + player.id;
+            player.position = stringFromKeys(entry, {"position"});
+            player.team = teamName;
+            const auto conference = conferenceByTeam.find(teamName);
+            player.conference = conference == conferenceByTeam.end() ? "" : conference->second;
+            player.year = stringFromKeys(entry, {"year", "class"});
+            player.height = stringFromKeys(entry, {"height"});
+            player.weight = intFromKeys(entry, {"weight"});
+            player.season = seasonYear;
+            auto raw = entry;
+            raw["cffTeam"] = teamName;
+            raw["cffConference"] = player.conference;
+            raw["cffSeason"] = seasonYear;
+            player.raw = raw.dump();
+
+            const auto existing = playerIndexes.find(player.id);
+            if (existing == playerIndexes.end()) {
+                playerIndexes.emplace(player.id, players.size());
+                players.push_back(std::move(player));
+            } else {
+                players[existing->second] = std::move(player);
+            }
+        },
+        progress
     );
-    if (!rosterResponse.ok) return {};
-    if (!rosterResponse.payload.is_array()) {
-        errors.push_back("CFBD bulk FBS roster returned an unexpected response shape.");
-        return {};
-    }
-    if (rosterResponse.payload.empty()) {
+    if (progress) progress->apiCalls.store(apiCalls, std::memory_order_relaxed);
+    if (!rosterResponse.ok || cancelled(progress)) return {};
+    if (rosterResponse.elements == 0) {
         errors.push_back("CFBD returned an empty bulk FBS roster for season " + season + ".");
         return {};
     }
 
-    std::vector<CfbdPlayer> players;
-    std::unordered_map<std::string, std::size_t> playerIndexes;
-    std::unordered_set<std::string> rosterTeams;
-    players.reserve(rosterResponse.payload.size());
-    playerIndexes.reserve(rosterResponse.payload.size());
-    rosterTeams.reserve(fetchLimit);
-
-    for (const auto &entry : rosterResponse.payload) {
-        const auto teamName = stringFromKeys(entry, {"team", "school"});
-        if (teamName.empty() || selectedTeams.find(teamName) == selectedTeams.end()) continue;
-        rosterTeams.insert(teamName);
-
-        CfbdPlayer player;
-        player.id = stringFromKeys(entry, {"id", "athleteId", "playerId"});
-        if (player.id.empty()) {
-            std::cerr << "[cfbd] Skipping a " << teamName
-                      << " roster entry without a player id." << std::endl;
-            continue;
-        }
-        player.firstName = stringFromKeys(entry, {"first_name", "firstName"});
-        player.lastName = stringFromKeys(entry, {"last_name", "lastName"});
-        player.fullName = stringFromKeys(entry, {"name", "full_name", "fullName"});
-        if (player.fullName.empty()) {
-            player.fullName = player.firstName;
-            if (!player.fullName.empty() && !player.lastName.empty()) player.fullName += " ";
-            player.fullName += player.lastName;
-        }
-        if (player.fullName.empty()) player.fullName = "Player " + player.id;
-        player.position = stringFromKeys(entry, {"position"});
-        player.team = teamName;
-        const auto conference = conferenceByTeam.find(teamName);
-        player.conference = conference == conferenceByTeam.end() ? "" : conference->second;
-        player.year = stringFromKeys(entry, {"year", "class"});
-        player.height = stringFromKeys(entry, {"height"});
-        player.weight = intFromKeys(entry, {"weight"});
-        player.season = seasonYear;
-        player.raw = entry;
-        player.raw["cffTeam"] = teamName;
-        player.raw["cffConference"] = player.conference;
-        player.raw["cffSeason"] = seasonYear;
-
-        const auto existing = playerIndexes.find(player.id);
-        if (existing == playerIndexes.end()) {
-            playerIndexes.emplace(player.id, players.size());
-            players.push_back(std::move(player));
-        } else {
-            players[existing->second] = std::move(player);
-        }
-    }
-
     teamsFetched = rosterTeams.size();
     if (players.empty()) {
         errors.push_back("CFBD bulk FBS roster contained no players for the selected teams.");
@@ -481,7 +582,8 @@ IngestResult upsertPlayersToPostgres(const std::vector<CfbdPlayer> &players,
                                      const std::string &dbUrl,
                                      int season,
                                      bool completeImport,
-                                     std::vector<std::string> &errors) {
+                                     std::vector<std::string> &errors,
+                                     IngestProgress *progress) {
     IngestResult result;
     result.complete = completeImport;
     if (players.empty()) {
@@ -498,30 +600,73 @@ IngestResult upsertPlayersToPostgres(const std::vector<CfbdPlayer> &players,
             return result;
         }
         ensurePlayersSchema(connection);
+        if (progress) progress->phase.store(IngestPhase::Staging, std::memory_order_relaxed);
 
         pqxx::work transaction{connection};
-        transaction.exec(
-            "CREATE TEMP TABLE current_player_import_ids (id TEXT PRIMARY KEY) ON COMMIT DROP"
-        );
-
-        for (const auto &player : players) {
-            transaction.exec_params(
-                "INSERT INTO current_player_import_ids (id) VALUES ($1) ON CONFLICT DO NOTHING",
-                player.id
+        // Every roster row is streamed into a staging table with one COPY and
+        // merged in a single statement, so a full FBS import costs a handful
+        // of round-trips instead of two per player.
+        transaction.exec(R"SQL(
+            CREATE TEMP TABLE player_import_staging (
+                id TEXT NOT NULL, full_name TEXT, first_name TEXT, last_name TEXT,
+                position TEXT, team TEXT, conference TEXT, year TEXT, height TEXT,
+                weight TEXT, raw TEXT, ordinal BIGINT NOT NULL
+            ) ON COMMIT DROP
+        )SQL");
+        {
+            auto staging = pqxx::stream_to::table(
+                transaction,
+                {"player_import_staging"},
+                {"id", "full_name", "first_name", "last_name", "position", "team",
+                 "conference", "year", "height", "weight", "raw", "ordinal"}
             );
-
-            const std::string weight = player.weight ? std::to_string(*player.weight) : "";
-            const auto upsert = transaction.exec_params(
-                R"SQL(
+            constexpr std::size_t kCancelCheckRows = 256;
+            std::size_t staged = 0;
+            for (const auto &player : players) {
+                if (++staged % kCancelCheckRows == 0) {
+                    if (cancelled(progress)) throw IngestCancelled{};
+                    if (progress) progress->rowsStaged.store(staged, std::memory_order_relaxed);
+                }
+                staging << std::make_tuple(
+                    player.id,
+                    player.fullName,
+                    player.firstName,
+                    player.lastName,
+                    player.position,
+                    player.team,
+                    player.conference,
+                    player.year,
+                    player.height,
+                    player.weight ? std::to_string(*player.weight) : std::string{},
+                    player.raw,
+                    static_cast<long long>(staged)
+                );
+            }
+            staging.complete();
+            if (progress) progress->rowsStaged.store(staged, std::memory_order_relaxed);
+        }
+        if (cancelled(progress)) throw IngestCancelled{};
+        transaction.exec("ANALYZE player_import_staging");
+        if (progress) progress->phase.store(IngestPhase::Merging, std::memory_order_relaxed);
+
+        // The fetch already keeps one row per id; DISTINCT ON guards the merge
+        // because ON CONFLICT DO UPDATE rejects a row touched twice, and keeps
+        // the last staged duplicate, as the fetch does.
+        const auto merged = transaction.exec_params(
+            R"SQL(
+                WITH merged AS (
                     INSERT INTO players (
                         id, full_name, first_name, last_name, position, team, conference,
                         year, height, weight, season, active, last_seen_at, raw
                     )
-                    VALUES (
-                        $1, $2, NULLIF($3, ''), NULLIF($4, ''), NULLIF($5, ''),
-                        NULLIF($6, ''), NULLIF($7, ''), NULLIF($8, ''), NULLIF($9, ''),
-                        NULLIF($10, '')::INT, $11, TRUE, NOW(), $12::jsonb
-                    )
+                    SELECT DISTINCT ON (staged.id)
+                        staged.id, staged.full_name, NULLIF(staged.first_name, ''),
+                        NULLIF(staged.last_name, ''), NULLIF(staged.position, ''),
+                        NULLIF(staged.team, ''), NULLIF(staged.conference, ''),
+                        NULLIF(staged.year, ''), NULLIF(staged.height, ''),
+                        NULLIF(staged.weight, '')::INT, $1, TRUE, NOW(), staged.raw::jsonb
+                    FROM player_import_staging AS staged
+                    ORDER BY staged.id, staged.ordinal DESC
                     ON CONFLICT (id) DO UPDATE SET
                         full_name = EXCLUDED.full_name,
                         first_name = EXCLUDED.first_name,
@@ -538,49 +683,48 @@ IngestResult upsertPlayersToPostgres(const std::vector<CfbdPlayer> &players,
                         raw = EXCLUDED.raw,
                         updated_at = NOW()
                     RETURNING (xmax = 0) AS inserted
-                )SQL",
-                player.id,
-                player.fullName,
-                player.firstName,
-                player.lastName,
-                player.position,
-                player.team,
-                player.conference,
-                player.year,
-                player.height,
-                weight,
-                season,
-                player.raw.dump()
-            );
-
-            if (!upsert.empty() && upsert[0][0].as<bool>()) {
-                ++result.ingested;
-            } else {
-                ++result.updated;
-            }
-        }
+                )
+                SELECT COUNT(*) FILTER (WHERE inserted), COUNT(*) FILTER (WHERE NOT inserted)
+                FROM merged
+            )SQL",
+            season
+        );
+        result.ingested = merged[0][0].as<std::size_t>();
+        result.updated = merged[0][1].as<std::size_t>();
+        if (progress) progress->rowsMerged.store(result.ingested + result.updated, std::memory_order_relaxed);
 
         if (completeImport) {
             const auto retired = transaction.exec_params(
                 R"SQL(
-                    UPDATE players AS player
-                    SET active = FALSE, updated_at = NOW()
-                    WHERE player.active = TRUE
-                      AND (
-                        player.season IS DISTINCT FROM $1
-                        OR NOT EXISTS (
-                          SELECT 1 FROM current_player_import_ids AS imported
-                          WHERE imported.id = player.id
-                        )
-                      )
-                    RETURNING player.id
+                    WITH retired AS (
+                        UPDATE players AS player
+                        SET active = FALSE, updated_at = NOW()
+                        WHERE player.active = TRUE
+                          AND (
+                            player.season IS DISTINCT FROM $1
+                            OR NOT EXISTS (
+                              SELECT 1 FROM player_import_staging AS imported
+                              WHERE imported.id = player.id
+                            )
+                          )
+                        RETURNING 1
+                    )
+                    SELECT COUNT(*) FROM retired
                 )SQL",
                 season
             );
-            result.retired = retired.size();
+            result.retired = retired[0][0].as<std::size_t>();
         }
 
+        // Last checkpoint: past the commit the refresh can no longer be undone.
+        if (cancelled(progress)) throw IngestCancelled{};
         transaction.commit();
+    } catch (const IngestCancelled &) {
+        result.ingested = 0;
+        result.updated = 0;
+        result.retired = 0;
+        result.complete = false;
+        result.cancelled = true;
     } catch (const std::exception &error) {
         errors.push_back(std::string{"Postgres player refresh failed: "} + error.what());
         result.complete = false;
@@ -589,7 +733,12 @@ IngestResult upsertPlayersToPostgres(const std::vector<CfbdPlayer> &players,
     return result;
 }
 
-IngestResult runCfbdIngestOnce() {
+namespace {
+
+constexpr const char *kCancelledMessage =
+    "The refresh was cancelled by an operator; the existing player catalog was preserved.";
+
+IngestResult ingestPlayers(IngestProgress &progress) {
     IngestResult overall;
     const auto apiKey = readEnv("CFBD_API_KEY");
     if (!apiKey) {
@@ -622,12 +771,19 @@ IngestResult runCfbdIngestOnce() {
         overall.errors,
         apiCalls,
         teamsExpected,
-        teamsFetched
+        teamsFetched,
+        &progress
     );
 
     overall.apiCalls = apiCalls;
     overall.teamsExpected = teamsExpected;
     overall.teamsFetched = teamsFetched;
+    if (progress.cancelled()) {
+        overall.cancelled = true;
+        overall.errors.push_back(kCancelledMessage);
+        recordIngestionRun(*dbUrl, season, overall);
+        return overall;
+    }
     if (players.empty()) {
         if (overall.errors.empty()) {
             overall.errors.push_back("No roster players were returned; the existing player catalog was preserved.");
@@ -647,13 +803,21 @@ IngestResult runCfbdIngestOnce() {
         *dbUrl,
         season,
         completeImport,
-        overall.errors
+        overall.errors,
+        &progress
     );
+    if (databaseResult.cancelled) {
+        overall.cancelled = true;
+        overall.errors.push_back(kCancelledMessage);
+        recordIngestionRun(*dbUrl, season, overall);
+        return overall;
+    }
 
     overall.ingested = databaseResult.ingested;
     overall.updated = databaseResult.updated;
     overall.retired = databaseResult.retired;
     overall.complete = completeImport && databaseResult.complete && overall.errors.empty();
+    if (overall.ingested + overall.updated + overall.retired > 0) rebuildPlayerSearchIndex();
 
     if (!overall.complete && overall.errors.empty()) {
         overall.errors.push_back("The player refresh was incomplete; stale players were kept active.");
@@ -662,4 +826,21 @@ IngestResult runCfbdIngestOnce() {
     return overall;
 }
 
+} // namespace
+
+IngestResult runCfbdIngestJob(IngestProgress &progress) {
+    // Admin jobs and the startup and scheduled runs all merge into players;
+    // a run that arrives while another is merging waits as queued.
+    static std::mutex running;
+    std::lock_guard<std::mutex> lock(running);
+    auto result = ingestPlayers(progress);
+    progress.phase.store(IngestPhase::Finished, std::memory_order_relaxed);
+    return result;
+}
+
+IngestResult runCfbdIngestOnce() {
+    IngestProgress progress;
+    return runCfbdIngestJob(progress);
+}
+
 } // namespace cff
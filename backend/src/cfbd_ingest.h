@@ -1,7 +1,7 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
-#include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
 #include <vector>
@@ -20,7 +20,9 @@ struct CfbdPlayer {
     std::string height;
     std::optional<int> weight;
     int season = 0;
-    nlohmann::json raw;
+    // Compact JSON of the CFBD entry plus cffTeam/cffConference/cffSeason,
+    // stored as players.raw.
+    std::string raw;
 };
 
 struct IngestResult {
@@ -31,9 +33,42 @@ struct IngestResult {
     std::size_t teamsExpected = 0;
     std::size_t teamsFetched = 0;
     bool complete = false;
+    bool cancelled = false;
     std::vector<std::string> errors;
 };
 
+enum class IngestPhase { Queued, Preflight, FetchingTeams, FetchingRosters, Staging, Merging, Finished };
+
+inline const char *ingestPhaseName(IngestPhase phase) {
+    switch (phase) {
+        case IngestPhase::Queued: return "queued";
+        case IngestPhase::Preflight: return "preflight";
+        case IngestPhase::FetchingTeams: return "fetching_teams";
+        case IngestPhase::FetchingRosters: return "fetching_rosters";
+        case IngestPhase::Staging: return "staging";
+        case IngestPhase::Merging: return "merging";
+        case IngestPhase::Finished: return "finished";
+    }
+    return "unknown";
+}
+
+// Live counters for a running refresh, written by the ingest and read by
+// status requests on other threads. Setting cancelRequested stops the refresh
+// at its next checkpoint: between requests, while the roster streams in,
+// every few hundred staged rows, and just before the merge commits. Nothing
+// is written to `players` once it is seen.
+struct IngestProgress {
+    std::atomic<IngestPhase> phase{IngestPhase::Queued};
+    std::atomic<std::size_t> apiCalls{0};
+    std::atomic<std::size_t> teamsExpected{0};
+    std::atomic<std::size_t> teamsFetched{0};
+    std::atomic<std::size_t> rowsStaged{0};
+    std::atomic<std::size_t> rowsMerged{0};
+    std::atomic<bool> cancelRequested{false};
+
+    bool cancelled() const { return cancelRequested.load(std::memory_order_relaxed); }
+};
+
 // Check the authenticated key's remaining quota, fetch the current FBS team
 // map, then retrieve every selected FBS roster through one bulk
 // classification-filtered request. teamsExpected and teamsFetched let callers
@@ -45,15 +80,19 @@ std::vector<CfbdPlayer> fetchPlayersFromCFBD(const std::string &baseUrl,
                                              std::vector<std::string> &errors,
                                              std::size_t &apiCalls,
                                              std::size_t &teamsExpected,
-                                             std::size_t &teamsFetched);
+                                             std::size_t &teamsFetched,
+                                             IngestProgress *progress = nullptr);
 
-// Upsert players into Postgres. Missing players are marked inactive only when
-// the caller confirms that every expected FBS roster was fetched successfully.
+// Upsert players into Postgres: the batch is COPYed into a staging table and
+// merged in one statement, with inserted/updated/retired counted set-wise.
+// Missing players are marked inactive only when the caller confirms that every
+// expected FBS roster was fetched successfully.
 IngestResult upsertPlayersToPostgres(const std::vector<CfbdPlayer> &players,
                                      const std::string &dbUrl,
                                      int season,
                                      bool completeImport,
-                                     std::vector<std::string> &errors);
+                                     std::vector<std::string> &errors,
+                                     IngestProgress *progress = nullptr);
 
 // Runs one season-aware roster refresh using:
 // - CFBD_API_KEY (required)
@@ -63,4 +102,10 @@ IngestResult upsertPlayersToPostgres(const std::vector<CfbdPlayer> &players,
 // - DB_URL (required)
 IngestResult runCfbdIngestOnce();
 
+// runCfbdIngestOnce() reporting into `progress` and honouring its
+// cancellation. A cancelled run is recorded in ingestion_runs as 'cancelled'.
+// Runs are serialized process-wide, so a scheduled ingest never merges
+// players concurrently with an admin job.
+IngestResult runCfbdIngestJob(IngestProgress &progress);
+
 } // namespace cff
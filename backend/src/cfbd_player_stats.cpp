@@ -0,0 +1,146 @@
+#include "cfbd_player_stats.h"
+
+#include "app_config.h"
+#include "cfbd_stat_mapping.h"
+#include "json_array_stream.h"
+#include "stat_ingestion_provider.h"
+
+#include <cpr/cpr.h>
+#include <json/json.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr const char *kOwner = "cfbd-player-stats";
+constexpr int kLeaseSeconds = 300;
+
+struct FetchResult {
+    bool ok{false};
+    int status{0};
+    bool networkFailure{false};
+    std::string error;
+};
+
+std::string trimSlash(std::string value) {
+    while (!value.empty() && value.back() == '/') value.pop_back();
+    return value;
+}
+
+// Streams the week's /games/players array and maps each game as it arrives;
+// only the mapped rows are kept, never the body or a document for it.
+FetchResult fetchWeek(const std::string &baseUrl,
+                      const std::string &apiKey,
+                      int season,
+                      int week,
+                      cff::cfbd_stats::WeekStats &stats,
+                      std::size_t &calls) {
+    bool invalidElement = false;
+    const std::unique_ptr<Json::CharReader> reader{Json::CharReaderBuilder{}.newCharReader()};
+    cff::json_stream::ArraySplitter splitter{[&](std::string_view text) {
+        Json::Value game;
+        if (!reader->parse(text.data(), text.data() + text.size(), &game, nullptr)) {
+            invalidElement = true;
+            return;
+        }
+        cff::cfbd_stats::appendGame(game, stats);
+    }};
+    const auto response = cpr::Get(
+        cpr::Url{baseUrl + "/games/players"},
+        cpr::Header{{"Authorization", "Bearer " + apiKey}},
+        cpr::Parameters{{"year", std::to_string(season)}, {"week", std::to_string(week)},
+                        {"seasonType", "regular"}},
+        cpr::Timeout{60000},
+        cpr::WriteCallback{[&](std::string_view data, intptr_t) {
+            splitter.feed(data);
+            return true;
+        }}
+    );
+    ++calls;
+
+    FetchResult result;
+    result.status = static_cast<int>(response.status_code);
+    if (response.error) {
+        result.networkFailure = true;
+        result.error = "CFBD player stats request failed: " + response.error.message;
+        return result;
+    }
+    if (response.status_code < 200 || response.status_code >= 300) {
+        result.error = "CFBD player stats request failed with status " +
+                       std::to_string(response.status_code) + ".";
+        return result;
+    }
+    if (!splitter.finish() || invalidElement) {
+        result.error = "CFBD player stats request did not return a JSON array.";
+        return result;
+    }
+    result.ok = true;
+    return result;
+}
+
+} // namespace
+
+namespace cff {
+
+PlayerStatIngestResult runCfbdPlayerStatIngestOnce(int season, int week) {
+    PlayerStatIngestResult result;
+    const auto apiKey = cff::config::readEnv("CFBD_API_KEY");
+    if (!apiKey) {
+        result.code = "not_configured";
+        result.errors.push_back("CFBD_API_KEY is required for player stat ingestion.");
+        return result;
+    }
+
+    // The lease is claimed before the request so replicas sharing a week
+    // spend one CFBD call between them, not one each.
+    const auto run = stat_ingestion::startProviderRun(season, week, kOwner, kLeaseSeconds);
+    result.runId = run.id;
+    if (run.code != "started") {
+        result.code = run.code;
+        if (run.code == "storage_unavailable") {
+            result.errors.push_back("The player stat ingestion lease could not be claimed.");
+        }
+        return result;
+    }
+
+    const auto baseUrl = trimSlash(
+        cff::config::readEnv("CFBD_API_BASE_URL").value_or("https://api.collegefootballdata.com"));
+    cfbd_stats::WeekStats stats;
+    const auto fetch = fetchWeek(baseUrl, *apiKey, season, week, stats, result.apiCalls);
+    result.providerStatus = fetch.status;
+    result.games = stats.games.size();
+    result.received = stats.rows.size();
+    if (!fetch.ok) {
+        result.code = "provider_failed";
+        result.errors.push_back(fetch.error);
+        stat_ingestion::failProviderRun(run, season, week, kOwner, fetch.status, fetch.networkFailure,
+                                        static_cast<int>(result.apiCalls), fetch.error);
+        return result;
+    }
+
+    const auto batchSize = cff::config::readSizeEnv("CFF_PLAYER_STAT_BATCH_SIZE", 500, 5000);
+    const auto applied = stat_ingestion::applyProviderStats(
+        run, season, week, kOwner, stats, static_cast<int>(result.apiCalls), kLeaseSeconds, batchSize);
+    result.code = applied.code;
+    result.inserted = applied.inserted;
+    result.corrected = applied.corrected;
+    result.unchanged = applied.unchanged;
+    result.unknownPlayerRows = applied.unknownPlayerRows;
+    result.changedPlayers = applied.changedPlayers;
+    result.queuedLeagues = applied.queuedLeagues;
+    result.batches = applied.batches;
+    if (!applied.applied) {
+        const auto error = "Player stat apply stopped after " + std::to_string(applied.batches) +
+                           " batch(es): " + applied.code + ".";
+        result.errors.push_back(error);
+        if (applied.code != "ingestion_lease_lost") {
+            stat_ingestion::failProviderRun(run, season, week, kOwner, 0, false,
+                                            static_cast<int>(result.apiCalls), error);
+        }
+    }
+    return result;
+}
+
+} // namespace cff
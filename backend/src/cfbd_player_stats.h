@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cff {
+
+struct PlayerStatIngestResult {
+    // "applied", or why nothing was applied: "not_configured",
+    // "ingestion_run_active", "ingestion_backoff_active", "provider_failed",
+    // "ingestion_lease_lost", "storage_unavailable".
+    std::string code;
+    long long runId{0};
+    std::size_t apiCalls{0};
+    std::size_t games{0};
+    std::size_t received{0};
+    std::size_t inserted{0};
+    std::size_t corrected{0};
+    std::size_t unchanged{0};
+    std::size_t unknownPlayerRows{0};
+    std::size_t changedPlayers{0};
+    std::size_t queuedLeagues{0};
+    std::size_t batches{0};
+    int providerStatus{0};
+    std::vector<std::string> errors;
+};
+
+// Fetches CFBD per-game player stats for one regular-season week and writes
+// the rows that changed through the stat ingestion lease. A week whose lease
+// is held by another worker, or that is still backing off after a provider
+// failure, is skipped before any CFBD call is made.
+PlayerStatIngestResult runCfbdPlayerStatIngestOnce(int season, int week);
+
+} // namespace cff
@@ -0,0 +1,193 @@
+#include "cfbd_stat_mapping.h"
+
+#include "stat_ingestion_lifecycle.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+#include <map>
+#include <optional>
+
+namespace cff::cfbd_stats {
+namespace {
+
+using cff::stat_ingestion_lifecycle::canonicalToken;
+
+struct StatKeyMapping {
+    const char *category;
+    const char *type;
+    const char *statName;
+};
+
+// CFBD stat types by canonical token; "C/ATT" is split separately.
+constexpr StatKeyMapping kStatKeys[] = {
+    {"passing", "yds", "passYards"},
+    {"passing", "td", "passTD"},
+    {"passing", "int", "passInt"},
+    {"rushing", "car", "rushAttempts"},
+    {"rushing", "yds", "rushYards"},
+    {"rushing", "td", "rushTD"},
+    {"receiving", "rec", "receptions"},
+    {"receiving", "yds", "recYards"},
+    {"receiving", "td", "recTD"},
+};
+
+std::string text(const Json::Value &value) {
+    if (value.isString()) return value.asString();
+    if (value.isIntegral()) return std::to_string(value.asLargestInt());
+    return "";
+}
+
+std::string textAt(const Json::Value &object, std::initializer_list<const char *> keys) {
+    if (!object.isObject()) return "";
+    for (const auto *key : keys) {
+        if (!object.isMember(key)) continue;
+        auto value = text(object[key]);
+        if (!value.empty()) return value;
+    }
+    return "";
+}
+
+std::optional<double> number(const std::string &raw) {
+    if (raw.empty()) return std::nullopt;
+    char *end = nullptr;
+    const double value = std::strtod(raw.c_str(), &end);
+    if (end == raw.c_str() || *end != '\0' || !std::isfinite(value)) return std::nullopt;
+    return value;
+}
+
+long long gameId(const Json::Value &game) {
+    const auto raw = textAt(game, {"id", "gameId"});
+    if (raw.empty() || !std::all_of(raw.begin(), raw.end(), [](unsigned char ch) { return std::isdigit(ch); })) {
+        return 0;
+    }
+    try { return std::stoll(raw); } catch (...) { return 0; }
+}
+
+// Team totals and unidentified athletes carry negative or missing ids.
+bool usablePlayerId(const std::string &id) {
+    return !id.empty() && std::all_of(id.begin(), id.end(), [](unsigned char ch) { return std::isdigit(ch); });
+}
+
+const char *statNameFor(const std::string &category, const std::string &type) {
+    for (const auto &mapping : kStatKeys) {
+        if (category == mapping.category && type == mapping.type) return mapping.statName;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void appendGame(const Json::Value &game, WeekStats &stats) {
+    const auto id = gameId(game);
+    const auto &teams = game["teams"];
+    if (id <= 0 || !teams.isArray()) return;
+
+    GameRow gameRow;
+    gameRow.id = id;
+    for (const auto &team : teams) {
+        const auto name = textAt(team, {"team", "school"});
+        const auto conference = textAt(team, {"conference"});
+        const auto side = canonicalToken(textAt(team, {"homeAway"}));
+        if (side == "home") gameRow.homeTeam = name;
+        if (side == "away") gameRow.awayTeam = name;
+
+        const auto &categories = team["categories"];
+        if (!categories.isArray()) continue;
+        for (const auto &category : categories) {
+            const auto categoryName = canonicalToken(textAt(category, {"name"}));
+            const auto &types = category["types"];
+            if (!types.isArray()) continue;
+            for (const auto &type : types) {
+                const auto typeName = canonicalToken(textAt(type, {"name"}));
+                const bool completions = categoryName == "passing" && typeName == "catt";
+                const auto *statName = completions ? nullptr : statNameFor(categoryName, typeName);
+                if (!completions && !statName) continue;
+                const auto &athletes = type["athletes"];
+                if (!athletes.isArray()) continue;
+
+                for (const auto &athlete : athletes) {
+                    StatRow row;
+                    row.playerId = textAt(athlete, {"id", "athleteId"});
+                    row.gameId = id;
+                    row.team = name;
+                    row.conference = conference;
+                    row.category = categoryName;
+                    const auto raw = textAt(athlete, {"stat"});
+                    if (!usablePlayerId(row.playerId)) {
+                        ++stats.skipped;
+                        continue;
+                    }
+                    if (completions) {
+                        const auto slash = raw.find('/');
+                        const auto made = slash == std::string::npos ? std::nullopt : number(raw.substr(0, slash));
+                        const auto thrown = slash == std::string::npos ? std::nullopt : number(raw.substr(slash + 1));
+                        if (!made || !thrown) {
+                            ++stats.skipped;
+                            continue;
+                        }
+                        row.statName = "passCompletions";
+                        row.value = *made;
+                        stats.rows.push_back(row);
+                        row.statName = "passAttempts";
+                        row.value = *thrown;
+                        stats.rows.push_back(std::move(row));
+                        continue;
+                    }
+                    const auto value = number(raw);
+                    if (!value) {
+                        ++stats.skipped;
+                        continue;
+                    }
+                    row.statName = statName;
+                    row.value = *value;
+                    stats.rows.push_back(std::move(row));
+                }
+            }
+        }
+    }
+    stats.games.push_back(std::move(gameRow));
+}
+
+Json::Value statRecord(const StatRow &row, int season, int week) {
+    Json::Value record(Json::objectValue);
+    record["playerId"] = row.playerId;
+    record["season"] = season;
+    record["week"] = week;
+    record["category"] = canonicalToken(row.category);
+    record["statName"] = canonicalToken(row.statName);
+    record["gameId"] = Json::Int64(row.gameId);
+    record["statValue"] = row.value;
+    record["team"] = row.team;
+    record["conference"] = row.conference;
+    return record;
+}
+
+std::string statKey(const StatRow &row, int season, int week) {
+    return cff::stat_ingestion_lifecycle::statRecordKey(statRecord(row, season, week));
+}
+
+StatDiff diffStats(const std::vector<StatRow> &rows,
+                   int season,
+                   int week,
+                   const std::unordered_map<std::string, std::string> &storedHashes) {
+    StatDiff diff;
+    std::map<std::string, const StatRow *> latest;
+    for (const auto &row : rows) {
+        if (!latest.insert_or_assign(statKey(row, season, week), &row).second) ++diff.duplicates;
+    }
+    for (const auto &[key, row] : latest) {
+        const auto hash = cff::stat_ingestion_lifecycle::statSourceHash(statRecord(*row, season, week));
+        const auto stored = storedHashes.find(key);
+        if (stored != storedHashes.end() && stored->second == hash) {
+            ++diff.unchanged;
+            continue;
+        }
+        diff.changes.push_back({*row, hash, stored == storedHashes.end()});
+    }
+    return diff;
+}
+
+} // namespace cff::cfbd_stats
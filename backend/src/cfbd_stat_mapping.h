@@ -0,0 +1,68 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cff::cfbd_stats {
+
+// One player_stats row in the db/stat_keys.md vocabulary.
+struct StatRow {
+    std::string playerId;
+    long long gameId{0};
+    std::string team;
+    std::string conference;
+    std::string category;
+    std::string statName;
+    double value{0.0};
+};
+
+// player_stats.game_id references games, so every game a row mentions is
+// carried alongside the rows.
+struct GameRow {
+    long long id{0};
+    std::string homeTeam;
+    std::string awayTeam;
+};
+
+struct WeekStats {
+    std::vector<GameRow> games;
+    std::vector<StatRow> rows;
+    // Athlete entries without a usable CFBD id or numeric value, such as
+    // team totals.
+    std::size_t skipped{0};
+};
+
+// Maps one element of CFBD's /games/players response. Averages, long gains
+// and QBR have no stat key and are dropped; defense stays reserved.
+void appendGame(const Json::Value &game, WeekStats &stats);
+
+// The record the manual apply action would build for this row, so both
+// writers agree on player_stats keys and source hashes.
+Json::Value statRecord(const StatRow &row, int season, int week);
+std::string statKey(const StatRow &row, int season, int week);
+
+struct StatChange {
+    StatRow row;
+    std::string sourceHash;
+    bool inserted{false};
+};
+
+struct StatDiff {
+    std::vector<StatChange> changes;
+    std::size_t unchanged{0};
+    std::size_t duplicates{0};
+};
+
+// Compares fetched rows with the stored source hash of each statKey(). Rows
+// repeated in the feed keep their last value, and changes come back in key
+// order so batches are stable between runs.
+StatDiff diffStats(const std::vector<StatRow> &rows,
+                   int season,
+                   int week,
+                   const std::unordered_map<std::string, std::string> &storedHashes);
+
+} // namespace cff::cfbd_stats
@@ -0,0 +1,156 @@
+#include "db_executor.h"
+
+#include "app_config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace cff::db {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+thread_local bool executorThread = false;
+
+struct QueuedTask {
+    std::function<void()> task;
+    Clock::time_point queuedAt{};
+};
+
+ExecutorSettings loadExecutorSettings() {
+    ExecutorSettings settings;
+    settings.threads = std::max<std::size_t>(
+        1, cff::config::readSizeEnv("CFF_DB_EXECUTOR_THREADS", 8, 128));
+    settings.queueCapacity = std::max<std::size_t>(
+        1, cff::config::readSizeEnv("CFF_DB_EXECUTOR_QUEUE_CAPACITY", 256, 65536));
+    return settings;
+}
+
+class Executor {
+public:
+    Executor() : settings_(loadExecutorSettings()) {}
+
+    ExecutorSettings settings() const { return settings_; }
+
+    bool submit(std::function<void()> task) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= settings_.queueCapacity) {
+            ++rejected_;
+            return false;
+        }
+        startWorkersLocked();
+        queue_.push_back(QueuedTask{std::move(task), Clock::now()});
+        ++submitted_;
+        lock.unlock();
+        ready_.notify_one();
+        return true;
+    }
+
+    ExecutorMetrics metrics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ExecutorMetrics metrics;
+        metrics.threads = started_ ? settings_.threads : 0;
+        metrics.queueCapacity = settings_.queueCapacity;
+        metrics.queued = queue_.size();
+        metrics.active = active_;
+        metrics.submitted = submitted_;
+        metrics.completed = completed_;
+        metrics.rejected = rejected_;
+        metrics.failed = failed_;
+        metrics.totalQueueMicros = totalQueueMicros_;
+        metrics.maxQueueMicros = maxQueueMicros_;
+        return metrics;
+    }
+
+private:
+    void startWorkersLocked() {
+        if (started_) return;
+        started_ = true;
+        for (std::size_t index = 0; index < settings_.threads; ++index) {
+            std::thread([this] { run(); }).detach();
+        }
+    }
+
+    void run() {
+        executorThread = true;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            ready_.wait(lock, [this] { return !queue_.empty(); });
+            auto next = std::move(queue_.front());
+            queue_.pop_front();
+            ++active_;
+            const auto micros = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - next.queuedAt).count());
+            totalQueueMicros_ += micros;
+            maxQueueMicros_ = std::max(maxQueueMicros_, micros);
+            lock.unlock();
+
+            bool ok = true;
+            try {
+                next.task();
+            } catch (const std::exception &error) {
+                ok = false;
+                std::cerr << "[db-executor] task failed: " << error.what() << std::endl;
+            } catch (...) {
+                ok = false;
+                std::cerr << "[db-executor] task failed with an unknown exception" << std::endl;
+            }
+            // Release captured state (requests, callbacks, pooled connections)
+            // before the slot is reported free.
+            next.task = nullptr;
+
+            lock.lock();
+            --active_;
+            ++completed_;
+            if (!ok) ++failed_;
+        }
+    }
+
+    const ExecutorSettings settings_;
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<QueuedTask> queue_;
+    bool started_{false};
+    std::size_t active_{0};
+    std::uint64_t submitted_{0};
+    std::uint64_t completed_{0};
+    std::uint64_t rejected_{0};
+    std::uint64_t failed_{0};
+    std::uint64_t totalQueueMicros_{0};
+    std::uint64_t maxQueueMicros_{0};
+};
+
+// Intentionally leaked: workers are detached and may still be finishing a
+// task during static destruction.
+Executor &executor() {
+    static auto *instance = new Executor();
+    return *instance;
+}
+
+} // namespace
+
+bool submit(std::function<void()> task) {
+    return executor().submit(std::move(task));
+}
+
+bool onExecutorThread() {
+    return executorThread;
+}
+
+ExecutorSettings executorSettings() {
+    return executor().settings();
+}
+
+ExecutorMetrics executorMetrics() {
+    return executor().metrics();
+}
+
+} // namespace cff::db
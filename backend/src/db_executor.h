@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace cff::db {
+
+struct ExecutorSettings {
+    std::size_t threads{8};
+    std::size_t queueCapacity{256};
+};
+
+struct ExecutorMetrics {
+    std::size_t threads{0};
+    std::size_t queueCapacity{0};
+    std::size_t queued{0};
+    std::size_t active{0};
+    std::uint64_t submitted{0};
+    std::uint64_t completed{0};
+    std::uint64_t rejected{0};
+    std::uint64_t failed{0};
+    std::uint64_t totalQueueMicros{0};
+    std::uint64_t maxQueueMicros{0};
+};
+
+// Queue blocking database work on the shared worker pool so Drogon IO loops
+// never wait on Postgres. Returns false without running the task when the
+// queue is full; callers should answer with a retryable 503 instead of
+// blocking the loop. Workers start on first use.
+bool submit(std::function<void()> task);
+
+// True on executor worker threads; lets callers that are already off the IO
+// loop run inline instead of queueing a second hop.
+bool onExecutorThread();
+
+ExecutorSettings executorSettings();
+ExecutorMetrics executorMetrics();
+
+} // namespace cff::db
@@ -0,0 +1,79 @@
+#include "db_offload.h"
+
+#include "db_executor.h"
+#include "http_security.h"
+
+#include <json/json.h>
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace cff::db {
+namespace {
+
+drogon::HttpResponsePtr errorResponse(const drogon::HttpRequestPtr &request,
+                                      drogon::HttpStatusCode status,
+                                      const std::string &message,
+                                      const std::string &code,
+                                      bool retryable) {
+    Json::Value payload(Json::objectValue);
+    payload["error"] = message;
+    payload["code"] = code;
+    payload["retryable"] = retryable;
+    auto response = drogon::HttpResponse::newHttpJsonResponse(payload);
+    response->setStatusCode(status);
+    if (retryable) response->addHeader("Retry-After", "1");
+    return cff::http::withRuntimeCorsHeaders(request, response);
+}
+
+drogon::HttpResponsePtr busyResponse(const drogon::HttpRequestPtr &request) {
+    return errorResponse(request,
+                         drogon::k503ServiceUnavailable,
+                         "The server is busy. Please retry shortly.",
+                         "database_busy",
+                         true);
+}
+
+} // namespace
+
+void adviseOnExecutor(const drogon::HttpRequestPtr &request,
+                      drogon::AdviceCallback &&callback,
+                      drogon::AdviceChainCallback &&chain,
+                      std::function<drogon::HttpResponsePtr()> work) {
+    // Shared so the IO thread can still answer if the executor rejects the task.
+    auto respond = std::make_shared<drogon::AdviceCallback>(std::move(callback));
+    auto task = [request, respond, chain = std::move(chain), work = std::move(work)]() {
+        drogon::HttpResponsePtr response;
+        try {
+            response = work();
+        } catch (const std::exception &error) {
+            std::cerr << "[db-executor] " << request->getPath() << " failed: " << error.what() << std::endl;
+            response = errorResponse(request,
+                                     drogon::k500InternalServerError,
+                                     "The request could not be completed.",
+                                     "internal_error",
+                                     false);
+        }
+        if (response) {
+            (*respond)(response);
+        } else {
+            chain();
+        }
+    };
+    if (onExecutorThread()) return task();
+    if (!submit(std::move(task))) (*respond)(busyResponse(request));
+}
+
+void continueOnExecutor(const drogon::HttpRequestPtr &request,
+                        drogon::AdviceCallback &&callback,
+                        drogon::AdviceChainCallback &&chain) {
+    if (onExecutorThread()) return chain();
+    if (!submit([chain = std::move(chain)]() { chain(); })) {
+        callback(busyResponse(request));
+    }
+}
+
+} // namespace cff::db
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <drogon/drogon.h>
+
+#include <functional>
+
+namespace cff::db {
+
+// Run a blocking advice body on the DB executor. A non-null response from
+// `work` answers the request; a null one continues the advice chain (routing
+// and the legacy handler) on the same worker, matching sync-advice semantics.
+// When the executor is saturated the request is answered immediately with a
+// retryable 503 rather than queued on the IO loop.
+void adviseOnExecutor(const drogon::HttpRequestPtr &request,
+                      drogon::AdviceCallback &&callback,
+                      drogon::AdviceChainCallback &&chain,
+                      std::function<drogon::HttpResponsePtr()> work);
+
+// Continue routing on a DB executor worker so the matched handler's libpq
+// calls run off the IO loop.
+void continueOnExecutor(const drogon::HttpRequestPtr &request,
+                        drogon::AdviceCallback &&callback,
+                        drogon::AdviceChainCallback &&chain);
+
+} // namespace cff::db
@@ -0,0 +1,353 @@
+#include "db_pool.h"
+
+#include "app_config.h"
+#include "db_statements.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cff::db {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct IdleConnection {
+    PGconn *connection{nullptr};
+    Clock::time_point createdAt{};
+    Clock::time_point returnedAt{};
+};
+
+PoolSettings loadPoolSettings() {
+    PoolSettings settings;
+    settings.maxConnections = cff::config::readSizeEnv("CFF_DB_POOL_SIZE", 16, 256);
+    settings.acquireTimeout = std::chrono::milliseconds(
+        cff::config::readSizeEnv("CFF_DB_POOL_ACQUIRE_TIMEOUT_MS", 5000, 60000));
+    settings.maxLifetime = std::chrono::seconds(
+        cff::config::readSizeEnv("CFF_DB_POOL_MAX_LIFETIME_SECONDS", 1800, 24 * 3600));
+    settings.healthCheckAfterIdle = std::chrono::seconds(
+        cff::config::readSizeEnv("CFF_DB_POOL_HEALTH_CHECK_IDLE_SECONDS", 30, 3600));
+    return settings;
+}
+
+void closeConnection(PGconn *connection) {
+    forgetConnection(connection);
+    PQfinish(connection);
+}
+
+void closeAll(std::vector<PGconn *> &connections) {
+    for (auto *connection : connections) closeConnection(connection);
+    connections.clear();
+}
+
+bool connectionHealthy(PGconn *connection) {
+    if (PQstatus(connection) != CONNECTION_OK) return false;
+    // An empty query is the cheapest full round-trip libpq offers.
+    auto *result = PQexec(connection, "");
+    const bool healthy = result && PQresultStatus(result) == PGRES_EMPTY_QUERY;
+    if (result) PQclear(result);
+    return healthy && PQstatus(connection) == CONNECTION_OK;
+}
+
+bool restoreIdleSession(PGconn *connection) {
+    if (PQstatus(connection) != CONNECTION_OK) return false;
+#ifdef LIBPQ_HAS_PIPELINING
+    // A batch that could not be drained leaves results the next borrower
+    // would read as its own.
+    if (PQpipelineStatus(connection) != PQ_PIPELINE_OFF) return false;
+#endif
+    switch (PQtransactionStatus(connection)) {
+        case PQTRANS_IDLE:
+            return true;
+        case PQTRANS_INTRANS:
+        case PQTRANS_INERROR: {
+            auto *result = PQexec(connection, "ROLLBACK");
+            if (result) PQclear(result);
+            return PQtransactionStatus(connection) == PQTRANS_IDLE;
+        }
+        default:
+            // PQTRANS_ACTIVE or PQTRANS_UNKNOWN: a command is still in flight
+            // or the session is lost; neither is safe to hand out again.
+            return false;
+    }
+}
+
+class ConnectionPool {
+public:
+    ConnectionPool() : settings_(loadPoolSettings()) {}
+
+    PoolSettings settings() const { return settings_; }
+
+    bool acquire(PGconn *&connection, Clock::time_point &createdAt, std::uint64_t &generation) {
+        const auto url = cff::config::readEnv("DB_URL");
+        if (!url || url->empty()) return false;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (*url != url_) {
+            std::vector<PGconn *> stale;
+            detachIdleLocked(stale);
+            url_ = *url;
+            lock.unlock();
+            closeAll(stale);
+            lock.lock();
+        }
+
+        const auto waitStarted = Clock::now();
+        const auto deadline = waitStarted + settings_.acquireTimeout;
+        bool waited = false;
+        while (true) {
+            if (!idle_.empty()) {
+                auto candidate = idle_.back();
+                idle_.pop_back();
+                ++inUse_;
+                const auto candidateGeneration = generation_;
+                lock.unlock();
+                if (usable(candidate)) {
+                    recordCheckout(waited, waitStarted);
+                    connection = candidate.connection;
+                    createdAt = candidate.createdAt;
+                    generation = candidateGeneration;
+                    return true;
+                }
+                closeConnection(candidate.connection);
+                lock.lock();
+                --inUse_;
+                --open_;
+                continue;
+            }
+
+            if (open_ < settings_.maxConnections) {
+                ++open_;
+                ++inUse_;
+                const auto connectUrl = url_;
+                const auto connectGeneration = generation_;
+                lock.unlock();
+                auto *created = PQconnectdb(connectUrl.c_str());
+                if (!created || PQstatus(created) != CONNECTION_OK) {
+                    std::cerr << "[db-pool] Failed to connect to Postgres: "
+                              << (created ? PQerrorMessage(created) : "out of memory") << std::endl;
+                    if (created) PQfinish(created);
+                    lock.lock();
+                    --inUse_;
+                    --open_;
+                    ++connectFailures_;
+                    available_.notify_one();
+                    return false;
+                }
+                lock.lock();
+                ++connectionsCreated_;
+                lock.unlock();
+                recordCheckout(waited, waitStarted);
+                connection = created;
+                createdAt = Clock::now();
+                generation = connectGeneration;
+                return true;
+            }
+
+            waited = true;
+            ++waiting_;
+            const auto status = available_.wait_until(lock, deadline);
+            --waiting_;
+            if (status == std::cv_status::timeout && idle_.empty()
+                && open_ >= settings_.maxConnections) {
+                ++waits_;
+                ++waitTimeouts_;
+                recordWaitLocked(Clock::now() - waitStarted);
+                std::cerr << "[db-pool] timed out waiting for a connection after "
+                          << settings_.acquireTimeout.count() << "ms; open=" << open_
+                          << " waiting=" << waiting_ << std::endl;
+                return false;
+            }
+        }
+    }
+
+    void release(PGconn *connection,
+                 Clock::time_point createdAt,
+                 std::uint64_t generation,
+                 bool discard) {
+        const bool dirty = PQtransactionStatus(connection) != PQTRANS_IDLE;
+        const bool expired = Clock::now() - createdAt >= settings_.maxLifetime;
+        bool keep = !discard && !expired && restoreIdleSession(connection);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (dirty) ++dirtyReturns_;
+        if (expired) ++lifetimeRecycled_;
+        if (generation != generation_) keep = false;
+        --inUse_;
+        if (keep) {
+            idle_.push_back(IdleConnection{connection, createdAt, Clock::now()});
+        } else {
+            --open_;
+        }
+        lock.unlock();
+        available_.notify_one();
+        if (!keep) closeConnection(connection);
+    }
+
+    void drain() {
+        std::vector<PGconn *> stale;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            detachIdleLocked(stale);
+        }
+        closeAll(stale);
+        available_.notify_all();
+    }
+
+    PoolMetrics metrics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PoolMetrics metrics;
+        metrics.maxConnections = settings_.maxConnections;
+        metrics.open = open_;
+        metrics.idle = idle_.size();
+        metrics.inUse = inUse_;
+        metrics.waiting = waiting_;
+        metrics.checkouts = checkouts_;
+        metrics.connectionsCreated = connectionsCreated_;
+        metrics.connectFailures = connectFailures_;
+        metrics.lifetimeRecycled = lifetimeRecycled_;
+        metrics.healthCheckFailures = healthCheckFailures_;
+        metrics.dirtyReturns = dirtyReturns_;
+        metrics.waits = waits_;
+        metrics.waitTimeouts = waitTimeouts_;
+        metrics.totalWaitMicros = totalWaitMicros_;
+        metrics.maxWaitMicros = maxWaitMicros_;
+        return metrics;
+    }
+
+private:
+    // Idle connections past their lifetime are recycled, and ones that sat
+    // unused long enough for a proxy or server timeout get a round-trip probe
+    // before they are trusted with a request.
+    bool usable(const IdleConnection &candidate) {
+        const auto now = Clock::now();
+        if (now - candidate.createdAt >= settings_.maxLifetime) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++lifetimeRecycled_;
+            return false;
+        }
+        if (PQstatus(candidate.connection) != CONNECTION_OK
+            || (now - candidate.returnedAt >= settings_.healthCheckAfterIdle
+                && !connectionHealthy(candidate.connection))) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++healthCheckFailures_;
+            return false;
+        }
+        return true;
+    }
+
+    void recordCheckout(bool waited, Clock::time_point waitStarted) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++checkouts_;
+        if (waited) {
+            ++waits_;
+            recordWaitLocked(Clock::now() - waitStarted);
+        }
+    }
+
+    void recordWaitLocked(Clock::duration waited) {
+        const auto micros = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(waited).count());
+        totalWaitMicros_ += micros;
+        maxWaitMicros_ = std::max(maxWaitMicros_, micros);
+    }
+
+    void detachIdleLocked(std::vector<PGconn *> &stale) {
+        for (const auto &entry : idle_) stale.push_back(entry.connection);
+        open_ -= idle_.size();
+        idle_.clear();
+        ++generation_;
+    }
+
+    const PoolSettings settings_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::string url_;
+    std::uint64_t generation_{0};
+    std::vector<IdleConnection> idle_;
+    std::size_t open_{0};
+    std::size_t inUse_{0};
+    std::size_t waiting_{0};
+    std::uint64_t checkouts_{0};
+    std::uint64_t connectionsCreated_{0};
+    std::uint64_t connectFailures_{0};
+    std::uint64_t lifetimeRecycled_{0};
+    std::uint64_t healthCheckFailures_{0};
+    std::uint64_t dirtyReturns_{0};
+    std::uint64_t waits_{0};
+    std::uint64_t waitTimeouts_{0};
+    std::uint64_t totalWaitMicros_{0};
+    std::uint64_t maxWaitMicros_{0};
+};
+
+// Intentionally leaked: handles held by detached worker threads may be
+// released during static destruction.
+ConnectionPool &pool() {
+    static auto *instance = new ConnectionPool();
+    return *instance;
+}
+
+} // namespace
+
+PooledConnection::PooledConnection(PGconn *connection,
+                                   std::chrono::steady_clock::time_point createdAt,
+                                   std::uint64_t generation)
+    : connection_(connection), createdAt_(createdAt), generation_(generation) {}
+
+PooledConnection::~PooledConnection() {
+    reset();
+}
+
+PooledConnection::PooledConnection(PooledConnection &&other) noexcept
+    : connection_(std::exchange(other.connection_, nullptr)),
+      createdAt_(other.createdAt_),
+      generation_(other.generation_),
+      discard_(std::exchange(other.discard_, false)) {}
+
+PooledConnection &PooledConnection::operator=(PooledConnection &&other) noexcept {
+    if (this != &other) {
+        reset();
+        connection_ = std::exchange(other.connection_, nullptr);
+        createdAt_ = other.createdAt_;
+        generation_ = other.generation_;
+        discard_ = std::exchange(other.discard_, false);
+    }
+    return *this;
+}
+
+void PooledConnection::discard() {
+    discard_ = true;
+}
+
+void PooledConnection::reset() {
+    if (!connection_) return;
+    pool().release(connection_, createdAt_, generation_, discard_);
+    connection_ = nullptr;
+    discard_ = false;
+}
+
+PooledConnection acquireConnection() {
+    PGconn *connection = nullptr;
+    std::chrono::steady_clock::time_point createdAt{};
+    std::uint64_t generation = 0;
+    if (!pool().acquire(connection, createdAt, generation)) return nullptr;
+    return PooledConnection{connection, createdAt, generation};
+}
+
+PoolSettings poolSettings() {
+    return pool().settings();
+}
+
+PoolMetrics poolMetrics() {
+    return pool().metrics();
+}
+
+void drainPool() {
+    pool().drain();
+}
+
+} // namespace cff::db
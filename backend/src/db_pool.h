@@ -0,0 +1,83 @@
+#pragma once
+
+#include <postgresql/libpq-fe.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace cff::db {
+
+struct PoolSettings {
+    std::size_t maxConnections{16};
+    std::chrono::milliseconds acquireTimeout{5000};
+    std::chrono::seconds maxLifetime{1800};
+    std::chrono::seconds healthCheckAfterIdle{30};
+};
+
+struct PoolMetrics {
+    std::size_t maxConnections{0};
+    std::size_t open{0};
+    std::size_t idle{0};
+    std::size_t inUse{0};
+    std::size_t waiting{0};
+    std::uint64_t checkouts{0};
+    std::uint64_t connectionsCreated{0};
+    std::uint64_t connectFailures{0};
+    std::uint64_t lifetimeRecycled{0};
+    std::uint64_t healthCheckFailures{0};
+    std::uint64_t dirtyReturns{0};
+    std::uint64_t waits{0};
+    std::uint64_t waitTimeouts{0};
+    std::uint64_t totalWaitMicros{0};
+    std::uint64_t maxWaitMicros{0};
+};
+
+// A checked-out Postgres connection. The handle returns the connection to
+// the process-wide pool when it goes out of scope; an open transaction is
+// rolled back first and a broken connection is closed instead of reused.
+class PooledConnection {
+public:
+    PooledConnection() = default;
+    PooledConnection(std::nullptr_t) {}
+    ~PooledConnection();
+
+    PooledConnection(PooledConnection &&other) noexcept;
+    PooledConnection &operator=(PooledConnection &&other) noexcept;
+    PooledConnection(const PooledConnection &) = delete;
+    PooledConnection &operator=(const PooledConnection &) = delete;
+
+    PGconn *get() const { return connection_; }
+    explicit operator bool() const { return connection_ != nullptr; }
+
+    // Close the connection instead of returning it, e.g. after a protocol
+    // error that leaves the session state unknown.
+    void discard();
+    void reset();
+
+private:
+    friend PooledConnection acquireConnection();
+
+    PooledConnection(PGconn *connection,
+                     std::chrono::steady_clock::time_point createdAt,
+                     std::uint64_t generation);
+
+    PGconn *connection_{nullptr};
+    std::chrono::steady_clock::time_point createdAt_{};
+    std::uint64_t generation_{0};
+    bool discard_{false};
+};
+
+// Check out a connection to DB_URL. Returns an empty handle when DB_URL is
+// unset, the server is unreachable, or no connection frees up within the
+// configured acquire timeout.
+PooledConnection acquireConnection();
+
+PoolSettings poolSettings();
+PoolMetrics poolMetrics();
+
+// Close idle connections and detach checked-out ones so they are closed on
+// return. Used when DB_URL changes and by tests.
+void drainPool();
+
+} // namespace cff::db
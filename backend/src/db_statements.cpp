@@ -0,0 +1,399 @@
+#include "db_statements.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cff::db {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// SQLSTATE 26000: the server no longer knows the statement (DISCARD ALL,
+// DEALLOCATE, or a session reset by a proxy). 42P05: it already exists.
+constexpr std::string_view kUnknownStatement = "26000";
+constexpr std::string_view kDuplicateStatement = "42P05";
+
+// Keyed by name rather than descriptor: an .inc shared by several modules
+// declares the same statement once per translation unit, and preparing it a
+// second time inside a transaction would abort the transaction.
+struct PreparedSet {
+    int backendPid{0};
+    std::unordered_set<std::string> names;
+};
+
+struct ConnectionShard {
+    std::mutex mutex;
+    std::unordered_map<PGconn *, PreparedSet> connections;
+};
+
+constexpr std::size_t kShards = 16;
+
+std::array<ConnectionShard, kShards> &connectionShards() {
+    static std::array<ConnectionShard, kShards> shards;
+    return shards;
+}
+
+ConnectionShard &shardFor(PGconn *connection) {
+    return connectionShards()[std::hash<PGconn *>{}(connection) % kShards];
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<const Statement *> statements;
+    std::unordered_map<std::string, const Statement *> byName;
+};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+void registerStatement(const Statement &statement) {
+    if (statement.registered.load(std::memory_order_acquire)) return;
+    auto &shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (statement.registered.load(std::memory_order_relaxed)) return;
+    const auto [existing, inserted] = shared.byName.emplace(statement.name, &statement);
+    if (!inserted && std::strcmp(existing->second->sql, statement.sql) != 0) {
+        std::cerr << "[db-statements] statement name " << statement.name
+                  << " is declared twice with different SQL" << std::endl;
+    }
+    shared.statements.push_back(&statement);
+    statement.registered.store(true, std::memory_order_release);
+}
+
+// A pointer can be reused by a new connection after the old one closed
+// without passing through the pool; the backend pid tells them apart.
+bool isPrepared(PGconn *connection, const Statement &statement) {
+    auto &shard = shardFor(connection);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto &prepared = shard.connections[connection];
+    const auto pid = PQbackendPID(connection);
+    if (prepared.backendPid != pid) {
+        prepared.backendPid = pid;
+        prepared.names.clear();
+    }
+    return prepared.names.count(statement.name) > 0;
+}
+
+void markPrepared(PGconn *connection, const Statement &statement, bool prepared) {
+    auto &shard = shardFor(connection);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto &entry = shard.connections[connection];
+    if (prepared) {
+        entry.names.insert(statement.name);
+    } else {
+        entry.names.erase(statement.name);
+    }
+}
+
+bool hasSqlState(const PGresult *result, std::string_view state) {
+    if (!result) return false;
+    const char *value = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    return value && state == value;
+}
+
+// Whether the session already holds a statement under this name. Used inside
+// an open transaction, where a duplicate PQprepare would abort it.
+bool preparedOnServer(PGconn *connection, const Statement &statement) {
+    const char *values[] = {statement.name};
+    auto *result = PQexecParams(connection, "SELECT 1 FROM pg_prepared_statements WHERE name = $1",
+                                1, nullptr, values, nullptr, nullptr, 0);
+    const bool found = result && PQresultStatus(result) == PGRES_TUPLES_OK && PQntuples(result) > 0;
+    if (result) PQclear(result);
+    return found;
+}
+
+// Outside a transaction a duplicate (42P05) is harmless and means the name
+// is already usable. Inside one it would abort the transaction, so the
+// session's prepared statements are checked first; an aborted transaction
+// is left for the unprepared run to report.
+bool prepare(PGconn *connection, const Statement &statement) {
+    const auto transaction = PQtransactionStatus(connection);
+    if (transaction == PQTRANS_INERROR) return false;
+    const bool inTransaction = transaction != PQTRANS_IDLE;
+    bool ok = inTransaction && preparedOnServer(connection, statement);
+    if (!ok) {
+        auto *result = PQprepare(connection, statement.name, statement.sql,
+                                 statement.parameterCount, nullptr);
+        ok = result && (PQresultStatus(result) == PGRES_COMMAND_OK
+                        || (!inTransaction && hasSqlState(result, kDuplicateStatement)));
+        if (result) PQclear(result);
+    }
+    if (ok) {
+        statement.prepares.fetch_add(1, std::memory_order_relaxed);
+        markPrepared(connection, statement, true);
+    }
+    return ok;
+}
+
+PGresult *runPrepared(PGconn *connection,
+                      const Statement &statement,
+                      const std::vector<const char *> &values) {
+    return PQexecPrepared(connection,
+                          statement.name,
+                          static_cast<int>(values.size()),
+                          values.empty() ? nullptr : values.data(),
+                          nullptr,
+                          nullptr,
+                          static_cast<int>(statement.resultFormat));
+}
+
+PGresult *runUnprepared(PGconn *connection,
+                        const Statement &statement,
+                        const std::vector<const char *> &values) {
+    return PQexecParams(connection,
+                        statement.sql,
+                        static_cast<int>(values.size()),
+                        nullptr,
+                        values.empty() ? nullptr : values.data(),
+                        nullptr,
+                        nullptr,
+                        static_cast<int>(statement.resultFormat));
+}
+
+bool succeeded(const PGresult *result) {
+    if (!result) return false;
+    const auto status = PQresultStatus(result);
+    return status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK;
+}
+
+void record(const Statement &statement, Clock::duration elapsed, bool ok) {
+    const auto micros = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    statement.calls.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) statement.failures.fetch_add(1, std::memory_order_relaxed);
+    statement.totalMicros.fetch_add(micros, std::memory_order_relaxed);
+    auto previous = statement.maxMicros.load(std::memory_order_relaxed);
+    while (previous < micros
+           && !statement.maxMicros.compare_exchange_weak(previous, micros, std::memory_order_relaxed)) {
+    }
+}
+
+std::vector<const char *> parameterValues(const std::vector<std::string> &parameters) {
+    std::vector<const char *> values;
+    values.reserve(parameters.size());
+    for (const auto &parameter : parameters) values.push_back(parameter.c_str());
+    return values;
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+// The first result of the next queued command; the command's trailing NULL
+// is consumed.
+PGresult *nextCommandResult(PGconn *connection) {
+    auto *result = PQgetResult(connection);
+    if (!result) return nullptr;
+    while (auto *extra = PQgetResult(connection)) PQclear(extra);
+    return result;
+}
+
+// Reads up to and including the next sync.
+void consumeSync(PGconn *connection) {
+    while (auto *result = PQgetResult(connection)) {
+        const bool synced = PQresultStatus(result) == PGRES_PIPELINE_SYNC;
+        PQclear(result);
+        if (synced) break;
+    }
+}
+
+// Sends prepares for statements this connection has not seen, then every
+// query, with a sync after the prepares and after each query. Outside BEGIN
+// each sync ends an implicit transaction, so every query commits or fails on
+// its own, as it would through execPrepared(). Fills `results` with what the
+// server returned and leaves nullptr for queries whose statement was not
+// prepared or that could not be sent. Returns false when the connection
+// could not enter pipeline mode or flush the batch.
+bool runPipeline(PGconn *connection,
+                 const std::vector<PipelineQuery> &queries,
+                 std::vector<PGresult *> &results) {
+    if (PQpipelineStatus(connection) != PQ_PIPELINE_OFF) return false;
+    // Inside a transaction a duplicate prepare in the batch would abort it,
+    // so unknown statements are prepared one at a time first.
+    if (PQtransactionStatus(connection) != PQTRANS_IDLE) {
+        for (const auto &query : queries) {
+            if (!isPrepared(connection, query.statement) && !prepare(connection, query.statement)) return false;
+        }
+    }
+    if (!PQenterPipelineMode(connection)) return false;
+    const auto started = Clock::now();
+
+    std::vector<const Statement *> preparing;
+    std::unordered_set<std::string> named;
+    bool sent = true;
+    for (const auto &query : queries) {
+        if (isPrepared(connection, query.statement) || !named.insert(query.statement.name).second) continue;
+        if (!PQsendPrepare(connection, query.statement.name, query.statement.sql,
+                           query.statement.parameterCount, nullptr)) {
+            sent = false;
+            break;
+        }
+        preparing.push_back(&query.statement);
+    }
+    bool synced = preparing.empty() || PQpipelineSync(connection);
+    std::size_t queued = 0;
+    for (; sent && synced && queued < queries.size(); ++queued) {
+        const auto &query = queries[queued];
+        const auto values = parameterValues(query.parameters);
+        if (!PQsendQueryPrepared(connection, query.statement.name, static_cast<int>(values.size()),
+                                 values.empty() ? nullptr : values.data(), nullptr, nullptr,
+                                 static_cast<int>(query.statement.resultFormat))) {
+            break;
+        }
+        synced = PQpipelineSync(connection);
+    }
+    if (!synced) {
+        PQexitPipelineMode(connection);
+        return false;
+    }
+
+    for (const auto *statement : preparing) {
+        auto *result = nextCommandResult(connection);
+        if (result && (PQresultStatus(result) == PGRES_COMMAND_OK || hasSqlState(result, kDuplicateStatement))) {
+            statement->prepares.fetch_add(1, std::memory_order_relaxed);
+            markPrepared(connection, *statement, true);
+        }
+        if (result) PQclear(result);
+    }
+    if (!preparing.empty()) consumeSync(connection);
+    for (std::size_t index = 0; index < queued; ++index) {
+        const auto &statement = queries[index].statement;
+        auto *result = nextCommandResult(connection);
+        consumeSync(connection);
+        if (!result || PQresultStatus(result) == PGRES_PIPELINE_ABORTED
+            || hasSqlState(result, kUnknownStatement)) {
+            if (hasSqlState(result, kUnknownStatement)) markPrepared(connection, statement, false);
+            if (result) PQclear(result);
+            continue;
+        }
+        record(statement, Clock::now() - started, succeeded(result));
+        results[index] = result;
+    }
+    PQexitPipelineMode(connection);
+    return true;
+}
+#endif
+
+} // namespace
+
+PGresult *execPrepared(PGconn *connection,
+                       const Statement &statement,
+                       const std::vector<std::string> &parameters) {
+    registerStatement(statement);
+    const auto started = Clock::now();
+    if (!connection) {
+        record(statement, Clock::now() - started, false);
+        return nullptr;
+    }
+
+    const auto values = parameterValues(parameters);
+    if (static_cast<int>(values.size()) != statement.parameterCount) {
+        std::cerr << "[db-statements] " << statement.name << " expects " << statement.parameterCount
+                  << " parameter(s), got " << values.size() << std::endl;
+        auto *result = runUnprepared(connection, statement, values);
+        record(statement, Clock::now() - started, succeeded(result));
+        return result;
+    }
+
+    if (!isPrepared(connection, statement) && !prepare(connection, statement)) {
+        auto *result = runUnprepared(connection, statement, values);
+        record(statement, Clock::now() - started, succeeded(result));
+        return result;
+    }
+
+    auto *result = runPrepared(connection, statement, values);
+    if (hasSqlState(result, kUnknownStatement)) {
+        markPrepared(connection, statement, false);
+        // Outside a transaction nothing was aborted, so prepare and retry.
+        if (PQtransactionStatus(connection) == PQTRANS_IDLE && prepare(connection, statement)) {
+            PQclear(result);
+            result = runPrepared(connection, statement, values);
+        }
+    }
+    record(statement, Clock::now() - started, succeeded(result));
+    return result;
+}
+
+std::vector<PGresult *> execPipeline(PGconn *connection, const std::vector<PipelineQuery> &queries) {
+    std::vector<PGresult *> results(queries.size(), nullptr);
+    bool pipelined = connection && queries.size() > 1;
+    for (const auto &query : queries) {
+        registerStatement(query.statement);
+        if (static_cast<int>(query.parameters.size()) != query.statement.parameterCount) pipelined = false;
+    }
+#ifdef LIBPQ_HAS_PIPELINING
+    // Queries left without a result, and every query when the batch could
+    // not be sent, fall through to one-at-a-time execution.
+    if (pipelined) (void)runPipeline(connection, queries, results);
+#else
+    (void)pipelined;
+#endif
+    for (std::size_t index = 0; index < queries.size(); ++index) {
+        if (!results[index]) results[index] = execPrepared(connection, queries[index].statement, queries[index].parameters);
+    }
+    return results;
+}
+
+long long integerValue(const PGresult *result, int row, int column, long long fallback) {
+    if (!result || PQgetisnull(result, row, column)) return fallback;
+    const char *value = PQgetvalue(result, row, column);
+    if (PQfformat(result, column) == 0) {
+        char *end = nullptr;
+        const auto parsed = std::strtoll(value, &end, 10);
+        return end == value ? fallback : parsed;
+    }
+    const auto length = PQgetlength(result, row, column);
+    if (length != 2 && length != 4 && length != 8) return fallback;
+    std::uint64_t bits = 0;
+    for (int index = 0; index < length; ++index) {
+        bits = (bits << 8) | static_cast<unsigned char>(value[index]);
+    }
+    // Sign-extend int2 and int4.
+    const int shift = 64 - 8 * length;
+    return static_cast<long long>(bits << shift) >> shift;
+}
+
+void forgetConnection(PGconn *connection) {
+    if (!connection) return;
+    auto &shard = shardFor(connection);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.connections.erase(connection);
+}
+
+// Same-named descriptors from different translation units report together.
+std::vector<StatementMetrics> statementMetrics() {
+    std::vector<StatementMetrics> metrics;
+    {
+        auto &shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        std::unordered_map<std::string, std::size_t> index;
+        for (const auto *statement : shared.statements) {
+            const auto [slot, inserted] = index.emplace(statement->name, metrics.size());
+            if (inserted) {
+                metrics.emplace_back();
+                metrics.back().name = statement->name;
+            }
+            auto &entry = metrics[slot->second];
+            entry.calls += statement->calls.load(std::memory_order_relaxed);
+            entry.failures += statement->failures.load(std::memory_order_relaxed);
+            entry.prepares += statement->prepares.load(std::memory_order_relaxed);
+            entry.totalMicros += statement->totalMicros.load(std::memory_order_relaxed);
+            entry.maxMicros = std::max(entry.maxMicros, statement->maxMicros.load(std::memory_order_relaxed));
+        }
+    }
+    std::sort(metrics.begin(), metrics.end(), [](const StatementMetrics &left, const StatementMetrics &right) {
+        return left.totalMicros != right.totalMicros ? left.totalMicros > right.totalMicros
+                                                     : left.name < right.name;
+    });
+    return metrics;
+}
+
+} // namespace cff::db
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <postgresql/libpq-fe.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cff::db {
+
+enum class ResultFormat { Text = 0, Binary = 1 };
+
+// A named statement declared once, at namespace scope, by the module that
+// runs it. The first execution on a pooled connection PQprepares it under
+// `name`; later ones send only the name and parameters, so Postgres skips
+// parsing and, after a few runs, planning. Names are global per connection:
+// prefix them with the module ("draft.state_for_update").
+//
+// Parameters travel as text. Cast them in the SQL ($2::int), which also fixes
+// their types when the statement is prepared. Binary results send integers
+// as network-order bytes and text as-is; read integer columns through
+// integerValue(), and keep booleans on text statements.
+struct Statement {
+    const char *name;
+    const char *sql;
+    int parameterCount;
+    ResultFormat resultFormat{ResultFormat::Text};
+
+    // Per-statement counters, reported by statementMetrics().
+    mutable std::atomic<std::uint64_t> calls{0};
+    mutable std::atomic<std::uint64_t> failures{0};
+    mutable std::atomic<std::uint64_t> prepares{0};
+    mutable std::atomic<std::uint64_t> totalMicros{0};
+    mutable std::atomic<std::uint64_t> maxMicros{0};
+    mutable std::atomic<bool> registered{false};
+};
+
+struct StatementMetrics {
+    std::string name;
+    std::uint64_t calls{0};
+    std::uint64_t failures{0};
+    std::uint64_t prepares{0};
+    std::uint64_t totalMicros{0};
+    std::uint64_t maxMicros{0};
+};
+
+// Same contract as PQexecParams: the caller owns the result, and a null
+// connection yields nullptr. A statement that cannot be prepared (for example
+// inside an aborted transaction) runs unprepared so the caller sees the
+// server's own error.
+PGresult *execPrepared(PGconn *connection,
+                       const Statement &statement,
+                       const std::vector<std::string> &parameters = {});
+
+struct PipelineQuery {
+    const Statement &statement;
+    std::vector<std::string> parameters;
+};
+
+// Runs independent statements in one round trip using libpq pipeline mode:
+// every query is sent, then the results are read back in order, one per
+// query, each owned by the caller. Later queries see earlier queries' writes.
+// Every query is synced on its own, so outside BEGIN each one commits or
+// fails by itself exactly as through execPrepared(), and a failure never
+// undoes an earlier query reported as successful. Queries whose statement
+// could not be prepared are rerun one at a time. Without pipeline support,
+// or when the connection is already busy, every query runs through
+// execPrepared().
+// Keep batches to a handful of short statements: the connection stays in
+// blocking mode, so a batch must fit in the socket buffers.
+std::vector<PGresult *> execPipeline(PGconn *connection, const std::vector<PipelineQuery> &queries);
+
+// Integer column from a text or binary result; `fallback` for NULL or
+// unparseable values.
+long long integerValue(const PGresult *result, int row, int column, long long fallback = 0);
+
+// Drop what is known about a connection's prepared statements. The pool
+// calls this before closing a connection.
+void forgetConnection(PGconn *connection);
+
+// Every statement executed so far, slowest total first.
+std::vector<StatementMetrics> statementMetrics();
+
+} // namespace cff::db
@@ -0,0 +1,181 @@
+#include "draft_clock.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace cff::draft_clock {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, std::size_t slots, Clock::time_point origin)
+    : tick_(std::max(tick, std::chrono::milliseconds{1})),
+      origin_(origin),
+      slots_(std::max<std::size_t>(1, slots)) {}
+
+std::int64_t TimerWheel::tickFor(Clock::time_point time) const {
+    if (time <= origin_) return 0;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time - origin_).count() / tick_.count();
+}
+
+bool TimerWheel::live(const Entry &entry) const {
+    const auto it = index_.find(entry.key);
+    return it != index_.end() && it->second.generation == entry.generation;
+}
+
+void TimerWheel::schedule(const std::string &key, Clock::time_point due) {
+    const auto generation = ++generation_;
+    index_[key] = Scheduled{due, generation};
+    const auto tick = std::max(tickFor(due), cursor_);
+    slots_[static_cast<std::size_t>(tick) % slots_.size()].push_back(Entry{key, due, generation});
+}
+
+void TimerWheel::cancel(const std::string &key) {
+    index_.erase(key);
+}
+
+bool TimerWheel::scheduled(const std::string &key) const {
+    return index_.find(key) != index_.end();
+}
+
+std::vector<std::string> TimerWheel::advance(Clock::time_point now) {
+    std::vector<std::string> due;
+    const auto target = tickFor(now);
+    const auto steps = std::min<std::int64_t>(target - cursor_, static_cast<std::int64_t>(slots_.size()) - 1);
+    for (std::int64_t step = 0; step <= std::max<std::int64_t>(steps, 0); ++step) {
+        auto &slot = slots_[static_cast<std::size_t>(cursor_ + step) % slots_.size()];
+        auto keep = slot.begin();
+        for (auto &entry : slot) {
+            if (!live(entry)) continue;
+            if (entry.due <= now) {
+                index_.erase(entry.key);
+                due.push_back(std::move(entry.key));
+                continue;
+            }
+            if (&*keep != &entry) *keep = std::move(entry);
+            ++keep;
+        }
+        slot.erase(keep, slot.end());
+    }
+    cursor_ = std::max(cursor_, target);
+    return due;
+}
+
+std::optional<Clock::time_point> TimerWheel::nextWake() const {
+    if (index_.empty()) return std::nullopt;
+    const auto rotationEnd = origin_ + tick_ * (cursor_ + static_cast<std::int64_t>(slots_.size()));
+    for (std::size_t step = 0; step < slots_.size(); ++step) {
+        const auto &slot = slots_[static_cast<std::size_t>(cursor_ + static_cast<std::int64_t>(step)) % slots_.size()];
+        std::optional<Clock::time_point> earliest;
+        for (const auto &entry : slot) {
+            if (!live(entry) || entry.due >= rotationEnd) continue;
+            if (!earliest || entry.due < *earliest) earliest = entry.due;
+        }
+        if (earliest) return earliest;
+    }
+    return rotationEnd;
+}
+
+namespace {
+
+class DraftClock {
+public:
+    void setHandler(std::function<void(const std::string &)> handler) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handler_ = std::move(handler);
+    }
+
+    void arm(const std::string &leagueId, Clock::time_point due) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            startLocked();
+            wheel_.schedule(leagueId, due);
+        }
+        wake_.notify_one();
+    }
+
+    void disarm(const std::string &leagueId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wheel_.cancel(leagueId);
+    }
+
+    bool armed(const std::string &leagueId) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return wheel_.scheduled(leagueId);
+    }
+
+    ClockMetrics metrics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ClockMetrics{wheel_.size(), fired_};
+    }
+
+private:
+    void startLocked() {
+        if (started_) return;
+        started_ = true;
+        std::thread([this] { run(); }).detach();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            if (const auto next = wheel_.nextWake()) {
+                wake_.wait_until(lock, *next);
+            } else {
+                wake_.wait(lock);
+            }
+            auto due = wheel_.advance(Clock::now());
+            if (due.empty()) continue;
+            fired_ += due.size();
+            const auto handler = handler_;
+            lock.unlock();
+            for (const auto &leagueId : due) {
+                if (!handler) continue;
+                try {
+                    handler(leagueId);
+                } catch (const std::exception &error) {
+                    std::cerr << "[draft-clock] handler failed for " << leagueId << ": " << error.what() << std::endl;
+                }
+            }
+            lock.lock();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    TimerWheel wheel_{std::chrono::milliseconds{250}, 512, Clock::now()};
+    std::function<void(const std::string &)> handler_;
+    std::uint64_t fired_{0};
+    bool started_{false};
+};
+
+DraftClock &draftClock() {
+    static auto *clock = new DraftClock();
+    return *clock;
+}
+
+} // namespace
+
+void setDueHandler(std::function<void(const std::string &leagueId)> handler) {
+    draftClock().setHandler(std::move(handler));
+}
+
+void arm(const std::string &leagueId, Clock::time_point due) {
+    draftClock().arm(leagueId, due);
+}
+
+void disarm(const std::string &leagueId) {
+    draftClock().disarm(leagueId);
+}
+
+bool armed(const std::string &leagueId) {
+    return draftClock().armed(leagueId);
+}
+
+ClockMetrics clockMetrics() {
+    return draftClock().metrics();
+}
+
+} // namespace cff::draft_clock
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cff::draft_clock {
+
+using Clock = std::chrono::steady_clock;
+
+// Hashed timer wheel keyed by league id. Each league holds at most one
+// deadline; scheduling again replaces it. Deadlines further out than one
+// rotation stay in their slot until the wheel comes round to them.
+class TimerWheel {
+public:
+    TimerWheel(std::chrono::milliseconds tick, std::size_t slots, Clock::time_point origin);
+
+    void schedule(const std::string &key, Clock::time_point due);
+    void cancel(const std::string &key);
+    bool scheduled(const std::string &key) const;
+    std::size_t size() const { return index_.size(); }
+
+    // Removes and returns every key whose deadline is at or before `now`.
+    std::vector<std::string> advance(Clock::time_point now);
+
+    // Earliest deadline within the current rotation, or the end of the
+    // rotation when only later deadlines are pending.
+    std::optional<Clock::time_point> nextWake() const;
+
+private:
+    struct Entry {
+        std::string key;
+        Clock::time_point due;
+        std::uint64_t generation{0};
+    };
+
+    struct Scheduled {
+        Clock::time_point due;
+        std::uint64_t generation{0};
+    };
+
+    std::int64_t tickFor(Clock::time_point time) const;
+    bool live(const Entry &entry) const;
+
+    std::chrono::milliseconds tick_;
+    Clock::time_point origin_;
+    std::int64_t cursor_{0};
+    std::uint64_t generation_{0};
+    std::vector<std::vector<Entry>> slots_;
+    std::unordered_map<std::string, Scheduled> index_;
+};
+
+struct ClockMetrics {
+    std::size_t armed{0};
+    std::uint64_t fired{0};
+};
+
+// Process-wide draft clock. The handler runs on the clock thread and must
+// only hand work off (e.g. to the DB executor); it must not block.
+void setDueHandler(std::function<void(const std::string &leagueId)> handler);
+void arm(const std::string &leagueId, Clock::time_point due);
+void disarm(const std::string &leagueId);
+bool armed(const std::string &leagueId);
+ClockMetrics clockMetrics();
+
+} // namespace cff::draft_clock
@@ -3,8 +3,11 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstdlib>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -13,13 +16,23 @@
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
+#include <drogon/WebSocketController.h>
 #include <postgresql/libpq-fe.h>
+
+#include "auth_session_store.h"
+#include "db_executor.h"
+#include "db_pool.h"
+#include "db_statements.h"
+#include "draft_room_hub.h"
 #endif
 
 #include "app_config.h"
+#include "draft_clock.h"
 #include "draft_lifecycle.h"
 #include "http_security.h"
+#include "league_access_cache.h"
 #include "league_roster.h"
+#include "route_dispatch.h"
 
 namespace {
 
@@ -95,20 +108,14 @@ std::optional<std::string> accountEmail(const drogon::HttpRequestPtr &request) {
     return cff::draft_lifecycle::canonicalEmail(*email);
 }
 
-std::string pathLeagueId(const std::string &path, const std::string &suffix) {
-    const std::string prefix = "/api/leagues/";
-    if (path.rfind(prefix, 0) != 0 || suffix.empty()) return "";
-    if (path.size() <= prefix.size() + suffix.size()) return "";
-    if (path.substr(path.size() - suffix.size()) != suffix) return "";
-    return path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
-}
-
 #ifdef CFF_HAS_POSTGRES
 #include "draft_lifecycle_hardening_db.inc"
 std::unordered_map<std::string, int> rosterCounts(PGconn *connection,
                                                    const std::string &leagueId,
                                                    const std::string &email);
 #include "draft_lifecycle_hardening_auto.inc"
+#include "draft_lifecycle_hardening_room.inc"
+#include "draft_lifecycle_hardening_clock.inc"
 #include "draft_lifecycle_hardening_payload.inc"
 #include "draft_lifecycle_hardening_commissioner.inc"
 #include "draft_lifecycle_hardening_pick.inc"
@@ -118,3 +125,7 @@ std::unordered_map<std::string, int> rosterCounts(PGconn *connection,
 #include "draft_lifecycle_hardening_advice.inc"
 
 } // namespace
+
+#ifdef CFF_HAS_POSTGRES
+#include "draft_lifecycle_hardening_socket.inc"
+#endif
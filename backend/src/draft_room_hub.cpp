@@ -0,0 +1,118 @@
+#include "draft_room_hub.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace cff::draft_room {
+namespace {
+
+std::string encode(const Json::Value &value) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, value);
+}
+
+} // namespace
+
+DraftRoomHub::DraftRoomHub(std::size_t backlog) : backlog_(std::max<std::size_t>(1, backlog)) {}
+
+std::shared_ptr<std::mutex> DraftRoomHub::sendMutexFor(const std::string &leagueId, bool create) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (create) return rooms_[leagueId].sendMutex;
+    const auto room = rooms_.find(leagueId);
+    return room == rooms_.end() ? nullptr : room->second.sendMutex;
+}
+
+std::uint64_t DraftRoomHub::subscribe(const std::string &leagueId, std::uint64_t sinceSequence, Sink sink) {
+    for (;;) {
+        const auto sendMutex = sendMutexFor(leagueId, true);
+        std::lock_guard<std::mutex> sending(*sendMutex);
+        std::vector<std::string> replay;
+        std::uint64_t id = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &room = rooms_[leagueId];
+            // The room emptied and was recreated while we waited; lock the new one.
+            if (room.sendMutex != sendMutex) continue;
+            id = ++nextSubscription_;
+            room.sinks.emplace(id, sink);
+
+            Json::Value hello(Json::objectValue);
+            hello["type"] = "subscribed";
+            hello["leagueId"] = leagueId;
+            hello["sequence"] = Json::UInt64(room.sequence);
+            hello["version"] = Json::Int64(room.version);
+            const bool gap = sinceSequence > 0 && sinceSequence < room.sequence
+                && (room.backlog.empty() || room.backlog.front().first > sinceSequence + 1);
+            if (sinceSequence > room.sequence || gap) {
+                hello["resync"] = true;
+            } else if (sinceSequence > 0) {
+                for (const auto &[sequence, message] : room.backlog) {
+                    if (sequence > sinceSequence) replay.push_back(message);
+                }
+            }
+            replay.insert(replay.begin(), encode(hello));
+        }
+        // Still under the send lock: publish cannot deliver the next delta
+        // to this sink until the hello and replay are out.
+        for (const auto &message : replay) sink(message);
+        return id;
+    }
+}
+
+void DraftRoomHub::unsubscribe(const std::string &leagueId, std::uint64_t subscriptionId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto room = rooms_.find(leagueId);
+    if (room == rooms_.end()) return;
+    room->second.sinks.erase(subscriptionId);
+    if (room->second.sinks.empty()) rooms_.erase(room);
+}
+
+void DraftRoomHub::publish(const std::string &leagueId, const std::string &type, long long version, Json::Value data) {
+    const auto sendMutex = sendMutexFor(leagueId, false);
+    if (!sendMutex) return;
+    std::lock_guard<std::mutex> sending(*sendMutex);
+    std::vector<Sink> sinks;
+    std::string message;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto found = rooms_.find(leagueId);
+        if (found == rooms_.end() || found->second.sendMutex != sendMutex) return;
+        auto &room = found->second;
+        if (version < room.version) return;
+        room.version = version;
+
+        Json::Value delta(Json::objectValue);
+        delta["type"] = type;
+        delta["leagueId"] = leagueId;
+        delta["sequence"] = Json::UInt64(++room.sequence);
+        delta["version"] = Json::Int64(version);
+        delta["data"] = std::move(data);
+        message = encode(delta);
+
+        room.backlog.emplace_back(room.sequence, message);
+        while (room.backlog.size() > backlog_) room.backlog.pop_front();
+        sinks.reserve(room.sinks.size());
+        for (const auto &[id, sink] : room.sinks) sinks.push_back(sink);
+    }
+    for (const auto &sink : sinks) sink(message);
+}
+
+std::size_t DraftRoomHub::subscribers(const std::string &leagueId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto room = rooms_.find(leagueId);
+    return room == rooms_.end() ? 0 : room->second.sinks.size();
+}
+
+std::size_t DraftRoomHub::rooms() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rooms_.size();
+}
+
+DraftRoomHub &draftRoomHub() {
+    static auto *hub = new DraftRoomHub();
+    return *hub;
+}
+
+} // namespace cff::draft_room
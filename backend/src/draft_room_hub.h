@@ -0,0 +1,59 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cff::draft_room {
+
+// Fan-out of draft room deltas to subscribed sockets. Every delta carries the
+// draft_states.version it was read at and a per-room sequence number; a
+// client that reconnects with its last sequence gets the missed deltas
+// replayed, or a "resync" message when they have aged out of the backlog.
+// Sends to a room are serialised by its send lock, taken before the hub lock,
+// so a subscriber's hello and replay always precede the next live delta.
+class DraftRoomHub {
+public:
+    using Sink = std::function<void(const std::string &message)>;
+
+    explicit DraftRoomHub(std::size_t backlog = 64);
+
+    // Returns a subscription id for unsubscribe(). Missed deltas after
+    // `sinceSequence` (0 for none) are delivered before this returns.
+    std::uint64_t subscribe(const std::string &leagueId, std::uint64_t sinceSequence, Sink sink);
+    void unsubscribe(const std::string &leagueId, std::uint64_t subscriptionId);
+
+    // Deltas read at a version older than one already published are dropped,
+    // so a slow writer cannot roll clients back.
+    void publish(const std::string &leagueId, const std::string &type, long long version, Json::Value data);
+
+    std::size_t subscribers(const std::string &leagueId) const;
+    std::size_t rooms() const;
+
+private:
+    struct Room {
+        std::shared_ptr<std::mutex> sendMutex{std::make_shared<std::mutex>()};
+        std::uint64_t sequence{0};
+        long long version{0};
+        std::deque<std::pair<std::uint64_t, std::string>> backlog;
+        std::unordered_map<std::uint64_t, Sink> sinks;
+    };
+
+    std::shared_ptr<std::mutex> sendMutexFor(const std::string &leagueId, bool create);
+
+    std::size_t backlog_;
+    std::uint64_t nextSubscription_{0};
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Room> rooms_;
+};
+
+DraftRoomHub &draftRoomHub();
+
+} // namespace cff::draft_room
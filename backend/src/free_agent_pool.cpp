@@ -0,0 +1,133 @@
+#include "free_agent_pool.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+#ifdef CFF_HAS_POSTGRES
+#include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
+#endif
+
+namespace cff::free_agent_pool {
+namespace {
+
+#ifdef CFF_HAS_POSTGRES
+struct PgResultDeleter {
+    void operator()(PGresult *result) const {
+        if (result) PQclear(result);
+    }
+};
+
+using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
+
+PgResultPtr execParams(PGconn *connection, const char *sql, const std::string &leagueId) {
+    const char *values[] = {leagueId.c_str()};
+    return PgResultPtr{PQexecParams(connection, sql, 1, nullptr, values, nullptr, nullptr, 0)};
+}
+
+bool tuplesOk(PGresult *result) {
+    return result && PQresultStatus(result) == PGRES_TUPLES_OK;
+}
+#endif
+
+} // namespace
+
+void FreeAgentPool::store(const std::string &leagueId, std::int64_t version, std::vector<std::string> playerIds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = leagues_.find(leagueId);
+    if (found != leagues_.end() && found->second.version > version) return;
+    auto &league = leagues_[leagueId];
+    league.version = version;
+    league.playerIds = std::move(playerIds);
+    league.index.reset();
+    league.rostered.reset();
+}
+
+std::optional<std::int64_t> FreeAgentPool::version(const std::string &leagueId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = leagues_.find(leagueId);
+    if (found == leagues_.end()) return std::nullopt;
+    return found->second.version;
+}
+
+std::optional<std::vector<PlayerCard>> FreeAgentPool::freeAgents(
+    const std::string &leagueId,
+    const std::shared_ptr<const player_search_index::PlayerSearchIndex> &index,
+    player_search_index::Query query) {
+    if (!index) return std::nullopt;
+    std::shared_ptr<const player_search_index::Bitmap> rostered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto found = leagues_.find(leagueId);
+        if (found == leagues_.end()) return std::nullopt;
+        auto &league = found->second;
+        // Ordinals belong to one index build; remap after a catalog swap.
+        if (league.index != index || !league.rostered) {
+            league.rostered = std::make_shared<const player_search_index::Bitmap>(index->bitmapOf(league.playerIds));
+            league.index = index;
+        }
+        rostered = league.rostered;
+    }
+    query.excluded = rostered.get();
+    return index->search(query);
+}
+
+FreeAgentPool &freeAgentPool() {
+    static FreeAgentPool pool;
+    return pool;
+}
+
+#ifdef CFF_HAS_POSTGRES
+std::optional<std::vector<PlayerCard>> leagueFreeAgents(PGconn *connection,
+                                                        const std::string &leagueId,
+                                                        player_search_index::Query query) {
+    query.fantasyPositionsOnly = true;
+    const auto index = playerSearchIndex();
+    if (!index || !connection) return std::nullopt;
+
+    auto &pool = freeAgentPool();
+    auto probe = execParams(connection,
+        "SELECT COALESCE(MAX(version), 0) FROM league_roster_versions WHERE league_id = $1", leagueId);
+    if (!tuplesOk(probe.get()) || PQntuples(probe.get()) == 0) return std::nullopt;
+    const auto current = std::atoll(PQgetvalue(probe.get(), 0, 0));
+
+    if (pool.version(leagueId) != current) {
+        // Version and roster come from one statement, so they share a snapshot.
+        auto roster = execParams(connection,
+            "SELECT versions.version, COALESCE(r.player_id, '') "
+            "FROM (SELECT COALESCE(MAX(version), 0) AS version FROM league_roster_versions "
+            "WHERE league_id = $1) AS versions "
+            "LEFT JOIN rosters r ON r.league_id = $1",
+            leagueId);
+        if (!tuplesOk(roster.get()) || PQntuples(roster.get()) == 0) {
+            std::cerr << "[free-agents] Roster load failed: " << PQerrorMessage(connection) << std::endl;
+            return std::nullopt;
+        }
+        std::vector<std::string> playerIds;
+        playerIds.reserve(static_cast<std::size_t>(PQntuples(roster.get())));
+        for (int row = 0; row < PQntuples(roster.get()); ++row) {
+            if (*PQgetvalue(roster.get(), row, 1)) playerIds.emplace_back(PQgetvalue(roster.get(), row, 1));
+        }
+        pool.store(leagueId, std::atoll(PQgetvalue(roster.get(), 0, 0)), std::move(playerIds));
+    }
+    return pool.freeAgents(leagueId, index, std::move(query));
+}
+#endif
+
+std::optional<std::vector<PlayerCard>> leagueFreeAgents(const std::string &leagueId,
+                                                        player_search_index::Query query) {
+#ifdef CFF_HAS_POSTGRES
+    if (!playerSearchIndex() || !std::getenv("DB_URL")) return std::nullopt;
+    auto connection = cff::db::acquireConnection();
+    if (!connection) return std::nullopt;
+    return leagueFreeAgents(connection.get(), leagueId, std::move(query));
+#else
+    (void)leagueId;
+    (void)query;
+    return std::nullopt;
+#endif
+}
+
+} // namespace cff::free_agent_pool
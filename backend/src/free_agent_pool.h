@@ -0,0 +1,68 @@
+#pragma once
+
+#include "player_catalog.h"
+#include "player_search_index.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef CFF_HAS_POSTGRES
+#include <postgresql/libpq-fe.h>
+#endif
+
+namespace cff::free_agent_pool {
+
+// Per-league rostered players, kept as ids plus a bitmap over the current
+// player search index, so a free-agent page is an index walk that skips the
+// league's bits. Each league's entry carries the roster version it was loaded
+// at (league_roster_versions, bumped by a trigger on every roster insert or
+// delete), and a newer version replaces it.
+class FreeAgentPool {
+public:
+    // Installs the league's rostered ids unless a newer version is cached.
+    void store(const std::string &leagueId, std::int64_t version, std::vector<std::string> playerIds);
+
+    // Cached roster version, or nullopt when the league is not loaded.
+    std::optional<std::int64_t> version(const std::string &leagueId) const;
+
+    // Free agents of a cached league from `index` (the league's bitmap is
+    // rebuilt when the index was swapped since); nullopt when not cached.
+    std::optional<std::vector<PlayerCard>> freeAgents(
+        const std::string &leagueId,
+        const std::shared_ptr<const player_search_index::PlayerSearchIndex> &index,
+        player_search_index::Query query);
+
+private:
+    struct League {
+        std::int64_t version{0};
+        std::vector<std::string> playerIds;
+        std::shared_ptr<const player_search_index::PlayerSearchIndex> index;
+        std::shared_ptr<const player_search_index::Bitmap> rostered;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, League> leagues_;
+};
+
+FreeAgentPool &freeAgentPool();
+
+// Fantasy-eligible (QB/RB/WR/TE/K) active players nobody in the league has
+// rostered, in catalog rank order. Costs one primary-key version read while
+// the league's cached roster is current. nullopt when the catalog index or
+// the database is unavailable; callers fall back to SQL.
+std::optional<std::vector<PlayerCard>> leagueFreeAgents(const std::string &leagueId,
+                                                        player_search_index::Query query);
+
+#ifdef CFF_HAS_POSTGRES
+// Same, reading versions on a connection the caller already holds.
+std::optional<std::vector<PlayerCard>> leagueFreeAgents(PGconn *connection,
+                                                        const std::string &leagueId,
+                                                        player_search_index::Query query);
+#endif
+
+} // namespace cff::free_agent_pool
@@ -22,13 +22,18 @@
 #include <json/json.h>
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+#include "../db_pool.h"
+#include "../db_statements.h"
+#include "../free_agent_pool.h"
 #endif
 #include "../json_utils.h"
+#include "../league_access_cache.h"
 #include "../league_models.h"
 #include "../league_schedule.h"
 #include "../league_roster.h"
 #include "../league_waiver.h"
 #include "../league_trade.h"
+#include "../scoring_lifecycle.h"
 
 namespace cff::handlers {
 
@@ -207,14 +212,6 @@ bool lineupLockedLocked(const std::string &leagueId) {
 }
 
 #ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *conn) const {
-        if (conn) {
-            PQfinish(conn);
-        }
-    }
-};
-
 struct PgResultDeleter {
     void operator()(PGresult *res) const {
         if (res) {
@@ -223,7 +220,7 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 
 bool draftOrderMatchesMembers(PGconn *conn,
@@ -236,16 +233,7 @@ bool dbConfigured() {
 }
 
 PgConnPtr connectToDb() {
-    const auto *url = std::getenv("DB_URL");
-    if (!url) {
-        return nullptr;
-    }
-    auto conn = PgConnPtr{PQconnectdb(url)};
-    if (PQstatus(conn.get()) != CONNECTION_OK) {
-        std::cerr << "[leagues] Failed to connect to Postgres: " << PQerrorMessage(conn.get()) << std::endl;
-        return nullptr;
-    }
-    return conn;
+    return cff::db::acquireConnection();
 }
 
 PgResultPtr execParams(PGconn *conn,
@@ -270,6 +258,13 @@ bool resultOk(PGresult *result, ExecStatusType expected) {
     return result && PQresultStatus(result) == expected;
 }
 
+std::vector<PgResultPtr> execPipeline(PGconn *conn, const std::vector<cff::db::PipelineQuery> &queries) {
+    std::vector<PgResultPtr> results;
+    results.reserve(queries.size());
+    for (auto *result : cff::db::execPipeline(conn, queries)) results.emplace_back(result);
+    return results;
+}
+
 std::string cell(PGresult *result, int row, int col) {
     if (PQgetisnull(result, row, col)) {
         return "";
@@ -388,46 +383,62 @@ std::string leagueSelectSql(const std::string &whereClause) {
            "FROM leagues " + whereClause;
 }
 
-std::optional<Json::Value> dbGetLeague(const std::string &accountEmail, const std::string &leagueId) {
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    auto result = execParams(conn.get(),
+std::optional<Json::Value> dbGetLeague(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    auto result = execParams(conn,
                              leagueSelectSql("WHERE id = $2 AND (account_email = $1 OR EXISTS (SELECT 1 FROM league_members WHERE league_id = leagues.id AND email = $1 AND status = 'active'))"),
                              {accountEmail, leagueId});
     if (!resultOk(result.get(), PGRES_TUPLES_OK) || PQntuples(result.get()) == 0) {
         return std::nullopt;
     }
     auto league = leagueJsonFromRow(result.get(), 0);
-    league["members"] = membersForLeague(conn.get(), leagueId);
+    league["members"] = membersForLeague(conn, leagueId);
     return league;
 }
 
+std::optional<Json::Value> dbGetLeague(const std::string &accountEmail, const std::string &leagueId) {
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    return dbGetLeague(conn.get(), accountEmail, leagueId);
+}
+
+// Served from the shared membership cache; a connection is only taken on a
+// miss. Callers already holding a pooled connection pass it, so a miss never
+// waits on the pool for a second one.
+cff::league_access::Membership dbMembership(const std::string &accountEmail, const std::string &leagueId) {
+    if (auto cached = cff::league_access::cached(leagueId, accountEmail)) return *cached;
+    auto conn = connectToDb();
+    if (!conn) return {};
+    return cff::league_access::membership(conn.get(), leagueId, accountEmail);
+}
+
+cff::league_access::Membership dbMembership(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    if (auto cached = cff::league_access::cached(leagueId, accountEmail)) return *cached;
+    return cff::league_access::membership(conn, leagueId, accountEmail);
+}
+
 bool dbCanAccessLeague(const std::string &accountEmail, const std::string &leagueId) {
-    return dbGetLeague(accountEmail, leagueId).has_value();
+    return dbMembership(accountEmail, leagueId).member();
+}
+
+bool dbCanAccessLeague(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    return dbMembership(conn, accountEmail, leagueId).member();
 }
 
 bool dbIsCommissioner(const std::string &accountEmail, const std::string &leagueId) {
-    auto conn = connectToDb();
-    if (!conn) return false;
-    auto result = execParams(conn.get(),
-                             "SELECT 1 FROM leagues WHERE id = $2 AND account_email = $1 "
-                             "UNION SELECT 1 FROM league_members WHERE league_id = $2 AND email = $1 AND role = 'commissioner' AND status = 'active' LIMIT 1",
-                             {accountEmail, leagueId});
-    return resultOk(result.get(), PGRES_TUPLES_OK) && PQntuples(result.get()) > 0;
+    return dbMembership(accountEmail, leagueId).commissioner();
+}
+
+bool dbIsCommissioner(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    return dbMembership(conn, accountEmail, leagueId).commissioner();
 }
 
 bool dbIsActiveMember(PGconn *conn, const std::string &leagueId, const std::string &memberEmail) {
-    auto result = execParams(conn,
-                             "SELECT 1 FROM league_members WHERE league_id = $1 AND email = $2 AND status = 'active' LIMIT 1",
-                             {leagueId, memberEmail});
-    return resultOk(result.get(), PGRES_TUPLES_OK) && PQntuples(result.get()) > 0;
+    return cff::league_access::membership(conn, leagueId, memberEmail).active();
 }
 
 bool dbIsActiveOrPendingMember(PGconn *conn, const std::string &leagueId, const std::string &memberEmail) {
-    auto result = execParams(conn,
-                             "SELECT 1 FROM league_members WHERE league_id = $1 AND email = $2 AND status IN ('active', 'pending') LIMIT 1",
-                             {leagueId, memberEmail});
-    return resultOk(result.get(), PGRES_TUPLES_OK) && PQntuples(result.get()) > 0;
+    const auto membership = cff::league_access::membership(conn, leagueId, memberEmail);
+    return membership.active() || membership.status == "pending";
 }
 
 bool dbUpsertMember(PGconn *conn,
@@ -446,6 +457,7 @@ bool dbUpsertMember(PGconn *conn,
                              "joined_at = CASE WHEN EXCLUDED.status = 'active' AND league_members.joined_at IS NULL THEN NOW() ELSE league_members.joined_at END, "
                              "updated_at = NOW()",
                              {leagueId, email, role, status, invitedByEmail, teamName});
+    cff::league_access::invalidate(leagueId);
     return resultOk(result.get(), PGRES_COMMAND_OK);
 }
 
@@ -647,76 +659,6 @@ Json::Value normalizePlayerJson(const Json::Value &body) {
     return player;
 }
 
-double jsonDouble(const Json::Value &body, const std::string &key, double fallback) {
-    const auto &node = body[key];
-    return node.isNumeric() ? node.asDouble() : fallback;
-}
-
-std::string normalizedStatName(const std::string &value) {
-    std::string normalized;
-    normalized.reserve(value.size());
-    for (const auto ch : lowerString(value)) {
-        if (std::isalnum(static_cast<unsigned char>(ch))) {
-            normalized.push_back(ch);
-        }
-    }
-    return normalized;
-}
-
-bool statNameMatches(const std::string &name, const std::vector<std::string> &needles) {
-    const auto normalized = normalizedStatName(name);
-    for (const auto &needle : needles) {
-        if (normalized.find(needle) != std::string::npos) {
-            return true;
-        }
-    }
-    return false;
-}
-
-double fantasyPointsForStat(const Json::Value &settings,
-                            const std::string &category,
-                            const std::string &statName,
-                            double value) {
-    const auto cat = lowerString(category);
-    if (cat == "passing") {
-        if (statNameMatches(statName, {"passyards", "passingyards", "yds"})) {
-            return value / jsonDouble(settings, "passingYardsPerPoint", 25.0);
-        }
-        if (statNameMatches(statName, {"passtd", "passingtd", "passingtouchdown", "touchdowns"})) {
-            return value * jsonDouble(settings, "passingTd", 4.0);
-        }
-        if (statNameMatches(statName, {"interception", "interceptions", "int"})) {
-            return value * jsonDouble(settings, "interception", -2.0);
-        }
-    }
-    if (cat == "rushing") {
-        if (statNameMatches(statName, {"rushyards", "rushingyards", "yds"})) {
-            return value / jsonDouble(settings, "rushingYardsPerPoint", 10.0);
-        }
-        if (statNameMatches(statName, {"rushtd", "rushingtd", "rushingtouchdown", "touchdowns"})) {
-            return value * jsonDouble(settings, "rushingTd", 6.0);
-        }
-    }
-    if (cat == "receiving") {
-        if (statNameMatches(statName, {"recyards", "receivingyards", "yds"})) {
-            return value / jsonDouble(settings, "receivingYardsPerPoint", 10.0);
-        }
-        if (statNameMatches(statName, {"rectd", "receivingtd", "receivingtouchdown", "touchdowns"})) {
-            return value * jsonDouble(settings, "receivingTd", 6.0);
-        }
-        if (statNameMatches(statName, {"reception", "receptions", "rec", "catches"})) {
-            return value * jsonDouble(settings, "reception", 1.0);
-        }
-    }
-    if (statNameMatches(statName, {"fumblelost", "fumbleslost"})) {
-        return value * jsonDouble(settings, "fumbleLost", -2.0);
-    }
-    if (statNameMatches(statName, {"twopoint", "twopointconversion", "twopt"})) {
-        return value * jsonDouble(settings, "twoPointConversion", 2.0);
-    }
-    return 0.0;
-}
-
 Json::Value &arrayForLeague(std::unordered_map<std::string, Json::Value> &store, const std::string &leagueId) {
     auto &arr = store[leagueId];
     if (!arr.isArray()) {
@@ -897,7 +839,7 @@ std::optional<Json::Value> dbCreateLeague(const std::string &accountEmail, const
     }
     dbUpsertMember(conn.get(), league.id, accountEmail, "commissioner", "active", accountEmail);
     dbSyncInvitedMembers(conn.get(), league.id, accountEmail, league.toJson()["invitedEmails"]);
-    return dbGetLeague(accountEmail, league.id);
+    return dbGetLeague(conn.get(), accountEmail, league.id);
 }
 
 std::optional<Json::Value> dbListLeagues(const std::string &accountEmail) {
@@ -924,7 +866,7 @@ std::optional<Json::Value> dbUpdateLeague(const std::string &accountEmail,
                                           const cff::League &league) {
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
-    if (!dbIsCommissioner(accountEmail, leagueId)) return std::nullopt;
+    if (!dbIsCommissioner(conn.get(), accountEmail, leagueId)) return std::nullopt;
     const auto sql =
         "UPDATE leagues SET "
         "name = $3, team_count = $4::int, scoring = $5, scoring_settings = $6::jsonb, "
@@ -959,19 +901,21 @@ std::optional<Json::Value> dbUpdateLeague(const std::string &accountEmail,
         std::cerr << "[leagues] update failed: " << PQerrorMessage(conn.get()) << std::endl;
         return std::nullopt;
     }
+    cff::league_access::invalidate(leagueId);
     dbSyncInvitedMembers(conn.get(), leagueId, accountEmail, league.toJson()["invitedEmails"]);
-    return dbGetLeague(accountEmail, leagueId);
+    return dbGetLeague(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<bool> dbDeleteLeague(const std::string &accountEmail, const std::string &leagueId) {
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
-    if (!dbIsCommissioner(accountEmail, leagueId)) return false;
+    if (!dbIsCommissioner(conn.get(), accountEmail, leagueId)) return false;
     auto result = execParams(conn.get(),
                              "DELETE FROM leagues WHERE id = $2 AND (account_email = $1 OR EXISTS ("
                              "SELECT 1 FROM league_members WHERE league_id = $2 AND email = $1 AND role = 'commissioner' AND status = 'active'"
                              "))",
                              {accountEmail, leagueId});
+    cff::league_access::invalidate(leagueId);
     if (!resultOk(result.get(), PGRES_COMMAND_OK)) {
         std::cerr << "[leagues] delete failed: " << PQerrorMessage(conn.get()) << std::endl;
         return std::nullopt;
@@ -1095,10 +1039,8 @@ Json::Value snapshotPlayer(const Json::Value &player, const std::string &playerI
     return snapshot;
 }
 
-std::optional<int> dbRosterLimit(const std::string &leagueId) {
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    auto result = execParams(conn.get(),
+std::optional<int> dbRosterLimit(PGconn *conn, const std::string &leagueId) {
+    auto result = execParams(conn,
                              "SELECT roster_rules::text FROM leagues WHERE id = $1",
                              {leagueId});
     if (!resultOk(result.get(), PGRES_TUPLES_OK) || PQntuples(result.get()) == 0) {
@@ -1108,7 +1050,7 @@ std::optional<int> dbRosterLimit(const std::string &leagueId) {
 }
 
 bool dbRosterHasRoom(PGconn *conn, const std::string &leagueId, const std::string &managerEmail, int offset = 0) {
-    auto limit = dbRosterLimit(leagueId).value_or(14);
+    auto limit = dbRosterLimit(conn, leagueId).value_or(14);
     auto result = execParams(conn,
                              "SELECT COUNT(*) FROM rosters WHERE league_id = $1 AND manager_email = $2",
                              {leagueId, managerEmail});
@@ -1136,10 +1078,9 @@ bool dbManagerHasPlayer(PGconn *conn,
     return resultOk(result.get(), PGRES_TUPLES_OK) && PQntuples(result.get()) > 0;
 }
 
-std::optional<Json::Value> dbRosterRules(const std::string &leagueId) {
-    auto conn = connectToDb();
+std::optional<Json::Value> dbRosterRules(PGconn *conn, const std::string &leagueId) {
     if (!conn) return std::nullopt;
-    auto result = execParams(conn.get(),
+    auto result = execParams(conn,
                              "SELECT roster_rules::text FROM leagues WHERE id = $1",
                              {leagueId});
     if (!resultOk(result.get(), PGRES_TUPLES_OK) || PQntuples(result.get()) == 0) {
@@ -1148,10 +1089,9 @@ std::optional<Json::Value> dbRosterRules(const std::string &leagueId) {
     return jsonFromString(cell(result.get(), 0, 0));
 }
 
-std::optional<Json::Value> dbWaiverRules(const std::string &leagueId) {
-    auto conn = connectToDb();
+std::optional<Json::Value> dbWaiverRules(PGconn *conn, const std::string &leagueId) {
     if (!conn) return std::nullopt;
-    auto result = execParams(conn.get(),
+    auto result = execParams(conn,
                              "SELECT waiver_rules::text FROM leagues WHERE id = $1",
                              {leagueId});
     if (!resultOk(result.get(), PGRES_TUPLES_OK) || PQntuples(result.get()) == 0) {
@@ -1160,10 +1100,9 @@ std::optional<Json::Value> dbWaiverRules(const std::string &leagueId) {
     return jsonFromString(cell(result.get(), 0, 0));
 }
 
-std::optional<Json::Value> dbTradeRules(const std::string &leagueId) {
-    auto conn = connectToDb();
+std::optional<Json::Value> dbTradeRules(PGconn *conn, const std::string &leagueId) {
     if (!conn) return std::nullopt;
-    auto result = execParams(conn.get(),
+    auto result = execParams(conn,
                              "SELECT trade_rules::text FROM leagues WHERE id = $1",
                              {leagueId});
     if (!resultOk(result.get(), PGRES_TUPLES_OK) || PQntuples(result.get()) == 0) {
@@ -1213,7 +1152,7 @@ std::optional<std::string> dbAssignRosterSlot(PGconn *conn,
                                               const std::string &managerEmail,
                                               const Json::Value &player,
                                               int offset = 0) {
-    const auto rules = dbRosterRules(leagueId).value_or(Json::Value{Json::objectValue});
+    const auto rules = dbRosterRules(conn, leagueId).value_or(Json::Value{Json::objectValue});
     auto countsResult = execParams(conn,
                                    "SELECT roster_slot, COUNT(*) FROM rosters WHERE league_id = $1 AND manager_email = $2 GROUP BY roster_slot",
                                    {leagueId, managerEmail});
@@ -1226,28 +1165,35 @@ std::optional<std::string> dbAssignRosterSlot(PGconn *conn,
     return cff::league_roster::preferredRosterSlot(player, rules, counts, offset);
 }
 
-Json::Value draftPicksForLeague(PGconn *conn, const std::string &leagueId) {
-    auto result = execParams(conn,
-                             "SELECT id, manager_email, pick_number, player_id, player_snapshot::text, "
-                             "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                             "FROM draft_picks WHERE league_id = $1 ORDER BY pick_number",
-                             {leagueId});
+const cff::db::Statement kLeagueDraftPicks{
+    "league.draft_picks",
+    "SELECT id, manager_email, pick_number, player_id, player_snapshot::text, "
+    "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
+    "FROM draft_picks WHERE league_id = $1 ORDER BY pick_number",
+    1};
+
+Json::Value draftPicksFromResult(PGresult *result) {
     Json::Value picks(Json::arrayValue);
-    if (!resultOk(result.get(), PGRES_TUPLES_OK)) {
+    if (!resultOk(result, PGRES_TUPLES_OK)) {
         return picks;
     }
-    for (int row = 0; row < PQntuples(result.get()); ++row) {
+    for (int row = 0; row < PQntuples(result); ++row) {
         Json::Value pick;
-        pick["id"] = cell(result.get(), row, 0);
-        pick["managerEmail"] = cell(result.get(), row, 1);
-        pick["pickNumber"] = cellInt(result.get(), row, 2, row + 1);
-        pick["player"] = snapshotPlayer(jsonFromString(cell(result.get(), row, 4)), cell(result.get(), row, 3));
-        pick["createdAt"] = cell(result.get(), row, 5);
+        pick["id"] = cell(result, row, 0);
+        pick["managerEmail"] = cell(result, row, 1);
+        pick["pickNumber"] = cellInt(result, row, 2, row + 1);
+        pick["player"] = snapshotPlayer(jsonFromString(cell(result, row, 4)), cell(result, row, 3));
+        pick["createdAt"] = cell(result, row, 5);
         picks.append(pick);
     }
     return picks;
 }
 
+Json::Value draftPicksForLeague(PGconn *conn, const std::string &leagueId) {
+    PgResultPtr result{cff::db::execPrepared(conn, kLeagueDraftPicks, {leagueId})};
+    return draftPicksFromResult(result.get());
+}
+
 Json::Value activeDraftOrderForLeague(PGconn *conn, const std::string &leagueId) {
     auto members = membersForLeague(conn, leagueId);
     Json::Value order(Json::arrayValue);
@@ -1301,7 +1247,7 @@ std::string draftTypeForLeague(PGconn *conn, const std::string &leagueId) {
 }
 
 bool dbDraftComplete(PGconn *conn, const std::string &leagueId) {
-    const auto limit = dbRosterLimit(leagueId).value_or(14);
+    const auto limit = dbRosterLimit(conn, leagueId).value_or(14);
     auto members = membersForLeague(conn, leagueId);
     int activeMembers = 0;
     for (const auto &member : members) {
@@ -1333,54 +1279,104 @@ bool dbLineupLocked(PGconn *conn, const std::string &leagueId) {
     return resultOk(result.get(), PGRES_TUPLES_OK) && PQntuples(result.get()) > 0;
 }
 
-std::optional<Json::Value> dbGetDraftState(const std::string &accountEmail, const std::string &leagueId) {
-    if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    auto state = execParams(conn.get(),
-                            "INSERT INTO draft_states (league_id, status, current_pick, draft_order, pick_deadline, started_at) "
-                            "VALUES ($1, 'not_started', 1, ARRAY(SELECT email FROM league_members WHERE league_id = $1 AND status = 'active' ORDER BY role, created_at), NULL, NULL) "
-                            "ON CONFLICT (league_id) DO NOTHING",
-                            {leagueId});
-    (void)state;
-    auto queueResult = execParams(conn.get(),
-                                  "SELECT queue::text FROM draft_queues WHERE league_id = $1 AND manager_email = $2",
-                                  {leagueId, accountEmail});
+const cff::db::Statement kLeagueDraftEnsureState{
+    "league.draft_ensure_state",
+    "INSERT INTO draft_states (league_id, status, current_pick, draft_order, pick_deadline, started_at) "
+    "VALUES ($1, 'not_started', 1, ARRAY(SELECT email FROM league_members WHERE league_id = $1 AND status = 'active' ORDER BY role, created_at), NULL, NULL) "
+    "ON CONFLICT (league_id) DO NOTHING",
+    1};
+
+const cff::db::Statement kLeagueDraftQueue{
+    "league.draft_queue",
+    "SELECT queue::text FROM draft_queues WHERE league_id = $1 AND manager_email = $2",
+    2};
+
+const cff::db::Statement kLeagueDraftState{
+    "league.draft_state",
+    "SELECT status, current_pick, pick_clock_seconds, "
+    "COALESCE(to_char(pick_deadline AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), ''), "
+    "COALESCE(to_char(started_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), ''), "
+    "to_json(draft_order)::text "
+    "FROM draft_states WHERE league_id = $1",
+    1};
+
+const cff::db::Statement kLeagueDraftSettings{
+    "league.draft_settings",
+    "SELECT draft_lobby_open OR (draft_date IS NOT NULL AND draft_date <= NOW() + INTERVAL '30 minutes'), "
+    "draft_type, roster_rules::text FROM leagues WHERE id = $1",
+    1};
+
+// Rostered players per active manager, for the completion check.
+const cff::db::Statement kLeagueDraftRosterCounts{
+    "league.draft_roster_counts",
+    "SELECT COUNT(r.league_id) FROM league_members lm "
+    "LEFT JOIN rosters r ON r.league_id = lm.league_id AND r.manager_email = lm.email "
+    "WHERE lm.league_id = $1 AND lower(lm.status) = 'active' AND lm.email <> '' GROUP BY lm.email",
+    1};
+
+// Every read goes out in one pipelined batch behind the state insert, so the
+// payload costs one round trip instead of one per query.
+std::optional<Json::Value> dbGetDraftState(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    if (!dbCanAccessLeague(conn, accountEmail, leagueId)) return std::nullopt;
+    auto batch = execPipeline(conn, {
+        {kLeagueDraftEnsureState, {leagueId}},
+        {kLeagueDraftQueue, {leagueId, accountEmail}},
+        {kLeagueDraftState, {leagueId}},
+        {kLeagueDraftSettings, {leagueId}},
+        {kLeagueDraftPicks, {leagueId}},
+        {kLeagueDraftRosterCounts, {leagueId}},
+    });
+    auto *queueResult = batch[1].get();
+    auto *stateResult = batch[2].get();
+    auto *settings = batch[3].get();
+    auto *rosterCounts = batch[5].get();
+
     Json::Value payload;
     payload["queue"] = Json::Value{Json::arrayValue};
-    if (resultOk(queueResult.get(), PGRES_TUPLES_OK) && PQntuples(queueResult.get()) > 0) {
-        payload["queue"] = jsonFromString(cell(queueResult.get(), 0, 0), Json::Value{Json::arrayValue});
+    if (resultOk(queueResult, PGRES_TUPLES_OK) && PQntuples(queueResult) > 0) {
+        payload["queue"] = jsonFromString(cell(queueResult, 0, 0), Json::Value{Json::arrayValue});
     }
-    auto stateResult = execParams(conn.get(),
-                                  "SELECT status, current_pick, pick_clock_seconds, "
-                                  "COALESCE(to_char(pick_deadline AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), ''), "
-                                  "COALESCE(to_char(started_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                                  "FROM draft_states WHERE league_id = $1",
-                                  {leagueId});
     payload["status"] = "not_started";
     payload["currentPick"] = 1;
     payload["pickClockSeconds"] = 90;
     payload["pickDeadline"] = "";
     payload["startedAt"] = "";
-    if (resultOk(stateResult.get(), PGRES_TUPLES_OK) && PQntuples(stateResult.get()) > 0) {
-        payload["status"] = cell(stateResult.get(), 0, 0);
-        payload["currentPick"] = cellInt(stateResult.get(), 0, 1, 1);
-        payload["pickClockSeconds"] = cellInt(stateResult.get(), 0, 2, 90);
-        payload["pickDeadline"] = cell(stateResult.get(), 0, 3);
-        payload["startedAt"] = cell(stateResult.get(), 0, 4);
-    }
-    payload["lobbyOpen"] = dbDraftLobbyOpen(conn.get(), leagueId);
-    payload["draftType"] = draftTypeForLeague(conn.get(), leagueId);
-    payload["draftOrder"] = draftOrderForLeague(conn.get(), leagueId);
+    Json::Value draftOrder(Json::arrayValue);
+    if (resultOk(stateResult, PGRES_TUPLES_OK) && PQntuples(stateResult) > 0) {
+        payload["status"] = cell(stateResult, 0, 0);
+        payload["currentPick"] = cellInt(stateResult, 0, 1, 1);
+        payload["pickClockSeconds"] = cellInt(stateResult, 0, 2, 90);
+        payload["pickDeadline"] = cell(stateResult, 0, 3);
+        payload["startedAt"] = cell(stateResult, 0, 4);
+        draftOrder = jsonFromString(cell(stateResult, 0, 5), Json::Value{Json::arrayValue});
+    }
+    const bool hasSettings = resultOk(settings, PGRES_TUPLES_OK) && PQntuples(settings) > 0;
+    payload["lobbyOpen"] = hasSettings && cellBool(settings, 0, 0);
+    payload["draftType"] = hasSettings ? lowerString(cell(settings, 0, 1)) : "snake";
+    if (!draftOrder.isArray() || draftOrder.empty()) draftOrder = activeDraftOrderForLeague(conn, leagueId);
+    payload["draftOrder"] = draftOrder;
     payload["currentManager"] = cff::league_schedule::currentDraftManager(
         payload["draftOrder"], payload["currentPick"].asInt(), payload["draftType"].asString());
-    payload["picks"] = draftPicksForLeague(conn.get(), leagueId);
-    if (payload["status"].asString() != "not_started" && dbDraftComplete(conn.get(), leagueId)) {
-        payload["status"] = "complete";
+    payload["picks"] = draftPicksFromResult(batch[4].get());
+    if (payload["status"].asString() != "not_started" && resultOk(rosterCounts, PGRES_TUPLES_OK)) {
+        const int limit = hasSettings
+            ? cff::league_roster::rosterLimitFromRules(jsonFromString(cell(settings, 0, 2)))
+            : 14;
+        bool complete = PQntuples(rosterCounts) > 0;
+        for (int row = 0; complete && row < PQntuples(rosterCounts); ++row) {
+            complete = cellInt(rosterCounts, row, 0, 0) >= limit;
+        }
+        if (complete) payload["status"] = "complete";
     }
     return payload;
 }
 
+std::optional<Json::Value> dbGetDraftState(const std::string &accountEmail, const std::string &leagueId) {
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
+}
+
 std::optional<Json::Value> dbStartDraft(const std::string &accountEmail,
                                           const std::string &leagueId) {
     if (!dbIsCommissioner(accountEmail, leagueId)) return std::nullopt;
@@ -1397,7 +1393,7 @@ std::optional<Json::Value> dbStartDraft(const std::string &accountEmail,
                               {leagueId});
     if (!resultOk(current.get(), PGRES_TUPLES_OK) || PQntuples(current.get()) == 0) return std::nullopt;
     const auto currentStatus = cell(current.get(), 0, 0);
-    if (currentStatus == "open") return dbGetDraftState(accountEmail, leagueId);
+    if (currentStatus == "open") return dbGetDraftState(conn.get(), accountEmail, leagueId);
     if (currentStatus != "not_started") return std::nullopt;
     auto order = draftOrderForLeague(conn.get(), leagueId);
     if (!draftOrderMatchesMembers(conn.get(), leagueId, order)) {
@@ -1417,7 +1413,7 @@ std::optional<Json::Value> dbStartDraft(const std::string &accountEmail,
                              "updated_at = NOW() WHERE league_id = $1 AND status = 'not_started'",
                              {leagueId, jsonToString(order)});
     if (!resultOk(update.get(), PGRES_COMMAND_OK) || std::string{PQcmdTuples(update.get())} == "0") return std::nullopt;
-    return dbGetDraftState(accountEmail, leagueId);
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbSaveDraftQueue(const std::string &accountEmail,
@@ -1432,7 +1428,7 @@ std::optional<Json::Value> dbSaveDraftQueue(const std::string &accountEmail,
                              "ON CONFLICT (league_id, manager_email) DO UPDATE SET queue = EXCLUDED.queue, updated_at = NOW()",
                              {leagueId, accountEmail, jsonToString(queue.isArray() ? queue : Json::Value{Json::arrayValue})});
     if (!resultOk(result.get(), PGRES_COMMAND_OK)) return std::nullopt;
-    return dbGetDraftState(accountEmail, leagueId);
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbSaveDraftOrder(const std::string &accountEmail,
@@ -1458,7 +1454,7 @@ std::optional<Json::Value> dbSaveDraftOrder(const std::string &accountEmail,
                                   {leagueId, jsonToString(draftOrder)});
     (void)insertState;
     if (!resultOk(updateState.get(), PGRES_COMMAND_OK) || std::string{PQcmdTuples(updateState.get())} == "0") return std::nullopt;
-    return dbGetDraftState(accountEmail, leagueId);
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbMakeDraftPick(const std::string &accountEmail,
@@ -1511,7 +1507,7 @@ std::optional<Json::Value> dbMakeDraftPick(const std::string &accountEmail,
     (void)stateResult;
     if (!resultOk(rosterResult.get(), PGRES_COMMAND_OK)) return std::nullopt;
     dbAddTransaction(conn.get(), leagueId, "Draft Pick", "Drafted " + jsonString(normalized, "name"), accountEmail, normalized);
-    return dbGetDraftState(accountEmail, leagueId);
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbResetDraft(const std::string &accountEmail, const std::string &leagueId) {
@@ -1533,7 +1529,7 @@ std::optional<Json::Value> dbResetDraft(const std::string &accountEmail, const s
     (void)rosters;
     (void)insertState;
     if (!resultOk(state.get(), PGRES_COMMAND_OK)) return std::nullopt;
-    return dbGetDraftState(accountEmail, leagueId);
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbUndoDraftPick(const std::string &accountEmail, const std::string &leagueId) {
@@ -1545,7 +1541,7 @@ std::optional<Json::Value> dbUndoDraftPick(const std::string &accountEmail, cons
                                "FROM draft_picks WHERE league_id = $1 ORDER BY pick_number DESC LIMIT 1",
                                {leagueId});
     if (!resultOk(lastPick.get(), PGRES_TUPLES_OK)) return std::nullopt;
-    if (PQntuples(lastPick.get()) == 0) return dbGetDraftState(accountEmail, leagueId);
+    if (PQntuples(lastPick.get()) == 0) return dbGetDraftState(conn.get(), accountEmail, leagueId);
 
     const auto managerEmail = cell(lastPick.get(), 0, 0);
     const auto pickNumber = cellInt(lastPick.get(), 0, 1, 1);
@@ -1576,14 +1572,12 @@ std::optional<Json::Value> dbUndoDraftPick(const std::string &accountEmail, cons
     if (!resultOk(deletePick.get(), PGRES_COMMAND_OK)) return std::nullopt;
     dbAddTransaction(conn.get(), leagueId, "Draft Undo", "Undid pick " + std::to_string(pickNumber), accountEmail,
                      snapshotPlayer(jsonFromString(playerSnapshot), playerId));
-    return dbGetDraftState(accountEmail, leagueId);
+    return dbGetDraftState(conn.get(), accountEmail, leagueId);
 }
 
-std::optional<Json::Value> dbGetRoster(const std::string &accountEmail, const std::string &leagueId) {
-    if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    auto result = execParams(conn.get(),
+std::optional<Json::Value> dbGetRoster(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    if (!dbCanAccessLeague(conn, accountEmail, leagueId)) return std::nullopt;
+    auto result = execParams(conn,
                              "SELECT player_id, player_snapshot::text, roster_slot "
                              "FROM rosters WHERE league_id = $1 AND manager_email = $2 "
                              "ORDER BY acquired_at DESC",
@@ -1598,6 +1592,12 @@ std::optional<Json::Value> dbGetRoster(const std::string &accountEmail, const st
     return roster;
 }
 
+std::optional<Json::Value> dbGetRoster(const std::string &accountEmail, const std::string &leagueId) {
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    return dbGetRoster(conn.get(), accountEmail, leagueId);
+}
+
 std::optional<Json::Value> dbGetManagerRoster(const std::string &accountEmail,
                                               const std::string &leagueId,
                                               const std::string &managerEmail) {
@@ -1636,7 +1636,7 @@ std::optional<Json::Value> dbAddRosterPlayer(const std::string &accountEmail,
     const auto normalized = normalizePlayerJson(player);
     const auto playerId = jsonString(normalized, "id");
     if (dbPlayerRosteredInLeague(conn.get(), leagueId, playerId)) return std::nullopt;
-    const auto waiverRules = dbWaiverRules(leagueId).value_or(Json::Value{Json::objectValue});
+    const auto waiverRules = dbWaiverRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
     if (cff::league_waiver::modeActive(waiverRules)) return std::nullopt;
     if (!dbRosterHasRoom(conn.get(), leagueId, accountEmail)) return std::nullopt;
     const auto slot = dbAssignRosterSlot(conn.get(), leagueId, accountEmail, normalized);
@@ -1650,7 +1650,7 @@ std::optional<Json::Value> dbAddRosterPlayer(const std::string &accountEmail,
                              {leagueId, accountEmail, playerId, jsonToString(normalized), *slot});
     if (!resultOk(result.get(), PGRES_COMMAND_OK)) return std::nullopt;
     dbAddTransaction(conn.get(), leagueId, "Free Agent", "Added " + jsonString(normalized, "name"), accountEmail, normalized);
-    return dbGetRoster(accountEmail, leagueId);
+    return dbGetRoster(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbDropRosterPlayer(const std::string &accountEmail,
@@ -1671,7 +1671,7 @@ std::optional<Json::Value> dbDropRosterPlayer(const std::string &accountEmail,
         auto removed = snapshotPlayer(jsonFromString(cell(result.get(), 0, 0)), playerId);
         dbAddTransaction(conn.get(), leagueId, "Drop", "Dropped " + jsonString(removed, "name"), accountEmail, removed);
     }
-    return dbGetRoster(accountEmail, leagueId);
+    return dbGetRoster(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbUpdateRosterSlot(const std::string &accountEmail,
@@ -1699,7 +1699,7 @@ std::optional<Json::Value> dbUpdateRosterSlot(const std::string &accountEmail,
         }
     }
     if (!target.isObject()) return std::nullopt;
-    const auto rules = dbRosterRules(leagueId).value_or(Json::Value{Json::objectValue});
+    const auto rules = dbRosterRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
     const auto slot = lowerString(requestedSlot);
     if (!cff::league_roster::validateRosterSlotMove(target, roster, rules, playerId, slot)) {
         Json::Value error;
@@ -1710,19 +1710,41 @@ std::optional<Json::Value> dbUpdateRosterSlot(const std::string &accountEmail,
                              "UPDATE rosters SET roster_slot = $4 WHERE league_id = $1 AND manager_email = $2 AND player_id = $3",
                              {leagueId, accountEmail, playerId, slot});
     if (!resultOk(update.get(), PGRES_COMMAND_OK)) return std::nullopt;
-    return dbGetRoster(accountEmail, leagueId);
+    return dbGetRoster(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbFreeAgents(const std::string &accountEmail, const std::string &leagueId) {
     auto roster = dbGetRoster(accountEmail, leagueId);
     if (!roster) return std::nullopt;
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
     Json::Value available(Json::arrayValue);
-    for (const auto &player : sampleFreeAgentPool()) {
-        if (dbPlayerRosteredInLeague(conn.get(), leagueId, jsonString(player, "id"))) {
-            continue;
+    cff::player_search_index::Query query;
+    query.limit = 500;
+    if (const auto agents = cff::free_agent_pool::leagueFreeAgents(leagueId, query)) {
+        for (std::size_t index = 0; index < agents->size(); ++index) {
+            auto candidate = (*agents)[index].toJson();
+            candidate["rank"] = static_cast<Json::UInt64>(index + 1);
+            candidate["availability"] = "Free Agent";
+            available.append(candidate);
         }
+        return available;
+    }
+
+    // Without a loaded catalog, fall back to the sample pool minus everyone
+    // the league has rostered, found in one query.
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    const auto pool = sampleFreeAgentPool();
+    Json::Value poolIds(Json::arrayValue);
+    for (const auto &player : pool) poolIds.append(jsonString(player, "id"));
+    auto rostered = execParams(conn.get(),
+                               "SELECT player_id FROM rosters WHERE league_id = $1 "
+                               "AND player_id IN (SELECT jsonb_array_elements_text($2::jsonb))",
+                               {leagueId, jsonToString(poolIds)});
+    if (!resultOk(rostered.get(), PGRES_TUPLES_OK)) return std::nullopt;
+    std::unordered_set<std::string> rosteredIds;
+    for (int row = 0; row < PQntuples(rostered.get()); ++row) rosteredIds.insert(cell(rostered.get(), row, 0));
+    for (const auto &player : pool) {
+        if (rosteredIds.count(jsonString(player, "id"))) continue;
         auto candidate = player;
         candidate["availability"] = "Free Agent";
         available.append(candidate);
@@ -1730,12 +1752,11 @@ std::optional<Json::Value> dbFreeAgents(const std::string &accountEmail, const s
     return available;
 }
 
-std::optional<Json::Value> dbListWaivers(const std::string &accountEmail, const std::string &leagueId) {
-    if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    const bool commissioner = dbIsCommissioner(accountEmail, leagueId);
-    auto result = execParams(conn.get(),
+std::optional<Json::Value> dbListWaivers(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    const auto membership = dbMembership(conn, accountEmail, leagueId);
+    if (!membership.member()) return std::nullopt;
+    const bool commissioner = membership.commissioner();
+    auto result = execParams(conn,
                              "SELECT id, add_player_id, add_player_snapshot::text, COALESCE(drop_player_id, ''), "
                              "status, COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), ''), "
                              "manager_email, priority, claim_order "
@@ -1759,6 +1780,12 @@ std::optional<Json::Value> dbListWaivers(const std::string &accountEmail, const
     return claims;
 }
 
+std::optional<Json::Value> dbListWaivers(const std::string &accountEmail, const std::string &leagueId) {
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    return dbListWaivers(conn.get(), accountEmail, leagueId);
+}
+
 int dbPriorityForManager(PGconn *conn, const std::string &leagueId, const std::string &managerEmail) {
     auto seed = execParams(conn,
                            "INSERT INTO waiver_priorities (league_id, manager_email, priority) "
@@ -1861,7 +1888,7 @@ std::optional<Json::Value> dbCreateWaiver(const std::string &accountEmail,
                              {claimId, leagueId, accountEmail, jsonString(player, "id"), jsonToString(player), dropPlayerId, std::to_string(priority), std::to_string(claimOrder)});
     if (!resultOk(result.get(), PGRES_COMMAND_OK)) return std::nullopt;
     dbAddTransaction(conn.get(), leagueId, "Waiver Claim", cff::league_waiver::claimTransactionSummary(player), accountEmail, player);
-    auto claims = dbListWaivers(accountEmail, leagueId);
+    auto claims = dbListWaivers(conn.get(), accountEmail, leagueId);
     if (claims && claims->size() > 0) {
         return (*claims)[0];
     }
@@ -1875,7 +1902,7 @@ std::optional<Json::Value> dbProcessWaiver(const std::string &accountEmail,
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
     if (dbLineupLocked(conn.get(), leagueId)) return std::nullopt;
-    const auto waiverRules = dbWaiverRules(leagueId).value_or(Json::Value{Json::objectValue});
+    const auto waiverRules = dbWaiverRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
     if (!cff::league_waiver::deadlinePassed(waiverRules)) return std::nullopt;
     auto claim = execParams(conn.get(),
                             "SELECT add_player_id, add_player_snapshot::text, COALESCE(drop_player_id, '') "
@@ -1928,14 +1955,14 @@ std::optional<Json::Value> dbUpdateWaiverStatus(const std::string &accountEmail,
     if (statusForDb(status) != "cancelled") return std::nullopt;
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
-    const bool commissioner = dbIsCommissioner(accountEmail, leagueId);
+    const bool commissioner = dbIsCommissioner(conn.get(), accountEmail, leagueId);
     auto update = execParams(conn.get(),
                              "UPDATE waiver_claims SET status = 'cancelled', processed_at = NOW() "
                              "WHERE league_id = $1 AND id = $2 AND status = 'pending' AND ($4 = 'true' OR manager_email = $3)",
                              {leagueId, claimId, accountEmail, commissioner ? "true" : "false"});
     if (!resultOk(update.get(), PGRES_COMMAND_OK) || std::string{PQcmdTuples(update.get())} == "0") return std::nullopt;
     dbAddTransaction(conn.get(), leagueId, "Waiver Cancelled", cff::league_waiver::cancelledTransactionSummary(), accountEmail, Json::Value{Json::objectValue});
-    return dbListWaivers(accountEmail, leagueId);
+    return dbListWaivers(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbReorderWaivers(const std::string &accountEmail,
@@ -1953,7 +1980,7 @@ std::optional<Json::Value> dbReorderWaivers(const std::string &accountEmail,
                                  {leagueId, accountEmail, claimId.asString(), std::to_string(order++)});
         if (!resultOk(update.get(), PGRES_COMMAND_OK)) return std::nullopt;
     }
-    return dbListWaivers(accountEmail, leagueId);
+    return dbListWaivers(conn.get(), accountEmail, leagueId);
 }
 
 std::optional<Json::Value> dbProcessWaivers(const std::string &accountEmail, const std::string &leagueId) {
@@ -1961,7 +1988,7 @@ std::optional<Json::Value> dbProcessWaivers(const std::string &accountEmail, con
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
     if (dbLineupLocked(conn.get(), leagueId)) return std::nullopt;
-    const auto waiverRules = dbWaiverRules(leagueId).value_or(Json::Value{Json::objectValue});
+    const auto waiverRules = dbWaiverRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
     if (!cff::league_waiver::deadlinePassed(waiverRules)) return std::nullopt;
     auto claims = execParams(conn.get(),
                              "SELECT id, manager_email, add_player_id, add_player_snapshot::text, COALESCE(drop_player_id, '') "
@@ -2029,17 +2056,16 @@ std::optional<Json::Value> dbProcessWaivers(const std::string &accountEmail, con
     Json::Value payload;
     payload["processed"] = processed;
     payload["cancelled"] = cancelled;
-    payload["claims"] = dbListWaivers(accountEmail, leagueId).value_or(Json::Value{Json::arrayValue});
+    payload["claims"] = dbListWaivers(conn.get(), accountEmail, leagueId).value_or(Json::Value{Json::arrayValue});
     return payload;
 }
 
-std::optional<Json::Value> dbListTrades(const std::string &accountEmail, const std::string &leagueId) {
-    if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    dbExpireTrades(conn.get(), leagueId);
-    const bool commissioner = dbIsCommissioner(accountEmail, leagueId);
-    auto result = execParams(conn.get(),
+std::optional<Json::Value> dbListTrades(PGconn *conn, const std::string &accountEmail, const std::string &leagueId) {
+    const auto membership = dbMembership(conn, accountEmail, leagueId);
+    if (!membership.member()) return std::nullopt;
+    dbExpireTrades(conn, leagueId);
+    const bool commissioner = membership.commissioner();
+    auto result = execParams(conn,
                              "SELECT id, offer_player_snapshot::text, request_player_name, target_manager, status, "
                              "COALESCE(request_player_snapshot::text, '{}'), "
                              "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), ''), "
@@ -2069,6 +2095,12 @@ std::optional<Json::Value> dbListTrades(const std::string &accountEmail, const s
     return trades;
 }
 
+std::optional<Json::Value> dbListTrades(const std::string &accountEmail, const std::string &leagueId) {
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    return dbListTrades(conn.get(), accountEmail, leagueId);
+}
+
 std::optional<Json::Value> dbCreateTrade(const std::string &accountEmail,
                                          const std::string &leagueId,
                                          const Json::Value &body) {
@@ -2082,7 +2114,7 @@ std::optional<Json::Value> dbCreateTrade(const std::string &accountEmail,
     const auto requestedId = body.isMember("requestPlayer") && body["requestPlayer"].isObject()
                                  ? jsonString(body["requestPlayer"], "id")
                                  : "";
-    const auto rules = dbTradeRules(leagueId).value_or(Json::Value{Json::objectValue});
+    const auto rules = dbTradeRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
     const auto requiresApproval = cff::league_trade::approvalRequired(rules);
     const auto expirationHours = cff::league_trade::expirationHours(rules);
     if (!cff::league_trade::validTarget(accountEmail, target)) return std::nullopt;
@@ -2103,7 +2135,7 @@ std::optional<Json::Value> dbCreateTrade(const std::string &accountEmail,
                               jsonString(body, "note"), requiresApproval ? "true" : "false", std::to_string(expirationHours)});
     if (!resultOk(result.get(), PGRES_COMMAND_OK)) return std::nullopt;
     dbAddTransaction(conn.get(), leagueId, "Trade Offer", cff::league_trade::offerTransactionSummary(*offer), accountEmail, *offer);
-    auto trades = dbListTrades(accountEmail, leagueId);
+    auto trades = dbListTrades(conn.get(), accountEmail, leagueId);
     if (trades && trades->size() > 0) {
         return (*trades)[0];
     }
@@ -2118,7 +2150,7 @@ std::optional<Json::Value> dbUpdateTradeStatus(const std::string &accountEmail,
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
     dbExpireTrades(conn.get(), leagueId);
-    const bool commissioner = dbIsCommissioner(accountEmail, leagueId);
+    const bool commissioner = dbIsCommissioner(conn.get(), accountEmail, leagueId);
     auto result = execParams(conn.get(),
                              "SELECT offered_by_email, offered_to_email, offer_player_snapshot::text, request_player_snapshot::text, "
                              "request_player_name, target_manager, requires_approval, status, note "
@@ -2236,122 +2268,31 @@ std::optional<Json::Value> dbCreateLeagueFeedPost(const std::string &accountEmai
     return feedItem("Commissioner Post", cell(result.get(), 0, 2), cell(result.get(), 0, 4), cell(result.get(), 0, 3), "Post");
 }
 
-std::optional<Json::Value> dbListLeagueFeed(const std::string &accountEmail, const std::string &leagueId) {
+std::optional<Json::Value> dbListLeagueFeed(const std::string &accountEmail,
+                                            const std::string &leagueId,
+                                            const std::string &beforeCursor,
+                                            int limit) {
     if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
     auto conn = connectToDb();
     if (!conn) return std::nullopt;
 
+    // One range scan of idx_league_feed_events_league_id; an empty cursor
+    // starts from the newest event.
+    auto events = execParams(conn.get(),
+                             "SELECT id, event_type, summary, manager_email, badge, "
+                             "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
+                             "FROM league_feed_events "
+                             "WHERE league_id = $1 AND ($2 = '' OR id < $2::bigint) "
+                             "ORDER BY id DESC LIMIT $3::int",
+                             {leagueId, beforeCursor, std::to_string(limit)});
+    if (!resultOk(events.get(), PGRES_TUPLES_OK)) return std::nullopt;
     Json::Value items(Json::arrayValue);
-
-    auto posts = execParams(conn.get(),
-                            "SELECT post_type, body, manager_email, "
-                            "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                            "FROM league_feed_posts WHERE league_id = $1 ORDER BY created_at DESC LIMIT 100",
-                            {leagueId});
-    if (!resultOk(posts.get(), PGRES_TUPLES_OK)) return std::nullopt;
-    for (int row = 0; row < PQntuples(posts.get()); ++row) {
-        const auto type = cell(posts.get(), row, 0) == "commissioner_post" ? "Commissioner Post" : cell(posts.get(), row, 0);
-        items.append(feedItem(type, cell(posts.get(), row, 1), cell(posts.get(), row, 3), cell(posts.get(), row, 2), "Post"));
-    }
-
-    auto txns = execParams(conn.get(),
-                           "SELECT transaction_type, summary, COALESCE(manager_email, ''), "
-                           "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                           "FROM transactions WHERE league_id = $1 ORDER BY created_at DESC LIMIT 100",
-                           {leagueId});
-    if (!resultOk(txns.get(), PGRES_TUPLES_OK)) return std::nullopt;
-    for (int row = 0; row < PQntuples(txns.get()); ++row) {
-        items.append(feedItem(cell(txns.get(), row, 0), cell(txns.get(), row, 1), cell(txns.get(), row, 3), cell(txns.get(), row, 2), "Transaction"));
-    }
-
-    auto waivers = execParams(conn.get(),
-                              "SELECT status, add_player_snapshot::text, COALESCE(drop_player_id, ''), manager_email, "
-                              "COALESCE(to_char(COALESCE(processed_at, created_at) AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                              "FROM waiver_claims WHERE league_id = $1 ORDER BY COALESCE(processed_at, created_at) DESC LIMIT 100",
-                              {leagueId});
-    if (!resultOk(waivers.get(), PGRES_TUPLES_OK)) return std::nullopt;
-    for (int row = 0; row < PQntuples(waivers.get()); ++row) {
-        const auto status = statusForUi(cell(waivers.get(), row, 0));
-        const auto player = jsonFromString(cell(waivers.get(), row, 1));
-        items.append(feedItem("Waiver " + status,
-                              status + ": " + jsonString(player, "name", "player") + (cell(waivers.get(), row, 2).empty() ? "" : " with a drop"),
-                              cell(waivers.get(), row, 4),
-                              cell(waivers.get(), row, 3),
-                              "Waiver"));
-    }
-
-    auto trades = execParams(conn.get(),
-                             "SELECT status, offer_player_snapshot::text, request_player_snapshot::text, request_player_name, offered_by_email, "
-                             "COALESCE(to_char(COALESCE(resolved_at, created_at) AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                             "FROM trade_offers WHERE league_id = $1 ORDER BY COALESCE(resolved_at, created_at) DESC LIMIT 100",
-                             {leagueId});
-    if (!resultOk(trades.get(), PGRES_TUPLES_OK)) return std::nullopt;
-    for (int row = 0; row < PQntuples(trades.get()); ++row) {
-        const auto status = statusForUi(cell(trades.get(), row, 0));
-        const auto offer = jsonFromString(cell(trades.get(), row, 1));
-        const auto request = jsonFromString(cell(trades.get(), row, 2));
-        const auto requestName = jsonString(request, "name", cell(trades.get(), row, 3).empty() ? "return" : cell(trades.get(), row, 3));
-        items.append(feedItem("Trade " + status,
-                              status + ": " + jsonString(offer, "name", "player") + " for " + requestName,
-                              cell(trades.get(), row, 5),
-                              cell(trades.get(), row, 4),
-                              "Trade"));
-    }
-
-    auto matchups = execParams(conn.get(),
-                               "SELECT week, home_manager_email, COALESCE(away_manager_email, ''), home_score, away_score, "
-                               "COALESCE(to_char(COALESCE(finalized_at, updated_at) AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), '') "
-                               "FROM league_matchups WHERE league_id = $1 AND status = 'final' ORDER BY COALESCE(finalized_at, updated_at) DESC LIMIT 100",
-                               {leagueId});
-    if (!resultOk(matchups.get(), PGRES_TUPLES_OK)) return std::nullopt;
-    double highScore = -1.0;
-    double lowScore = 1000000.0;
-    double largestMargin = -1.0;
-    std::string highManager;
-    std::string lowManager;
-    std::string marginWinner;
-    std::string marginLoser;
-    std::string awardsAt;
-    for (int row = 0; row < PQntuples(matchups.get()); ++row) {
-        const auto home = cell(matchups.get(), row, 1);
-        const auto away = cell(matchups.get(), row, 2);
-        const auto homeScore = std::stod(cell(matchups.get(), row, 3).empty() ? "0" : cell(matchups.get(), row, 3));
-        const auto awayScore = std::stod(cell(matchups.get(), row, 4).empty() ? "0" : cell(matchups.get(), row, 4));
-        const auto winner = homeScore >= awayScore ? home : away;
-        const auto loser = homeScore >= awayScore ? away : home;
-        const auto winnerScore = std::max(homeScore, awayScore);
-        const auto loserScore = std::min(homeScore, awayScore);
-        std::ostringstream finalSummary;
-        finalSummary << winner << " beat " << loser << " " << std::fixed << std::setprecision(1) << winnerScore << "-" << loserScore << ".";
-        items.append(feedItem("Final Score", finalSummary.str(), cell(matchups.get(), row, 5), winner, "Final"));
-        awardsAt = awardsAt.empty() ? cell(matchups.get(), row, 5) : awardsAt;
-        if (homeScore > highScore) { highScore = homeScore; highManager = home; }
-        if (awayScore > highScore) { highScore = awayScore; highManager = away; }
-        if (homeScore < lowScore) { lowScore = homeScore; lowManager = home; }
-        if (awayScore < lowScore) { lowScore = awayScore; lowManager = away; }
-        if (winnerScore - loserScore > largestMargin) {
-            largestMargin = winnerScore - loserScore;
-            marginWinner = winner;
-            marginLoser = loser;
-        }
-    }
-    if (!highManager.empty()) {
-        std::ostringstream highSummary;
-        highSummary << highManager << " posted the high score with " << std::fixed << std::setprecision(1) << highScore << " points.";
-        items.append(feedItem("Weekly Award", highSummary.str(), awardsAt, highManager, "Highest Score"));
+    for (int row = 0; row < PQntuples(events.get()); ++row) {
+        auto item = feedItem(cell(events.get(), row, 1), cell(events.get(), row, 2), cell(events.get(), row, 5),
+                             cell(events.get(), row, 3), cell(events.get(), row, 4));
+        item["cursor"] = cell(events.get(), row, 0);
+        items.append(item);
     }
-    if (!lowManager.empty()) {
-        std::ostringstream lowSummary;
-        lowSummary << lowManager << " survived the lowest score at " << std::fixed << std::setprecision(1) << lowScore << " points.";
-        items.append(feedItem("Weekly Award", lowSummary.str(), awardsAt, lowManager, "Lowest Score"));
-    }
-    if (!marginWinner.empty() && largestMargin > 0) {
-        std::ostringstream marginSummary;
-        marginSummary << marginWinner << " won by " << std::fixed << std::setprecision(1) << largestMargin << " points over " << marginLoser << ".";
-        items.append(feedItem("Weekly Award", marginSummary.str(), awardsAt, marginWinner, "Largest Margin"));
-    }
-
-    sortFeedItems(items);
     return items;
 }
 
@@ -2405,26 +2346,34 @@ std::optional<Json::Value> dbSaveMatchups(PGconn *conn,
     if (dbWeekFinalized(conn, leagueId, week)) return std::nullopt;
     auto clear = execParams(conn, "DELETE FROM league_matchups WHERE league_id = $1 AND week = $2::int", {leagueId, std::to_string(week)});
     if (!resultOk(clear.get(), PGRES_COMMAND_OK)) return std::nullopt;
+    if (matchups.empty()) return matchups;
+    // One statement for the whole week; scores travel as text so numeric
+    // rounding matches the old per-row inserts.
+    Json::Value rows(Json::arrayValue);
     for (const auto &matchup : matchups) {
-        auto insert = execParams(conn,
-                                 "INSERT INTO league_matchups (id, league_id, week, home_manager_email, away_manager_email, home_score, away_score, status) "
-                                 "VALUES ($1, $2, $3::int, $4, NULLIF($5, ''), $6::numeric, $7::numeric, $8)",
-                                 {jsonString(matchup, "id"), leagueId, std::to_string(week),
-                                  jsonString(matchup, "homeManager"), jsonString(matchup, "awayManager"),
-                                  std::to_string(matchup["homeScore"].asDouble()), std::to_string(matchup["awayScore"].asDouble()),
-                                  status});
-        if (!resultOk(insert.get(), PGRES_COMMAND_OK)) return std::nullopt;
-    }
+        Json::Value row(Json::objectValue);
+        row["id"] = jsonString(matchup, "id");
+        row["home_manager_email"] = jsonString(matchup, "homeManager");
+        row["away_manager_email"] = jsonString(matchup, "awayManager");
+        row["home_score"] = std::to_string(matchup["homeScore"].asDouble());
+        row["away_score"] = std::to_string(matchup["awayScore"].asDouble());
+        rows.append(row);
+    }
+    auto insert = execParams(conn,
+                             "INSERT INTO league_matchups (id, league_id, week, home_manager_email, away_manager_email, home_score, away_score, status) "
+                             "SELECT m.id, $1, $2::int, m.home_manager_email, NULLIF(m.away_manager_email, ''), "
+                             "m.home_score::numeric, m.away_score::numeric, $4 "
+                             "FROM jsonb_to_recordset($3::jsonb) "
+                             "AS m(id text, home_manager_email text, away_manager_email text, home_score text, away_score text)",
+                             {leagueId, std::to_string(week), jsonToString(rows), status});
+    if (!resultOk(insert.get(), PGRES_COMMAND_OK)) return std::nullopt;
     return matchups;
 }
 
-std::optional<Json::Value> dbGenerateMatchups(const std::string &accountEmail, const std::string &leagueId, int week = 1) {
-    if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
-    auto conn = connectToDb();
-    if (!conn) return std::nullopt;
-    if (dbWeekFinalized(conn.get(), leagueId, week)) return std::nullopt;
-    auto members = membersForLeague(conn.get(), leagueId);
-    auto matchups = cff::league_schedule::buildMatchups(members, leagueId, week, [conn = conn.get(), &leagueId](const std::string &managerEmail) {
+std::optional<Json::Value> dbGenerateMatchups(PGconn *conn, const std::string &accountEmail, const std::string &leagueId, int week = 1) {
+    if (dbWeekFinalized(conn, leagueId, week)) return std::nullopt;
+    auto members = membersForLeague(conn, leagueId);
+    auto matchups = cff::league_schedule::buildMatchups(members, leagueId, week, [conn, &leagueId](const std::string &managerEmail) {
         return dbProjectedScore(conn, leagueId, managerEmail);
     });
     int matchupIndex = 1;
@@ -2432,11 +2381,18 @@ std::optional<Json::Value> dbGenerateMatchups(const std::string &accountEmail, c
         matchup["week"] = week;
         matchup["id"] = leagueId + "-week-" + std::to_string(week) + "-" + std::to_string(matchupIndex++);
     }
-    if (!dbSaveMatchups(conn.get(), leagueId, week, matchups)) return std::nullopt;
-    dbAddTransaction(conn.get(), leagueId, "Schedule", "Generated week " + std::to_string(week) + " matchups", accountEmail, Json::Value{Json::objectValue});
+    if (!dbSaveMatchups(conn, leagueId, week, matchups)) return std::nullopt;
+    dbAddTransaction(conn, leagueId, "Schedule", "Generated week " + std::to_string(week) + " matchups", accountEmail, Json::Value{Json::objectValue});
     return matchups;
 }
 
+std::optional<Json::Value> dbGenerateMatchups(const std::string &accountEmail, const std::string &leagueId, int week = 1) {
+    if (!dbCanAccessLeague(accountEmail, leagueId)) return std::nullopt;
+    auto conn = connectToDb();
+    if (!conn) return std::nullopt;
+    return dbGenerateMatchups(conn.get(), accountEmail, leagueId, week);
+}
+
 std::optional<Json::Value> dbGenerateSeasonSchedule(const std::string &accountEmail,
                                                     const std::string &leagueId,
                                                     int weeks) {
@@ -2480,13 +2436,13 @@ std::optional<Json::Value> dbListMatchups(const std::string &accountEmail, const
                              {leagueId});
     if (!resultOk(result.get(), PGRES_TUPLES_OK)) return std::nullopt;
     if (PQntuples(result.get()) == 0) {
-        return dbGenerateMatchups(accountEmail, leagueId);
+        return dbGenerateMatchups(conn.get(), accountEmail, leagueId);
     }
     return matchupsFromResult(result.get());
 }
 
 std::optional<Json::Value> dbLineupErrors(PGconn *conn, const std::string &leagueId) {
-    auto rules = dbRosterRules(leagueId).value_or(Json::Value{Json::objectValue});
+    auto rules = dbRosterRules(conn, leagueId).value_or(Json::Value{Json::objectValue});
     auto members = membersForLeague(conn, leagueId);
     Json::Value errors(Json::arrayValue);
     for (const auto &member : members) {
@@ -2529,7 +2485,8 @@ std::optional<Json::Value> dbScoreWeek(const std::string &accountEmail,
     if (!resultOk(settingsResult.get(), PGRES_TUPLES_OK) || PQntuples(settingsResult.get()) == 0) {
         return std::nullopt;
     }
-    const auto settings = jsonFromString(cell(settingsResult.get(), 0, 0));
+    const auto scoring = cff::scoring_lifecycle::compiledScoringFor(
+        leagueId, jsonFromString(cell(settingsResult.get(), 0, 0)));
     auto statsResult = execParams(conn.get(),
                                   "SELECT r.manager_email, r.player_id, r.player_snapshot::text, "
                                   "COALESCE(ps.category, ''), COALESCE(ps.stat_name, ''), COALESCE(ps.stat_value, 0) "
@@ -2561,26 +2518,25 @@ std::optional<Json::Value> dbScoreWeek(const std::string &accountEmail,
         const auto value = rawValue.empty() ? 0.0 : std::stod(rawValue);
         if (!category.empty() && !statName.empty()) {
             playerStats[key][category + "." + statName] = value;
-            const auto points = fantasyPointsForStat(settings, category, statName, value);
+            const auto points = scoring->points(cff::scoring_lifecycle::internStat(category, statName), value);
             playerTotals[key] += points;
             managerTotals[manager] += points;
         }
     }
 
     Json::Value scores(Json::arrayValue);
+    Json::Value rows(Json::arrayValue);
     for (const auto &entry : playerManagers) {
         const auto &key = entry.first;
         const auto &manager = entry.second;
         const auto &playerId = playerIds[key];
         const auto points = playerTotals[key];
-        auto upsert = execParams(conn.get(),
-                                 "INSERT INTO fantasy_player_scores (league_id, manager_email, player_id, season, week, fantasy_points, stats, updated_at) "
-                                 "VALUES ($1, $2, $3, $4::int, $5::int, $6::numeric, $7::jsonb, NOW()) "
-                                 "ON CONFLICT (league_id, manager_email, player_id, season, week) "
-                                 "DO UPDATE SET fantasy_points = EXCLUDED.fantasy_points, stats = EXCLUDED.stats, updated_at = NOW()",
-                                 {leagueId, manager, playerId, std::to_string(season), std::to_string(week),
-                                  std::to_string(points), jsonToString(playerStats[key])});
-        if (!resultOk(upsert.get(), PGRES_COMMAND_OK)) return std::nullopt;
+        Json::Value row(Json::objectValue);
+        row["manager_email"] = manager;
+        row["player_id"] = playerId;
+        row["fantasy_points"] = std::to_string(points);
+        row["stats"] = playerStats[key];
+        rows.append(row);
         Json::Value score;
         score["managerEmail"] = manager;
         score["playerId"] = playerId;
@@ -2588,6 +2544,20 @@ std::optional<Json::Value> dbScoreWeek(const std::string &accountEmail,
         score["stats"] = playerStats[key];
         scores.append(score);
     }
+    // Every rostered player is upserted by one statement rather than one
+    // round-trip each.
+    if (!rows.empty()) {
+        auto upsert = execParams(conn.get(),
+                                 "INSERT INTO fantasy_player_scores (league_id, manager_email, player_id, season, week, fantasy_points, stats, updated_at) "
+                                 "SELECT $1, s.manager_email, s.player_id, $2::int, $3::int, s.fantasy_points::numeric, "
+                                 "COALESCE(s.stats, '{}'::jsonb), NOW() "
+                                 "FROM jsonb_to_recordset($4::jsonb) "
+                                 "AS s(manager_email text, player_id text, fantasy_points text, stats jsonb) "
+                                 "ON CONFLICT (league_id, manager_email, player_id, season, week) "
+                                 "DO UPDATE SET fantasy_points = EXCLUDED.fantasy_points, stats = EXCLUDED.stats, updated_at = NOW()",
+                                 {leagueId, std::to_string(season), std::to_string(week), jsonToString(rows)});
+        if (!resultOk(upsert.get(), PGRES_COMMAND_OK)) return std::nullopt;
+    }
 
     auto members = membersForLeague(conn.get(), leagueId);
     auto matchups = cff::league_schedule::buildMatchups(members, leagueId, week, [&managerTotals](const std::string &managerEmail) {
@@ -2628,12 +2598,35 @@ std::optional<Json::Value> dbFinalizeWeek(const std::string &accountEmail,
     if (!resultOk(existing.get(), PGRES_TUPLES_OK) || cellInt(existing.get(), 0, 0, 0) == 0) {
         return std::nullopt;
     }
+    // The week only becomes final together with its feed awards.
+    auto begin = execParams(conn.get(), "BEGIN", {});
+    if (!resultOk(begin.get(), PGRES_COMMAND_OK)) return std::nullopt;
+    const auto rollback = [&conn] { execParams(conn.get(), "ROLLBACK", {}); };
     auto update = execParams(conn.get(),
                              "UPDATE league_matchups SET status = 'final', finalized_at = COALESCE(finalized_at, NOW()), updated_at = NOW() "
                              "WHERE league_id = $1 AND week = $2::int",
                              {leagueId, std::to_string(week)});
-    if (!resultOk(update.get(), PGRES_COMMAND_OK)) return std::nullopt;
-    dbAddTransaction(conn.get(), leagueId, "Scoring Finalized", "Finalized week " + std::to_string(week), accountEmail, Json::Value{Json::objectValue});
+    if (!resultOk(update.get(), PGRES_COMMAND_OK)) {
+        rollback();
+        return std::nullopt;
+    }
+    auto awards = execParams(conn.get(),
+                             "SELECT cff_append_weekly_awards($1, seasons.season, $2::int) "
+                             "FROM (SELECT DISTINCT season FROM league_matchups WHERE league_id = $1 AND week = $2::int) AS seasons",
+                             {leagueId, std::to_string(week)});
+    if (!resultOk(awards.get(), PGRES_TUPLES_OK)) {
+        rollback();
+        return std::nullopt;
+    }
+    if (!dbAddTransaction(conn.get(), leagueId, "Scoring Finalized", "Finalized week " + std::to_string(week), accountEmail, Json::Value{Json::objectValue})) {
+        rollback();
+        return std::nullopt;
+    }
+    auto commit = execParams(conn.get(), "COMMIT", {});
+    if (!resultOk(commit.get(), PGRES_COMMAND_OK)) {
+        rollback();
+        return std::nullopt;
+    }
     auto result = execParams(conn.get(),
                              "SELECT id, week, home_manager_email, COALESCE(away_manager_email, ''), home_score, away_score, status, "
                              "COALESCE(to_char(created_at AT TIME ZONE 'UTC', 'YYYY-MM-DD\"T\"HH24:MI:SS\"Z\"'), ''), "
@@ -3088,11 +3081,13 @@ void handleAddRosterPlayer(const drogon::HttpRequestPtr &req,
             sendError(callback, drogon::k409Conflict, "Lineups are locked after finalized matchups");
             return;
         }
-        const auto waiverRules = dbWaiverRules(leagueId).value_or(Json::Value{Json::objectValue});
+        const auto waiverRules = dbWaiverRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
         if (cff::league_waiver::modeActive(waiverRules)) {
             sendError(callback, drogon::k409Conflict, "Free agency is locked. Submit a waiver claim.");
             return;
         }
+        // The mutation takes its own pooled connection; return this one first.
+        conn.reset();
         auto roster = dbAddRosterPlayer(accountEmail, leagueId, playerPayload);
         if (!roster) {
             sendError(callback, drogon::k404NotFound, "League not found");
@@ -3145,6 +3140,7 @@ void handleDropRosterPlayer(const drogon::HttpRequestPtr &req,
             sendError(callback, drogon::k409Conflict, "Player is locked in a pending trade");
             return;
         }
+        conn.reset();
         auto roster = dbDropRosterPlayer(accountEmail, leagueId, playerId);
         if (!roster) {
             sendError(callback, drogon::k404NotFound, "League not found");
@@ -3193,6 +3189,7 @@ void handleUpdateRosterSlot(const drogon::HttpRequestPtr &req,
             sendError(callback, drogon::k409Conflict, "Lineups are locked after finalized matchups");
             return;
         }
+        conn.reset();
         auto roster = dbUpdateRosterSlot(accountEmail, leagueId, playerId, requestedSlot);
         if (!roster) {
             sendError(callback, drogon::k404NotFound, "Player roster entry not found");
@@ -3556,10 +3553,11 @@ void handleCreateWaiver(const drogon::HttpRequestPtr &req,
 #ifdef CFF_HAS_POSTGRES
     if (dbConfigured()) {
         auto conn = connectToDb();
-        if (conn && dbCanAccessLeague(accountEmail, leagueId) && dbLineupLocked(conn.get(), leagueId)) {
+        if (conn && dbCanAccessLeague(conn.get(), accountEmail, leagueId) && dbLineupLocked(conn.get(), leagueId)) {
             sendError(callback, drogon::k409Conflict, "Waivers are locked after finalized matchups");
             return;
         }
+        conn.reset();
         auto claim = dbCreateWaiver(accountEmail, leagueId, *body);
         if (!claim) {
             sendError(callback, drogon::k404NotFound, "League not found");
@@ -3613,15 +3611,16 @@ void handleProcessWaiver(const drogon::HttpRequestPtr&,
 #ifdef CFF_HAS_POSTGRES
     if (dbConfigured()) {
         auto conn = connectToDb();
-        if (conn && dbCanAccessLeague(accountEmail, leagueId) && dbLineupLocked(conn.get(), leagueId)) {
+        if (conn && dbCanAccessLeague(conn.get(), accountEmail, leagueId) && dbLineupLocked(conn.get(), leagueId)) {
             sendError(callback, drogon::k409Conflict, "Waivers are locked after finalized matchups");
             return;
         }
-        const auto waiverRules = dbWaiverRules(leagueId).value_or(Json::Value{Json::objectValue});
+        const auto waiverRules = dbWaiverRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
         if (!cff::league_waiver::deadlinePassed(waiverRules)) {
             sendError(callback, drogon::k409Conflict, "Waiver deadline has not passed yet");
             return;
         }
+        conn.reset();
         auto claim = dbProcessWaiver(accountEmail, leagueId, claimId);
         if (!claim) {
             sendError(callback, drogon::k404NotFound, "Waiver claim not found");
@@ -3765,15 +3764,16 @@ void handleProcessWaivers(const drogon::HttpRequestPtr&,
 #ifdef CFF_HAS_POSTGRES
     if (dbConfigured()) {
         auto conn = connectToDb();
-        if (conn && dbCanAccessLeague(accountEmail, leagueId) && dbLineupLocked(conn.get(), leagueId)) {
+        if (conn && dbCanAccessLeague(conn.get(), accountEmail, leagueId) && dbLineupLocked(conn.get(), leagueId)) {
             sendError(callback, drogon::k409Conflict, "Waivers are locked after finalized matchups");
             return;
         }
-        const auto waiverRules = dbWaiverRules(leagueId).value_or(Json::Value{Json::objectValue});
+        const auto waiverRules = dbWaiverRules(conn.get(), leagueId).value_or(Json::Value{Json::objectValue});
         if (!cff::league_waiver::deadlinePassed(waiverRules)) {
             sendError(callback, drogon::k409Conflict, "Waiver deadline has not passed yet");
             return;
         }
+        conn.reset();
         auto result = dbProcessWaivers(accountEmail, leagueId);
         if (!result) {
             sendError(callback, drogon::k403Forbidden, "Commissioner access required");
@@ -3925,6 +3925,7 @@ void handleCreateTrade(const drogon::HttpRequestPtr &req,
             sendError(callback, drogon::k409Conflict, "Trades are locked after finalized matchups");
             return;
         }
+        conn.reset();
         auto trade = dbCreateTrade(accountEmail, leagueId, *body);
         if (!trade) {
             sendError(callback, drogon::k403Forbidden, "Trade target must be an active league manager");
@@ -4099,18 +4100,34 @@ void handleListTransactions(const drogon::HttpRequestPtr&,
     callback(jsonResponse(arrayForLeague(transactionsByLeague, leagueId), drogon::k200OK));
 }
 
-void handleListLeagueFeed(const drogon::HttpRequestPtr&,
+void handleListLeagueFeed(const drogon::HttpRequestPtr &req,
                           std::function<void (const drogon::HttpResponsePtr &)> &&callback,
                           const std::string &accountEmail,
                           const std::string &leagueId) {
 #ifdef CFF_HAS_POSTGRES
     if (dbConfigured()) {
-        auto feed = dbListLeagueFeed(accountEmail, leagueId);
+        constexpr int kMaxFeedPage = 100;
+        const auto before = req->getParameter("before");
+        const auto limitParam = req->getParameter("limit");
+        if (before.size() > 18 || before.find_first_not_of("0123456789") != std::string::npos) {
+            sendError(callback, drogon::k400BadRequest, "Feed cursor must be a cursor from a previous page");
+            return;
+        }
+        char *end = nullptr;
+        const auto requested = std::strtoul(limitParam.c_str(), &end, 10);
+        const auto limit = limitParam.empty() || end == limitParam.c_str() || *end != '\0' || requested == 0
+            ? kMaxFeedPage
+            : static_cast<int>(std::min<unsigned long>(requested, kMaxFeedPage));
+        auto feed = dbListLeagueFeed(accountEmail, leagueId, before, limit);
         if (!feed) {
             sendError(callback, drogon::k404NotFound, "League not found");
             return;
         }
-        callback(jsonResponse(*feed, drogon::k200OK));
+        auto response = jsonResponse(*feed, drogon::k200OK);
+        if (static_cast<int>(feed->size()) == limit) {
+            response->addHeader("X-CFF-Next-Cursor", jsonString((*feed)[feed->size() - 1], "cursor"));
+        }
+        callback(response);
         return;
     }
 #endif
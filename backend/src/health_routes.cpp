@@ -11,6 +11,8 @@
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 namespace cff::health {
@@ -22,15 +24,7 @@ bool emailDeliveryReady() {
 }
 
 #ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *conn) const {
-        if (conn) {
-            PQfinish(conn);
-        }
-    }
-};
-
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 
 bool databaseConfigured() {
     const auto url = cff::config::readEnv("DB_URL");
@@ -38,18 +32,7 @@ bool databaseConfigured() {
 }
 
 PgConnPtr connectToDatabase() {
-    const auto url = cff::config::readEnv("DB_URL");
-    if (!url || url->empty()) {
-        return nullptr;
-    }
-
-    auto conn = PgConnPtr{PQconnectdb(url->c_str())};
-    if (PQstatus(conn.get()) != CONNECTION_OK) {
-        std::cerr << "[auth] Failed to connect to Postgres: "
-                  << PQerrorMessage(conn.get()) << std::endl;
-        return nullptr;
-    }
-    return conn;
+    return cff::db::acquireConnection();
 }
 #endif
 
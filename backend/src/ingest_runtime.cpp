@@ -1,17 +1,41 @@
 #include "ingest_runtime.h"
 
+#include <algorithm>
 #include <chrono>
+#include <ctime>
+#include <exception>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <thread>
 #include <utility>
 
 namespace cff::ingest_runtime {
+namespace {
+
+std::string isoTimestamp(std::chrono::system_clock::time_point value) {
+    if (value == std::chrono::system_clock::time_point{}) return "";
+    const auto raw = std::chrono::system_clock::to_time_t(value);
+    std::tm utc{};
+    gmtime_r(&raw, &utc);
+    std::ostringstream output;
+    output << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+    return output.str();
+}
+
+std::string resultState(const cff::IngestResult &result) {
+    if (result.cancelled) return "cancelled";
+    return result.errors.empty() ? "ok" : "partial";
+}
+
+} // namespace
 
 void logIngestResult(const std::string &label,
                      const cff::IngestResult &result,
                      std::ostream &output,
                      std::ostream &errors) {
-    output << "[cfbd] " << label << " complete. inserted=" << result.ingested
+    output << "[cfbd] " << label << (result.cancelled ? " cancelled." : " complete.")
+           << " inserted=" << result.ingested
            << " updated=" << result.updated
            << " api_calls=" << result.apiCalls << std::endl;
     for (const auto &error : result.errors) {
@@ -70,4 +94,102 @@ void configureCfbdIngest(bool ingestOnStartup,
     }).detach();
 }
 
+IngestJobs::IngestJobs(ProgressRunner runner, std::size_t history)
+    : runner_(std::move(runner)), history_(std::max<std::size_t>(1, history)) {}
+
+IngestJobs::~IngestJobs() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) running_->progress.cancelRequested.store(true);
+        worker = std::move(worker_);
+    }
+    if (worker.joinable()) worker.join();
+}
+
+IngestJobs::Started IngestJobs::start(const std::string &requestedBy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return Started{running_->id, false};
+    // The previous worker has cleared running_ and is only returning.
+    if (worker_.joinable()) worker_.join();
+
+    auto job = std::make_shared<Job>();
+    job->id = "cfbd-" + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+                  std::chrono::system_clock::now().time_since_epoch()).count())
+              + "-" + std::to_string(++sequence_);
+    job->requestedBy = requestedBy;
+    job->startedAt = std::chrono::system_clock::now();
+    jobs_.push_back(job);
+    while (jobs_.size() > history_) jobs_.pop_front();
+    running_ = job;
+    worker_ = std::thread([this, job]() { run(job); });
+    return Started{job->id, true};
+}
+
+void IngestJobs::run(std::shared_ptr<Job> job) {
+    cff::IngestResult result;
+    try {
+        result = runner_(job->progress);
+    } catch (const std::exception &error) {
+        result.errors.push_back(std::string{"Ingest failed: "} + error.what());
+    } catch (...) {
+        result.errors.push_back("Ingest failed with an unknown error.");
+    }
+    logIngestResult("admin ingest " + job->id, result, std::cout, std::cerr);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job->progress.phase.store(cff::IngestPhase::Finished);
+        job->finishedAt = std::chrono::system_clock::now();
+        job->result = std::move(result);
+        running_.reset();
+    }
+    idle_.notify_all();
+}
+
+IngestJobSnapshot IngestJobs::snapshotLocked(const Job &job) const {
+    const auto &progress = job.progress;
+    IngestJobSnapshot snapshot;
+    snapshot.id = job.id;
+    snapshot.phase = cff::ingestPhaseName(progress.phase.load());
+    snapshot.state = job.result ? resultState(*job.result)
+        : progress.phase.load() == cff::IngestPhase::Queued ? "queued" : "running";
+    snapshot.requestedBy = job.requestedBy;
+    snapshot.startedAt = isoTimestamp(job.startedAt);
+    snapshot.finishedAt = isoTimestamp(job.finishedAt);
+    snapshot.cancelRequested = progress.cancelled();
+    snapshot.apiCalls = progress.apiCalls.load();
+    snapshot.teamsExpected = progress.teamsExpected.load();
+    snapshot.teamsFetched = progress.teamsFetched.load();
+    snapshot.rowsStaged = progress.rowsStaged.load();
+    snapshot.rowsMerged = progress.rowsMerged.load();
+    snapshot.result = job.result;
+    return snapshot;
+}
+
+std::optional<IngestJobSnapshot> IngestJobs::find(const std::string &id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &job : jobs_) {
+        if (job->id == id) return snapshotLocked(*job);
+    }
+    return std::nullopt;
+}
+
+std::optional<IngestJobSnapshot> IngestJobs::latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jobs_.empty()) return std::nullopt;
+    return snapshotLocked(*jobs_.back());
+}
+
+bool IngestJobs::cancel(const std::string &id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_ || running_->id != id) return false;
+    running_->progress.cancelRequested.store(true);
+    return true;
+}
+
+void IngestJobs::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return !running_; });
+}
+
 } // namespace cff::ingest_runtime
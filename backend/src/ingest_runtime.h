@@ -3,14 +3,23 @@
 #include "cfbd_ingest.h"
 
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
+#include <string>
+#include <thread>
 
 namespace cff::ingest_runtime {
 
 using IngestRunner = std::function<cff::IngestResult()>;
 using SleepFunction = std::function<void(std::chrono::hours)>;
+using ProgressRunner = std::function<cff::IngestResult(cff::IngestProgress &)>;
 
 void logIngestResult(const std::string &label,
                      const cff::IngestResult &result,
@@ -32,4 +41,74 @@ void configureCfbdIngest(bool ingestOnStartup,
                          const std::optional<int> &intervalHours,
                          IngestRunner runner);
 
+// A point-in-time copy of one admin-triggered ingest. `state` is queued or
+// running until the runner returns, then ok, partial or cancelled; `result`
+// is set from then on.
+struct IngestJobSnapshot {
+    std::string id;
+    std::string state;
+    std::string phase;
+    std::string requestedBy;
+    std::string startedAt;
+    std::string finishedAt;
+    bool cancelRequested{false};
+    std::size_t apiCalls{0};
+    std::size_t teamsExpected{0};
+    std::size_t teamsFetched{0};
+    std::size_t rowsStaged{0};
+    std::size_t rowsMerged{0};
+    std::optional<cff::IngestResult> result;
+};
+
+// Runs admin-triggered ingests on a background thread, one at a time, so the
+// request that starts one returns at once and the outcome survives the client
+// going away. The newest `history` jobs stay queryable by id; older outcomes
+// remain in ingestion_runs.
+class IngestJobs {
+public:
+    struct Started {
+        std::string id;
+        // False when a job was already running; `id` is that job.
+        bool created{false};
+    };
+
+    explicit IngestJobs(ProgressRunner runner, std::size_t history = 10);
+    // Cancels the running job and waits for it to stop.
+    ~IngestJobs();
+
+    IngestJobs(const IngestJobs &) = delete;
+    IngestJobs &operator=(const IngestJobs &) = delete;
+
+    Started start(const std::string &requestedBy);
+    std::optional<IngestJobSnapshot> find(const std::string &id) const;
+    std::optional<IngestJobSnapshot> latest() const;
+    // Asks the running job to stop at its next checkpoint. False when the id
+    // is unknown or the job already finished.
+    bool cancel(const std::string &id);
+    // Blocks until no job is running.
+    void wait();
+
+private:
+    struct Job {
+        std::string id;
+        std::string requestedBy;
+        std::chrono::system_clock::time_point startedAt;
+        std::chrono::system_clock::time_point finishedAt;
+        cff::IngestProgress progress;
+        std::optional<cff::IngestResult> result;
+    };
+
+    void run(std::shared_ptr<Job> job);
+    IngestJobSnapshot snapshotLocked(const Job &job) const;
+
+    ProgressRunner runner_;
+    std::size_t history_;
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    std::shared_ptr<Job> running_;
+    std::thread worker_;
+    std::uint64_t sequence_{0};
+};
+
 } // namespace cff::ingest_runtime
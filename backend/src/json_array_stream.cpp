@@ -0,0 +1,98 @@
+#include "json_array_stream.h"
+
+#include <cctype>
+#include <utility>
+
+namespace cff::json_stream {
+namespace {
+
+bool isSpace(char ch) {
+    return std::isspace(static_cast<unsigned char>(ch)) != 0;
+}
+
+} // namespace
+
+ArraySplitter::ArraySplitter(ElementHandler onElement) : onElement_(std::move(onElement)) {}
+
+bool ArraySplitter::fail(std::string message) {
+    state_ = State::Failed;
+    error_ = std::move(message);
+    element_.clear();
+    element_.shrink_to_fit();
+    return false;
+}
+
+void ArraySplitter::emit() {
+    while (!element_.empty() && isSpace(element_.back())) element_.pop_back();
+    ++elements_;
+    onElement_(element_);
+    element_.clear();
+}
+
+bool ArraySplitter::feed(std::string_view chunk) {
+    for (const char ch : chunk) {
+        switch (state_) {
+        case State::Failed:
+            return false;
+        case State::BeforeArray:
+            if (isSpace(ch)) continue;
+            if (ch != '[') return fail("expected a JSON array");
+            state_ = State::BeforeElement;
+            afterComma_ = false;
+            continue;
+        case State::BeforeElement:
+            if (isSpace(ch)) continue;
+            if (ch == ']') {
+                if (afterComma_) return fail("trailing comma in array");
+                state_ = State::AfterArray;
+                continue;
+            }
+            if (ch == ',') return fail("missing array element");
+            state_ = State::InElement;
+            break;
+        case State::InElement:
+            break;
+        case State::AfterArray:
+            if (isSpace(ch)) continue;
+            return fail("unexpected data after the array");
+        }
+
+        // InElement: only a comma or bracket outside strings at depth zero
+        // ends the element.
+        if (inString_) {
+            element_.push_back(ch);
+            if (escaped_) {
+                escaped_ = false;
+            } else if (ch == '\\') {
+                escaped_ = true;
+            } else if (ch == '"') {
+                inString_ = false;
+            }
+            continue;
+        }
+        if (depth_ == 0 && (ch == ',' || ch == ']')) {
+            emit();
+            afterComma_ = ch == ',';
+            state_ = ch == ',' ? State::BeforeElement : State::AfterArray;
+            continue;
+        }
+        if (ch == '"') {
+            inString_ = true;
+        } else if (ch == '{' || ch == '[') {
+            ++depth_;
+        } else if (ch == '}' || ch == ']') {
+            if (depth_ == 0) return fail("unbalanced brackets in array element");
+            --depth_;
+        }
+        element_.push_back(ch);
+    }
+    return state_ != State::Failed;
+}
+
+bool ArraySplitter::finish() {
+    if (state_ == State::AfterArray) return true;
+    if (state_ != State::Failed) fail(state_ == State::BeforeArray ? "empty response" : "truncated array");
+    return false;
+}
+
+} // namespace cff::json_stream
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace cff::json_stream {
+
+// Splits a top-level JSON array into its element texts as bytes arrive, so a
+// large CFBD response is handled one element at a time instead of being
+// buffered and parsed into a full document. Only the element in progress is
+// held in memory.
+//
+// The splitter tracks strings, escapes and nesting but does not validate the
+// element bodies; callers parse each element with their JSON library.
+class ArraySplitter {
+public:
+    using ElementHandler = std::function<void(std::string_view element)>;
+
+    explicit ArraySplitter(ElementHandler onElement);
+
+    // Consumes the next chunk; returns false once the input is known not to
+    // be a single JSON array. Later chunks are then ignored.
+    bool feed(std::string_view chunk);
+
+    // True when a complete array (and only whitespace after it) was read.
+    bool finish();
+
+    std::size_t elements() const { return elements_; }
+    const std::string &error() const { return error_; }
+
+private:
+    enum class State { BeforeArray, BeforeElement, InElement, AfterArray, Failed };
+
+    bool fail(std::string message);
+    void emit();
+
+    ElementHandler onElement_;
+    State state_{State::BeforeArray};
+    std::string element_;
+    std::size_t depth_{0};
+    std::size_t elements_{0};
+    bool inString_{false};
+    bool escaped_{false};
+    bool afterComma_{false};
+    std::string error_;
+};
+
+} // namespace cff::json_stream
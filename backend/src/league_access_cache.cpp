@@ -0,0 +1,182 @@
+#include "league_access_cache.h"
+
+#include "app_config.h"
+
+#ifdef CFF_HAS_POSTGRES
+#include "db_statements.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace cff::league_access {
+namespace {
+
+std::string lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return value;
+}
+
+MembershipCacheSettings loadSettings() {
+    MembershipCacheSettings settings;
+    settings.capacity = cff::config::readSizeEnv("CFF_LEAGUE_ACCESS_CACHE_CAPACITY", 50000, 1000000);
+    settings.ttl = std::chrono::seconds{
+        cff::config::readSizeEnv("CFF_LEAGUE_ACCESS_CACHE_TTL_SECONDS", 30, 600)};
+    return settings;
+}
+
+} // namespace
+
+MembershipCache::MembershipCache(MembershipCacheSettings settings)
+    : settings_(settings),
+      shardCapacity_(std::max<std::size_t>(1, (settings.capacity + kShards - 1) / kShards)) {}
+
+MembershipCache::Shard &MembershipCache::shardFor(const std::string &leagueId) {
+    return shards_[std::hash<std::string>{}(leagueId) % kShards];
+}
+
+std::optional<Membership> MembershipCache::find(const std::string &leagueId,
+                                                const std::string &email,
+                                                Clock::time_point now) {
+    auto &shard = shardFor(leagueId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto league = shard.leagues.find(leagueId);
+    if (league == shard.leagues.end()) return std::nullopt;
+    const auto entry = league->second.find(lower(email));
+    if (entry == league->second.end()) return std::nullopt;
+    if (entry->second.expiresAt <= now) {
+        league->second.erase(entry);
+        --shard.entries;
+        if (league->second.empty()) shard.leagues.erase(league);
+        return std::nullopt;
+    }
+    return entry->second.membership;
+}
+
+std::uint64_t MembershipCache::generation(const std::string &leagueId) {
+    auto &shard = shardFor(leagueId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.generation;
+}
+
+// Expired entries go first; if the shard is still full, whole leagues are
+// dropped until there is room. Entries are one indexed row each, so losing a
+// few warm ones is cheaper than tracking recency on every hit.
+void MembershipCache::makeRoomLocked(Shard &shard, Clock::time_point now) {
+    for (auto league = shard.leagues.begin(); league != shard.leagues.end();) {
+        auto &members = league->second;
+        for (auto entry = members.begin(); entry != members.end();) {
+            if (entry->second.expiresAt <= now) {
+                entry = members.erase(entry);
+                --shard.entries;
+            } else {
+                ++entry;
+            }
+        }
+        league = members.empty() ? shard.leagues.erase(league) : std::next(league);
+    }
+    while (shard.entries >= shardCapacity_ && !shard.leagues.empty()) {
+        shard.entries -= shard.leagues.begin()->second.size();
+        shard.leagues.erase(shard.leagues.begin());
+    }
+}
+
+bool MembershipCache::store(const std::string &leagueId,
+                            const std::string &email,
+                            const Membership &membership,
+                            std::uint64_t generation,
+                            Clock::time_point now) {
+    auto &shard = shardFor(leagueId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.generation != generation) return false;
+    if (shard.entries >= shardCapacity_) makeRoomLocked(shard, now);
+    const auto [entry, inserted] = shard.leagues[leagueId].try_emplace(lower(email));
+    if (inserted) ++shard.entries;
+    entry->second.membership = membership;
+    entry->second.expiresAt = now + settings_.ttl;
+    return true;
+}
+
+void MembershipCache::invalidate(const std::string &leagueId) {
+    auto &shard = shardFor(leagueId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    ++shard.generation;
+    const auto league = shard.leagues.find(leagueId);
+    if (league == shard.leagues.end()) return;
+    shard.entries -= league->second.size();
+    shard.leagues.erase(league);
+}
+
+std::size_t MembershipCache::size() const {
+    std::size_t total = 0;
+    for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.entries;
+    }
+    return total;
+}
+
+MembershipCache &sharedCache() {
+    static MembershipCache cache{loadSettings()};
+    return cache;
+}
+
+std::optional<Membership> cached(const std::string &leagueId, const std::string &email) {
+    return sharedCache().find(leagueId, email, MembershipCache::Clock::now());
+}
+
+void invalidate(const std::string &leagueId) {
+    sharedCache().invalidate(leagueId);
+}
+
+#ifdef CFF_HAS_POSTGRES
+namespace {
+
+struct PgResultDeleter {
+    void operator()(PGresult *result) const {
+        if (result) PQclear(result);
+    }
+};
+
+using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
+
+const cff::db::Statement kMembership{
+    "league_access.membership",
+    "SELECT lower(l.account_email) = lower($2), COALESCE(l.draft_type, ''), "
+    "COALESCE(lower(lm.role), ''), COALESCE(lower(lm.status), '') "
+    "FROM leagues l LEFT JOIN league_members lm "
+    "ON lm.league_id = l.id AND lower(lm.email) = lower($2) "
+    "WHERE l.id = $1 LIMIT 1",
+    2};
+
+} // namespace
+
+Membership membership(PGconn *connection, const std::string &leagueId, const std::string &email) {
+    auto &cache = sharedCache();
+    if (auto hit = cache.find(leagueId, email, MembershipCache::Clock::now())) return *hit;
+    if (!connection) return {};
+
+    const auto generation = cache.generation(leagueId);
+    PgResultPtr result{cff::db::execPrepared(connection, kMembership, {leagueId, email})};
+    if (!result || PQresultStatus(result.get()) != PGRES_TUPLES_OK) return {};
+
+    Membership loaded;
+    if (PQntuples(result.get()) > 0) {
+        loaded.exists = true;
+        loaded.owner = std::string{PQgetvalue(result.get(), 0, 0)} == "t";
+        const std::string draftType = PQgetvalue(result.get(), 0, 1);
+        if (!draftType.empty()) loaded.draftType = draftType;
+        loaded.role = PQgetvalue(result.get(), 0, 2);
+        loaded.status = PQgetvalue(result.get(), 0, 3);
+    }
+    cache.store(leagueId, email, loaded, generation, MembershipCache::Clock::now());
+    return loaded;
+}
+#endif
+
+} // namespace cff::league_access
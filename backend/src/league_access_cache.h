@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#ifdef CFF_HAS_POSTGRES
+#include <postgresql/libpq-fe.h>
+#endif
+
+namespace cff::league_access {
+
+// One account's standing in one league: whether the league exists, whether
+// the account owns it, and its league_members role and status (empty when it
+// has no row). Role and status are lower-cased.
+struct Membership {
+    bool exists{false};
+    bool owner{false};
+    std::string role;
+    std::string status;
+    std::string draftType{"snake"};
+
+    bool active() const { return status == "active"; }
+    bool member() const { return exists && (owner || active()); }
+    bool commissioner() const { return exists && (owner || (role == "commissioner" && active())); }
+};
+
+struct MembershipCacheSettings {
+    std::size_t capacity{50000};
+    std::chrono::seconds ttl{30};
+};
+
+// (leagueId, email) -> Membership, striped by league so a league's entries
+// share one shard and can be dropped together. Mutations in this process
+// invalidate the league after they commit; `ttl` bounds how long a change
+// made by another instance can go unseen. Each shard counts invalidations,
+// and a load that started before one is not stored, so a lookup racing a
+// member update cannot cache the state it replaced.
+class MembershipCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit MembershipCache(MembershipCacheSettings settings);
+
+    std::optional<Membership> find(const std::string &leagueId,
+                                   const std::string &email,
+                                   Clock::time_point now);
+
+    // Read before loading from the database and handed back to store().
+    std::uint64_t generation(const std::string &leagueId);
+
+    // Returns false when the league was invalidated after `generation`.
+    bool store(const std::string &leagueId,
+               const std::string &email,
+               const Membership &membership,
+               std::uint64_t generation,
+               Clock::time_point now);
+
+    void invalidate(const std::string &leagueId);
+
+    MembershipCacheSettings settings() const { return settings_; }
+    std::size_t size() const;
+
+private:
+    static constexpr std::size_t kShards = 16;
+
+    struct Entry {
+        Membership membership;
+        Clock::time_point expiresAt{};
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::unordered_map<std::string, Entry>> leagues;
+        std::size_t entries{0};
+        std::uint64_t generation{0};
+    };
+
+    Shard &shardFor(const std::string &leagueId);
+    void makeRoomLocked(Shard &shard, Clock::time_point now);
+
+    MembershipCacheSettings settings_;
+    std::size_t shardCapacity_{1};
+    std::array<Shard, kShards> shards_;
+};
+
+// Process-wide cache shared by every league module. Sized by
+// CFF_LEAGUE_ACCESS_CACHE_CAPACITY and CFF_LEAGUE_ACCESS_CACHE_TTL_SECONDS.
+MembershipCache &sharedCache();
+
+std::optional<Membership> cached(const std::string &leagueId, const std::string &email);
+
+// Call after committing any change to a league's owner, draft type or
+// members, including deleting the league.
+void invalidate(const std::string &leagueId);
+
+#ifdef CFF_HAS_POSTGRES
+// Cached lookup that loads one leagues/league_members row on a miss. A failed
+// query returns a non-existent league and is not cached.
+Membership membership(PGconn *connection, const std::string &leagueId, const std::string &email);
+#endif
+
+} // namespace cff::league_access
@@ -12,13 +12,13 @@
 #include <string>
 #include <vector>
 
-namespace {
+#include "db_pool.h"
+#include "free_agent_pool.h"
+#include "league_access_cache.h"
+#include "player_catalog.h"
+#include "player_search_index.h"
 
-struct PgConnDeleter {
-    void operator()(PGconn *connection) const {
-        if (connection) PQfinish(connection);
-    }
-};
+namespace {
 
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
@@ -26,16 +26,12 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 using Callback = std::function<void(const drogon::HttpResponsePtr &)>;
 
 PgConnPtr connectToDb() {
-    const char *url = std::getenv("DB_URL");
-    if (!url || !*url) return nullptr;
-    auto connection = PgConnPtr{PQconnectdb(url)};
-    if (PQstatus(connection.get()) != CONNECTION_OK) return nullptr;
-    return connection;
+    return cff::db::acquireConnection();
 }
 
 PgResultPtr execParams(PGconn *connection,
@@ -163,24 +159,13 @@ std::optional<std::string> accountEmail(const drogon::HttpRequestPtr &request,
 bool isCommissioner(PGconn *connection,
                     const std::string &email,
                     const std::string &leagueId) {
-    auto result = execParams(connection,
-                             "SELECT 1 FROM leagues WHERE id = $2 AND account_email = $1 "
-                             "UNION ALL "
-                             "SELECT 1 FROM league_members WHERE league_id = $2 AND email = $1 "
-                             "AND role = 'commissioner' AND status = 'active' LIMIT 1",
-                             {email, leagueId});
-    return tuplesOk(result.get()) && PQntuples(result.get()) > 0;
+    return cff::league_access::membership(connection, leagueId, email).commissioner();
 }
 
 bool canAccessLeague(PGconn *connection,
                      const std::string &email,
                      const std::string &leagueId) {
-    auto result = execParams(connection,
-                             "SELECT 1 FROM leagues l WHERE l.id = $2 AND (l.account_email = $1 OR EXISTS ("
-                             "SELECT 1 FROM league_members m WHERE m.league_id = l.id "
-                             "AND m.email = $1 AND m.status = 'active')) LIMIT 1",
-                             {email, leagueId});
-    return tuplesOk(result.get()) && PQntuples(result.get()) > 0;
+    return cff::league_access::membership(connection, leagueId, email).member();
 }
 
 Json::Value membersForLeague(PGconn *connection, const std::string &leagueId) {
@@ -377,6 +362,7 @@ void handleSettings(const drogon::HttpRequestPtr &request,
     }
 
     auto commit = PgResultPtr{PQexec(connection.get(), "COMMIT")};
+    cff::league_access::invalidate(leagueId);
     if (!commandOk(commit.get())) {
         sendJson(callback, errorPayload("League settings could not be committed", "DATABASE_ERROR"), drogon::k500InternalServerError);
         return;
@@ -484,6 +470,7 @@ void handleJoin(const drogon::HttpRequestPtr &request, Callback &&callback) {
                 "UPDATE league_members SET status = 'active', joined_at = COALESCE(joined_at, NOW()), updated_at = NOW() "
                 "WHERE league_id = $1 AND email = $2",
                 {leagueId, *email});
+            cff::league_access::invalidate(leagueId);
             if (!commandOk(activate.get())) {
                 sendJson(callback, errorPayload("The invitation could not be accepted", "JOIN_FAILED"), drogon::k500InternalServerError);
                 return;
@@ -512,6 +499,7 @@ void handleJoin(const drogon::HttpRequestPtr &request, Callback &&callback) {
         "status = CASE WHEN league_members.status = 'removed' THEN league_members.status ELSE 'pending' END, "
         "updated_at = NOW()",
         {leagueId, *email, commissionerEmail});
+    cff::league_access::invalidate(leagueId);
     if (!commandOk(requestJoin.get())) {
         sendJson(callback, errorPayload("The join request could not be saved", "JOIN_FAILED"), drogon::k500InternalServerError);
         return;
@@ -526,6 +514,51 @@ void handleJoin(const drogon::HttpRequestPtr &request, Callback &&callback) {
     sendJson(callback, payload, drogon::k202Accepted);
 }
 
+// ?query, ?position, ?conference and ?team narrow the pool like the public
+// player search; ?limit (default and max 500) and ?offset page it.
+// Unparseable values are ignored.
+cff::player_search_index::Query playerPoolQuery(const drogon::HttpRequestPtr &request) {
+    constexpr std::size_t kMaxLimit = 500;
+    constexpr std::size_t kMaxOffset = 5000;
+    auto sizeParam = [&](const std::string &key, std::size_t fallback, std::size_t max) {
+        const auto value = request->getParameter(key);
+        char *end = nullptr;
+        const auto parsed = std::strtoull(value.c_str(), &end, 10);
+        if (value.empty() || end == value.c_str() || *end != '\0') return fallback;
+        return static_cast<std::size_t>(std::min<unsigned long long>(parsed, max));
+    };
+    auto optionalParam = [&](const std::string &key) -> std::optional<std::string> {
+        auto value = request->getParameter(key);
+        if (value.empty()) return std::nullopt;
+        return value;
+    };
+
+    cff::player_search_index::Query query;
+    query.text = request->getParameter("query");
+    query.position = optionalParam("position");
+    query.conference = optionalParam("conference");
+    query.team = optionalParam("team");
+    query.limit = sizeParam("limit", kMaxLimit, kMaxLimit);
+    if (query.limit == 0) query.limit = kMaxLimit;
+    query.offset = sizeParam("offset", 0, kMaxOffset);
+    return query;
+}
+
+Json::Value playerPoolEntry(const cff::PlayerCard &card, std::size_t rank) {
+    Json::Value player;
+    player["id"] = card.id;
+    player["name"] = card.name;
+    player["team"] = card.team;
+    player["position"] = card.position;
+    player["conference"] = card.conference;
+    player["class"] = card.classYear;
+    player["season"] = card.season;
+    player["projection"] = 10.0;
+    player["rank"] = static_cast<Json::UInt64>(rank);
+    player["availability"] = "Free Agent";
+    return player;
+}
+
 void handlePlayerPool(const drogon::HttpRequestPtr &request,
                       Callback &&callback,
                       const std::string &leagueId) {
@@ -544,37 +577,70 @@ void handlePlayerPool(const drogon::HttpRequestPtr &request,
         return;
     }
 
+    const auto query = playerPoolQuery(request);
+    Json::Value players(Json::arrayValue);
+    if (const auto agents = cff::free_agent_pool::leagueFreeAgents(connection.get(), leagueId, query)) {
+        for (std::size_t index = 0; index < agents->size(); ++index) {
+            players.append(playerPoolEntry((*agents)[index], query.offset + index + 1));
+        }
+        sendJson(callback, players);
+        return;
+    }
+
+    // Until the catalog index has loaded, page through the anti-join with the
+    // same matching rules: tokens are literal case-insensitive substrings of
+    // name, team, position or conference; filters are case-insensitive equality.
+    std::vector<std::string> params{leagueId};
+    std::string where;
+    for (const auto &token : cff::player_search_index::tokenizeQuery(query.text)) {
+        params.push_back(token);
+        const auto param = "$" + std::to_string(params.size());
+        where += " AND (strpos(lower(COALESCE(p.full_name, '')), " + param + ") > 0"
+            " OR strpos(lower(COALESCE(p.team, '')), " + param + ") > 0"
+            " OR strpos(lower(COALESCE(p.position, '')), " + param + ") > 0"
+            " OR strpos(lower(COALESCE(p.conference, '')), " + param + ") > 0)";
+    }
+    const auto filter = [&](const std::optional<std::string> &value, const std::string &column) {
+        if (!value || value->empty()) return;
+        params.push_back(*value);
+        where += " AND lower(COALESCE(" + column + ", '')) = lower($" + std::to_string(params.size()) + ")";
+    };
+    filter(query.position, "p.position");
+    filter(query.conference, "p.conference");
+    filter(query.team, "p.team");
+    params.push_back(std::to_string(query.limit));
+    const auto limitParam = "$" + std::to_string(params.size());
+    params.push_back(std::to_string(query.offset));
+    const auto offsetParam = "$" + std::to_string(params.size());
+
     auto result = execParams(connection.get(),
         "SELECT p.id, COALESCE(p.full_name, ''), COALESCE(p.team, ''), "
         "COALESCE(p.position, ''), COALESCE(p.conference, ''), COALESCE(p.year, ''), "
         "COALESCE(p.season, 0) FROM players p "
         "WHERE p.active = TRUE AND UPPER(COALESCE(p.position, '')) IN ('QB', 'RB', 'WR', 'TE', 'K') "
-        "AND NOT EXISTS (SELECT 1 FROM rosters r WHERE r.league_id = $1 AND r.player_id = p.id) "
+        "AND NOT EXISTS (SELECT 1 FROM rosters r WHERE r.league_id = $1 AND r.player_id = p.id)" + where + " "
         "ORDER BY p.season DESC NULLS LAST, "
         "CASE UPPER(COALESCE(p.position, '')) WHEN 'QB' THEN 1 WHEN 'RB' THEN 2 "
-        "WHEN 'WR' THEN 3 WHEN 'TE' THEN 4 WHEN 'K' THEN 5 ELSE 6 END, p.full_name "
-        "LIMIT 500",
-        {leagueId});
+        "WHEN 'WR' THEN 3 WHEN 'TE' THEN 4 WHEN 'K' THEN 5 ELSE 6 END, "
+        "COALESCE(p.full_name, '') COLLATE \"C\", p.id COLLATE \"C\" "
+        "LIMIT " + limitParam + " OFFSET " + offsetParam,
+        params);
 
     if (!tuplesOk(result.get())) {
         sendJson(callback, errorPayload("Player pool could not be loaded", "PLAYER_POOL_UNAVAILABLE"), drogon::k503ServiceUnavailable);
         return;
     }
 
-    Json::Value players(Json::arrayValue);
     for (int row = 0; row < PQntuples(result.get()); ++row) {
-        Json::Value player;
-        player["id"] = cell(result.get(), row, 0);
-        player["name"] = cell(result.get(), row, 1);
-        player["team"] = cell(result.get(), row, 2);
-        player["position"] = cell(result.get(), row, 3);
-        player["conference"] = cell(result.get(), row, 4);
-        player["class"] = cell(result.get(), row, 5);
-        player["season"] = std::stoi(cell(result.get(), row, 6));
-        player["projection"] = 10.0;
-        player["rank"] = row + 1;
-        player["availability"] = "Free Agent";
-        players.append(player);
+        cff::PlayerCard player;
+        player.id = cell(result.get(), row, 0);
+        player.name = cell(result.get(), row, 1);
+        player.team = cell(result.get(), row, 2);
+        player.position = cell(result.get(), row, 3);
+        player.conference = cell(result.get(), row, 4);
+        player.classYear = cell(result.get(), row, 5);
+        player.season = std::stoi(cell(result.get(), row, 6));
+        players.append(playerPoolEntry(player, query.offset + static_cast<std::size_t>(row) + 1));
     }
     sendJson(callback, players);
 }
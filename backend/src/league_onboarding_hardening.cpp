@@ -13,11 +13,15 @@
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 #include "app_config.h"
 #include "http_security.h"
+#include "league_access_cache.h"
 #include "league_models.h"
+#include "route_dispatch.h"
 
 namespace {
 
@@ -139,34 +143,15 @@ std::vector<std::string> normalizedInvites(const Json::Value &body,
     return invites;
 }
 
-std::string pathLeagueId(const std::string &path,
-                         const std::string &suffix = "") {
-    const std::string prefix = "/api/leagues/";
-    if (path.rfind(prefix, 0) != 0) return "";
-    const auto start = prefix.size();
-    if (!suffix.empty()) {
-        if (path.size() <= suffix.size() || path.substr(path.size() - suffix.size()) != suffix) return "";
-        return path.substr(start, path.size() - start - suffix.size());
-    }
-    const auto slash = path.find('/', start);
-    return path.substr(start, slash == std::string::npos ? std::string::npos : slash - start);
-}
-
 #ifdef CFF_HAS_POSTGRES
 
-struct PgConnectionDeleter {
-    void operator()(PGconn *connection) const {
-        if (connection) PQfinish(connection);
-    }
-};
-
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
         if (result) PQclear(result);
     }
 };
 
-using PgConnection = std::unique_ptr<PGconn, PgConnectionDeleter>;
+using PgConnection = cff::db::PooledConnection;
 using PgResult = std::unique_ptr<PGresult, PgResultDeleter>;
 
 bool dbConfigured() {
@@ -175,11 +160,7 @@ bool dbConfigured() {
 }
 
 PgConnection connectDb() {
-    const auto *value = std::getenv("DB_URL");
-    if (!value) return nullptr;
-    PgConnection connection{PQconnectdb(value)};
-    if (!connection || PQstatus(connection.get()) != CONNECTION_OK) return nullptr;
-    return connection;
+    return cff::db::acquireConnection();
 }
 
 PgResult execute(PGconn *connection,
@@ -312,12 +293,7 @@ std::optional<Json::Value> leaguePayload(PGconn *connection,
 bool commissioner(PGconn *connection,
                   const std::string &leagueId,
                   const std::string &email) {
-    auto result = execute(connection,
-                          "SELECT 1 FROM leagues WHERE id = $1 AND account_email = $2 "
-                          "UNION SELECT 1 FROM league_members WHERE league_id = $1 AND email = $2 "
-                          "AND role = 'commissioner' AND status = 'active' LIMIT 1",
-                          {leagueId, email});
-    return tuplesOk(result) && PQntuples(result.get()) > 0;
+    return cff::league_access::membership(connection, leagueId, email).commissioner();
 }
 
 std::optional<Json::Value> createLeague(const drogon::HttpRequestPtr &request,
@@ -466,6 +442,7 @@ std::optional<Json::Value> createLeague(const drogon::HttpRequestPtr &request,
         status = drogon::k503ServiceUnavailable;
         return errorPayload("League creation could not be confirmed.", "league_confirmation_failed", true);
     }
+    cff::league_access::invalidate(league.id);
     (*payload)["idempotentReplay"] = false;
     (*payload)["operationKey"] = key;
     (*payload)["message"] = "League created.";
@@ -560,6 +537,7 @@ std::optional<Json::Value> joinLeague(const drogon::HttpRequestPtr &request,
         status = drogon::k503ServiceUnavailable;
         return errorPayload("Join request could not be stored.", "join_request_failed", true);
     }
+    cff::league_access::invalidate(leagueId);
     Json::Value pending(Json::objectValue);
     pending["id"] = leagueId;
     pending["joinStatus"] = "pending_approval";
@@ -659,6 +637,7 @@ std::optional<Json::Value> inviteMember(const drogon::HttpRequestPtr &request,
         status = drogon::k503ServiceUnavailable;
         return errorPayload("League invitation could not be confirmed.", "league_confirmation_failed", true);
     }
+    cff::league_access::invalidate(leagueId);
     status = drogon::k201Created;
     return members;
 }
@@ -743,77 +722,85 @@ std::optional<Json::Value> approveMember(const drogon::HttpRequestPtr &request,
         status = drogon::k503ServiceUnavailable;
         return errorPayload("League approval could not be confirmed.", "league_confirmation_failed", true);
     }
+    cff::league_access::invalidate(leagueId);
     status = drogon::k200OK;
     return members;
 }
 
 #endif
 
-drogon::HttpResponsePtr onboardingAdvice(const drogon::HttpRequestPtr &request) {
-    const auto &path = request->getPath();
-    const auto method = request->getMethod();
-    const auto respond = [&request](const drogon::HttpResponsePtr &response) {
-        return cff::http::withRuntimeCorsHeaders(request, response);
-    };
-
-    if (method == drogon::Post && path == "/api/leagues") {
-        const auto body = request->getJsonObject();
-        const int teams = body && body->isObject() ? body->get("teams", 10).asInt() : 10;
-        if (!allowedTeamCount(teams)) {
-            return respond(errorResponse(drogon::k400BadRequest,
-                                         "League size must be 4, 6, 8, 10, 12, 14, or 16 teams.",
-                                         "unsupported_team_count"));
-        }
+drogon::HttpResponsePtr respondWith(const drogon::HttpRequestPtr &request,
+                                    const std::optional<Json::Value> &payload,
+                                    drogon::HttpStatusCode status) {
+    return payload
+        ? cff::http::withRuntimeCorsHeaders(request, jsonResponse(*payload, status))
+        : nullptr;
+}
+
+drogon::HttpResponsePtr createLeagueRoute(const drogon::HttpRequestPtr &request,
+                                          const cff::http::RouteParams &) {
+    const auto body = request->getJsonObject();
+    const int teams = body && body->isObject() ? body->get("teams", 10).asInt() : 10;
+    if (!allowedTeamCount(teams)) {
+        return cff::http::withRuntimeCorsHeaders(
+            request,
+            errorResponse(drogon::k400BadRequest,
+                          "League size must be 4, 6, 8, 10, 12, 14, or 16 teams.",
+                          "unsupported_team_count"));
+    }
 #ifdef CFF_HAS_POSTGRES
-        if (dbConfigured()) {
-            const auto email = accountEmail(request);
-            if (!email) return nullptr;
-            drogon::HttpStatusCode status = drogon::k500InternalServerError;
-            auto payload = createLeague(request, *email, status);
-            return payload ? respond(jsonResponse(*payload, status)) : nullptr;
-        }
-#endif
-        return nullptr;
+    if (dbConfigured()) {
+        const auto email = accountEmail(request);
+        if (!email) return nullptr;
+        drogon::HttpStatusCode status = drogon::k500InternalServerError;
+        auto payload = createLeague(request, *email, status);
+        return respondWith(request, payload, status);
     }
+#endif
+    return nullptr;
+}
 
 #ifdef CFF_HAS_POSTGRES
+drogon::HttpResponsePtr joinLeagueRoute(const drogon::HttpRequestPtr &request,
+                                        const cff::http::RouteParams &params) {
     if (!dbConfigured()) return nullptr;
     const auto email = accountEmail(request);
     if (!email) return nullptr;
+    drogon::HttpStatusCode status = drogon::k500InternalServerError;
+    auto payload = joinLeague(request, *email, params[0], status);
+    return respondWith(request, payload, status);
+}
 
-    if (method == drogon::Post && path.size() > 5 && path.substr(path.size() - 5) == "/join") {
-        const auto leagueId = pathLeagueId(path, "/join");
-        if (leagueId.empty()) return nullptr;
-        drogon::HttpStatusCode status = drogon::k500InternalServerError;
-        auto payload = joinLeague(request, *email, leagueId, status);
-        return payload ? respond(jsonResponse(*payload, status)) : nullptr;
-    }
-
-    if (method == drogon::Post && path.size() > 8 && path.substr(path.size() - 8) == "/members") {
-        const auto leagueId = pathLeagueId(path, "/members");
-        if (leagueId.empty()) return nullptr;
-        drogon::HttpStatusCode status = drogon::k500InternalServerError;
-        auto payload = inviteMember(request, *email, leagueId, status);
-        return payload ? respond(jsonResponse(*payload, status)) : nullptr;
-    }
-
-    if ((method == drogon::Put || method == drogon::Post) && path.find("/members/") != std::string::npos) {
-        const auto leagueId = pathLeagueId(path);
-        const auto marker = path.find("/members/");
-        if (leagueId.empty() || marker == std::string::npos) return nullptr;
-        const auto memberEmail = path.substr(marker + std::string{"/members/"}.size());
-        drogon::HttpStatusCode status = drogon::k500InternalServerError;
-        auto payload = approveMember(request, *email, leagueId, memberEmail, status);
-        return payload ? respond(jsonResponse(*payload, status)) : nullptr;
-    }
-#endif
+drogon::HttpResponsePtr inviteMemberRoute(const drogon::HttpRequestPtr &request,
+                                          const cff::http::RouteParams &params) {
+    if (!dbConfigured()) return nullptr;
+    const auto email = accountEmail(request);
+    if (!email) return nullptr;
+    drogon::HttpStatusCode status = drogon::k500InternalServerError;
+    auto payload = inviteMember(request, *email, params[0], status);
+    return respondWith(request, payload, status);
+}
 
-    return nullptr;
+drogon::HttpResponsePtr approveMemberRoute(const drogon::HttpRequestPtr &request,
+                                           const cff::http::RouteParams &params) {
+    if (!dbConfigured()) return nullptr;
+    const auto email = accountEmail(request);
+    if (!email) return nullptr;
+    drogon::HttpStatusCode status = drogon::k500InternalServerError;
+    auto payload = approveMember(request, *email, params[0], params[1], status);
+    return respondWith(request, payload, status);
 }
+#endif
 
 struct LeagueOnboardingInstaller {
     LeagueOnboardingInstaller() {
-        drogon::app().registerSyncAdvice(onboardingAdvice);
+        cff::http::addDispatchRoute(drogon::Post, "/api/leagues", createLeagueRoute);
+#ifdef CFF_HAS_POSTGRES
+        cff::http::addDispatchRoute(drogon::Post, "/api/leagues/{}/join", joinLeagueRoute);
+        cff::http::addDispatchRoute(drogon::Post, "/api/leagues/{}/members", inviteMemberRoute);
+        cff::http::addDispatchRoute({drogon::Put, drogon::Post}, "/api/leagues/{}/members/{}",
+                                    approveMemberRoute);
+#endif
     }
 };
 
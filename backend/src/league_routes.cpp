@@ -1,5 +1,6 @@
 #include "league_routes.h"
 
+#include "db_offload.h"
 #include "handlers/league_handler.h"
 #include "http_security.h"
 
@@ -11,6 +12,19 @@ void registerLeagueRoutes(
     drogon::HttpAppFramework &app,
     const std::optional<std::string> &jwtSecret,
     const std::unordered_set<std::string> &allowedOrigins) {
+    // League handlers call libpq synchronously, so route them from a DB
+    // executor worker; a slow query then never stalls the IO loop that
+    // accepted the request. Preflights stay on the loop.
+    app.registerPreRoutingAdvice([](const drogon::HttpRequestPtr &req,
+                                    drogon::AdviceCallback &&callback,
+                                    drogon::AdviceChainCallback &&chain) {
+        if (req->method() == drogon::Options
+            || (req->getPath() + "/").rfind("/api/leagues/", 0) != 0) {
+            return chain();
+        }
+        cff::db::continueOnExecutor(req, std::move(callback), std::move(chain));
+    });
+
     app.registerHandler("/api/leagues",
                          [jwtSecret](const drogon::HttpRequestPtr& req, std::function<void (const drogon::HttpResponsePtr &)> &&callback) {
                              std::string accountEmail;
@@ -0,0 +1,160 @@
+#include "live_score_index.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace cff::live_score_index {
+namespace {
+
+std::string jsonText(const Json::Value &value) {
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    return Json::writeString(writer, value);
+}
+
+// Appends to a JSON array under construction that has no closing bracket yet.
+void appendElement(std::string &array, const std::string &element) {
+    if (array.back() != '[') array += ',';
+    array += element;
+}
+
+std::uint64_t wallClockMillis() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+LiveScoreIndex::LiveScoreIndex() : LiveScoreIndex(wallClockMillis()) {}
+
+LiveScoreIndex::LiveScoreIndex(std::uint64_t firstVersion)
+    : firstVersion_(std::max<std::uint64_t>(1, firstVersion)),
+      state_(std::make_shared<State>()) {}
+
+std::shared_ptr<const LiveScoreIndex::State> LiveScoreIndex::state() const {
+    return std::atomic_load(&state_);
+}
+
+std::uint64_t LiveScoreIndex::version() const {
+    return state()->version;
+}
+
+std::uint64_t LiveScoreIndex::update(const Json::Value &games) {
+    std::lock_guard<std::mutex> lock(updateMutex_);
+    const auto previous = state();
+    const auto candidate = previous->version == 0 ? firstVersion_ : previous->version + 1;
+    auto next = std::make_shared<State>();
+    bool changed = false;
+
+    if (games.isArray()) {
+        for (const auto &source : games) {
+            auto id = source.get("id", "").asString();
+            if (id.empty() || next->byId.count(id)) continue;
+            Game game;
+            game.json = jsonText(source);
+            game.week = source.get("week", 0).isIntegral() ? source.get("week", 0).asInt() : 0;
+            game.live = source.get("live", false).isBool() && source.get("live", false).asBool();
+            const auto found = previous->byId.find(id);
+            if (found != previous->byId.end() && previous->games[found->second].json == game.json) {
+                game.changed = previous->games[found->second].changed;
+            } else {
+                game.changed = candidate;
+                changed = true;
+            }
+            game.id = std::move(id);
+            next->byId.emplace(game.id, next->games.size());
+            next->games.push_back(std::move(game));
+        }
+    }
+
+    // Tombstones older than the delta window are dropped; a caller whose
+    // `since` predates one it never saw falls back to a full response.
+    next->oldestDelta = std::max(previous->oldestDelta, firstVersion_);
+    const auto expired = candidate > kTombstoneVersions ? candidate - kTombstoneVersions : 0;
+    for (const auto &[id, at] : previous->removed) {
+        if (next->byId.count(id)) continue;
+        if (at > expired) {
+            next->removed.emplace(id, at);
+        } else {
+            next->oldestDelta = std::max(next->oldestDelta, at);
+        }
+    }
+    for (const auto &game : previous->games) {
+        if (next->byId.count(game.id)) continue;
+        next->removed[game.id] = candidate;
+        changed = true;
+    }
+    next->version = changed ? candidate : previous->version;
+
+    next->liveBody = "[";
+    for (std::size_t index = 0; index < next->games.size(); ++index) {
+        const auto &game = next->games[index];
+        next->byWeek[game.week].push_back(index);
+        auto &weekBody = next->weekBodies.emplace(game.week, "[").first->second;
+        appendElement(weekBody, game.json);
+        if (game.live) appendElement(next->liveBody, game.json);
+    }
+    next->liveBody += ']';
+    for (auto &[week, body] : next->weekBodies) body += ']';
+
+    const auto version = next->version;
+    std::atomic_store(&state_, std::shared_ptr<const State>{std::move(next)});
+    return version;
+}
+
+QueryResult LiveScoreIndex::query(const Query &query) const {
+    const auto current = state();
+    QueryResult result;
+    result.version = current->version;
+    const bool delta = query.since && *query.since >= current->oldestDelta && *query.since <= current->version;
+    if (!query.since && !query.liveOnly && query.week) {
+        const auto found = current->weekBodies.find(*query.week);
+        result.body = found == current->weekBodies.end() ? "[]" : found->second;
+        return result;
+    }
+    if (!query.since && query.liveOnly && !query.week) {
+        result.body = current->liveBody;
+        return result;
+    }
+
+    std::string games = "[";
+    const auto consider = [&](const Game &game) {
+        if (delta && game.changed <= *query.since) return;
+        // A delta keeps games that just left the live set so the client sees
+        // them go final.
+        if (query.liveOnly && !game.live && !delta) return;
+        appendElement(games, game.json);
+    };
+    if (query.week) {
+        const auto found = current->byWeek.find(*query.week);
+        if (found != current->byWeek.end()) {
+            for (const auto index : found->second) consider(current->games[index]);
+        }
+    } else {
+        for (const auto &game : current->games) consider(game);
+    }
+    games += ']';
+    if (!query.since) {
+        result.body = std::move(games);
+        return result;
+    }
+
+    std::string removed = "[";
+    if (delta) {
+        for (const auto &[id, at] : current->removed) {
+            if (at > *query.since) appendElement(removed, Json::valueToQuotedString(id.c_str()));
+        }
+    }
+    removed += ']';
+    result.body = "{\"version\":" + std::to_string(current->version) + ",\"full\":" + (delta ? "false" : "true")
+        + ",\"games\":" + games + ",\"removed\":" + removed + "}";
+    return result;
+}
+
+LiveScoreIndex &liveScoreIndex() {
+    static LiveScoreIndex index;
+    return index;
+}
+
+} // namespace cff::live_score_index
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cff::live_score_index {
+
+struct Query {
+    std::optional<int> week;
+    bool liveOnly{false};
+    // Present for delta reads: only games changed after this version.
+    std::optional<std::uint64_t> since;
+};
+
+struct QueryResult {
+    std::uint64_t version{0};
+    std::string body;
+};
+
+// Live score games indexed by id and week, each stamped with the version at
+// which it last changed. Every update builds a new immutable state with the
+// per-week and live arrays pre-serialized, so plain reads are string joins.
+//
+// Versions start at the wall-clock milliseconds of the first update, so a
+// `since` from another process or an earlier run is almost always outside
+// this index's range and gets a full response instead of a wrong delta.
+// Removed games are remembered for kTombstoneVersions versions; a `since`
+// older than that also gets a full response.
+class LiveScoreIndex {
+public:
+    LiveScoreIndex();
+    explicit LiveScoreIndex(std::uint64_t firstVersion);
+
+    // Replaces the game set; returns the current version, which only moves
+    // when some game was added, changed or removed.
+    std::uint64_t update(const Json::Value &games);
+    std::uint64_t version() const;
+
+    // Without `since`: a JSON array of the matching games, the same shape as
+    // the full payload. With `since`: {"version", "full", "games", "removed"},
+    // where a live-only delta also carries changed games that are no longer
+    // live, so a game going final is not lost.
+    QueryResult query(const Query &query) const;
+
+    static constexpr std::uint64_t kTombstoneVersions = 1024;
+
+private:
+    struct Game {
+        std::string id;
+        int week{0};
+        bool live{false};
+        std::string json;
+        std::uint64_t changed{0};
+    };
+
+    struct State {
+        // The oldest `since` that can still be answered as a delta.
+        std::uint64_t oldestDelta{0};
+        std::uint64_t version{0};
+        std::vector<Game> games;
+        std::unordered_map<std::string, std::size_t> byId;
+        std::map<int, std::vector<std::size_t>> byWeek;
+        std::unordered_map<std::string, std::uint64_t> removed;
+        std::map<int, std::string> weekBodies;
+        std::string liveBody;
+    };
+
+    std::shared_ptr<const State> state() const;
+
+    std::uint64_t firstVersion_;
+    std::mutex updateMutex_;
+    std::shared_ptr<const State> state_;
+};
+
+LiveScoreIndex &liveScoreIndex();
+
+} // namespace cff::live_score_index
@@ -0,0 +1,151 @@
+#include "live_score_snapshot.h"
+
+#include <brotli/encode.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+
+namespace cff::live_score_snapshot {
+namespace {
+
+std::shared_ptr<const Snapshot> published;
+// Serializes publishers (ingest and the refresher) so versions stay ordered.
+std::mutex publishMutex;
+
+std::string trim(std::string value) {
+    value.erase(value.begin(), std::find_if(value.begin(), value.end(), [](unsigned char ch) {
+        return !std::isspace(ch);
+    }));
+    value.erase(std::find_if(value.rbegin(), value.rend(), [](unsigned char ch) {
+        return !std::isspace(ch);
+    }).base(), value.end());
+    return value;
+}
+
+std::string lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return value;
+}
+
+// FNV-1a: stable across builds and processes, unlike std::hash.
+std::string contentTag(const std::string &body) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char ch : body) {
+        hash ^= ch;
+        hash *= 1099511628211ULL;
+    }
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "\"%016llx-%zx\"", static_cast<unsigned long long>(hash), body.size());
+    return buffer;
+}
+
+// Encodings that do not shrink the body are dropped and served as identity.
+std::string gzipEncode(const std::string &body) {
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) return "";
+    std::string output(deflateBound(&stream, static_cast<uLong>(body.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(body.data()));
+    stream.avail_in = static_cast<uInt>(body.size());
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+    const auto status = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return status == Z_STREAM_END && output.size() < body.size() ? output : "";
+}
+
+std::string brotliEncode(const std::string &body) {
+    std::size_t size = BrotliEncoderMaxCompressedSize(body.size());
+    if (size == 0) return "";
+    std::string output(size, '\0');
+    // Quality 9 keeps a season-sized payload well under a second; 11 buys a
+    // few percent for several times the CPU.
+    if (!BrotliEncoderCompress(9, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                               body.size(), reinterpret_cast<const std::uint8_t *>(body.data()),
+                               &size, reinterpret_cast<std::uint8_t *>(output.data()))) return "";
+    output.resize(size);
+    return output.size() < body.size() ? output : "";
+}
+
+double qualityOf(const std::string &parameters) {
+    const auto marker = parameters.find("q=");
+    if (marker == std::string::npos) return 1.0;
+    return std::strtod(parameters.c_str() + marker + 2, nullptr);
+}
+
+} // namespace
+
+bool publish(std::string body) {
+    auto etag = contentTag(body);
+    std::lock_guard<std::mutex> lock(publishMutex);
+    const auto previous = current();
+    if (previous && previous->etag == etag && previous->body == body) return false;
+
+    auto next = std::make_shared<Snapshot>();
+    next->version = previous ? previous->version + 1 : 1;
+    next->etag = std::move(etag);
+    next->gzip = gzipEncode(body);
+    next->brotli = brotliEncode(body);
+    next->body = std::move(body);
+    std::atomic_store(&published, std::shared_ptr<const Snapshot>{std::move(next)});
+    return true;
+}
+
+std::shared_ptr<const Snapshot> current() {
+    return std::atomic_load(&published);
+}
+
+Encoding preferredEncoding(const std::string &acceptEncoding, const Snapshot &snapshot) {
+    double brotli = 0.0;
+    double gzip = 0.0;
+    double wildcard = 0.0;
+    bool brotliNamed = false;
+    bool gzipNamed = false;
+    std::size_t start = 0;
+    while (start <= acceptEncoding.size()) {
+        const auto end = std::min(acceptEncoding.find(',', start), acceptEncoding.size());
+        const auto item = lower(trim(acceptEncoding.substr(start, end - start)));
+        const auto separator = item.find(';');
+        const auto coding = trim(item.substr(0, separator));
+        const auto quality = separator == std::string::npos ? 1.0 : qualityOf(item.substr(separator + 1));
+        if (coding == "br") {
+            brotli = quality;
+            brotliNamed = true;
+        } else if (coding == "gzip" || coding == "x-gzip") {
+            gzip = quality;
+            gzipNamed = true;
+        } else if (coding == "*") {
+            wildcard = quality;
+        }
+        start = end + 1;
+    }
+    if (!brotliNamed) brotli = wildcard;
+    if (!gzipNamed) gzip = wildcard;
+    if (brotli > 0.0 && !snapshot.brotli.empty() && brotli >= gzip) return Encoding::Brotli;
+    if (gzip > 0.0 && !snapshot.gzip.empty()) return Encoding::Gzip;
+    if (brotli > 0.0 && !snapshot.brotli.empty()) return Encoding::Brotli;
+    return Encoding::Identity;
+}
+
+bool etagMatches(const std::string &ifNoneMatch, const std::string &etag) {
+    std::size_t start = 0;
+    while (start <= ifNoneMatch.size()) {
+        const auto end = std::min(ifNoneMatch.find(',', start), ifNoneMatch.size());
+        auto candidate = trim(ifNoneMatch.substr(start, end - start));
+        // If-None-Match uses weak comparison, so a W/ prefix added by a proxy
+        // still matches.
+        if (candidate.rfind("W/", 0) == 0) candidate = candidate.substr(2);
+        if (candidate == "*" || (!candidate.empty() && candidate == etag)) return true;
+        start = end + 1;
+    }
+    return false;
+}
+
+} // namespace cff::live_score_snapshot
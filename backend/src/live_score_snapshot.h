@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cff::live_score_snapshot {
+
+// One published /api/scores/live body: the serialized bytes, their gzip and
+// brotli encodings and a strong ETag derived from the bytes, so replicas that
+// load the same payload agree on it. Never modified after publish().
+struct Snapshot {
+    std::uint64_t version{0};
+    std::string etag;
+    std::string body;
+    std::string gzip;
+    std::string brotli;
+};
+
+enum class Encoding { Identity, Gzip, Brotli };
+
+// Builds the encodings and swaps the snapshot in. Publishing bytes identical
+// to the current snapshot keeps it, version and ETag included, and returns
+// false.
+bool publish(std::string body);
+
+// Current snapshot, or nullptr before the first publish. Lock-free for
+// readers; a request keeps its snapshot alive while it is being sent.
+std::shared_ptr<const Snapshot> current();
+
+// Best encoding the client accepts that the snapshot carries; brotli over
+// gzip, and never an encoding the client rejected with q=0.
+Encoding preferredEncoding(const std::string &acceptEncoding, const Snapshot &snapshot);
+
+// True when an If-None-Match header names this ETag (or is "*").
+bool etagMatches(const std::string &ifNoneMatch, const std::string &etag);
+
+} // namespace cff::live_score_snapshot
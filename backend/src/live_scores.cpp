@@ -1,5 +1,9 @@
 #include "live_scores.h"
 
+#include "app_config.h"
+#include "json_array_stream.h"
+#include "live_score_index.h"
+
 #include <algorithm>
 #include <chrono>
 #include <cctype>
@@ -8,10 +12,15 @@
 #include <ctime>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <pqxx/pqxx>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -160,31 +169,6 @@ Json::Value parseJson(const std::string &text) {
     return value;
 }
 
-std::optional<Json::Value> fetchArray(const std::string &url,
-                                      const std::string &apiKey,
-                                      const cpr::Parameters &parameters,
-                                      std::size_t &calls,
-                                      std::string &error) {
-    const auto response = cpr::Get(
-        cpr::Url{url},
-        cpr::Header{{"Authorization", "Bearer " + apiKey}},
-        parameters,
-        cpr::Timeout{60000}
-    );
-    ++calls;
-    if (response.error || response.status_code < 200 || response.status_code >= 300) {
-        error = "CFBD request to " + url + " failed with status " +
-                std::to_string(response.status_code) + ": " + response.error.message;
-        return std::nullopt;
-    }
-    auto parsed = parseJson(response.text);
-    if (!parsed.isArray()) {
-        error = "CFBD request to " + url + " did not return a JSON array.";
-        return std::nullopt;
-    }
-    return parsed;
-}
-
 Json::Value normalizeGame(const Json::Value &game, bool scoreboard) {
     Json::Value cached;
     const int period = scoreboard ? intAt(game, {"period", "quarter"}) : 0;
@@ -209,13 +193,48 @@ Json::Value normalizeGame(const Json::Value &game, bool scoreboard) {
     return cached;
 }
 
-Json::Value normalizeGames(const Json::Value &root, bool scoreboard) {
-    Json::Value output(Json::arrayValue);
-    for (const auto &game : root) {
+// Streams a CFBD games array and normalizes each game as it arrives, so only
+// the compact cached form of the season is ever held, never the raw body or
+// a document for it.
+std::optional<Json::Value> fetchGames(const std::string &url,
+                                      const std::string &apiKey,
+                                      const cpr::Parameters &parameters,
+                                      bool scoreboard,
+                                      std::size_t &calls,
+                                      std::string &error) {
+    Json::Value games(Json::arrayValue);
+    bool invalidElement = false;
+    const std::unique_ptr<Json::CharReader> reader{Json::CharReaderBuilder{}.newCharReader()};
+    cff::json_stream::ArraySplitter splitter{[&](std::string_view text) {
+        Json::Value game;
+        if (!reader->parse(text.data(), text.data() + text.size(), &game, nullptr)) {
+            invalidElement = true;
+            return;
+        }
         auto normalized = normalizeGame(game, scoreboard);
-        if (!normalized["id"].asString().empty()) output.append(normalized);
+        if (!normalized["id"].asString().empty()) games.append(std::move(normalized));
+    }};
+    const auto response = cpr::Get(
+        cpr::Url{url},
+        cpr::Header{{"Authorization", "Bearer " + apiKey}},
+        parameters,
+        cpr::Timeout{60000},
+        cpr::WriteCallback{[&](std::string_view data, intptr_t) {
+            splitter.feed(data);
+            return true;
+        }}
+    );
+    ++calls;
+    if (response.error || response.status_code < 200 || response.status_code >= 300) {
+        error = "CFBD request to " + url + " failed with status " +
+                std::to_string(response.status_code) + ": " + response.error.message;
+        return std::nullopt;
     }
-    return output;
+    if (!splitter.finish() || invalidElement) {
+        error = "CFBD request to " + url + " did not return a JSON array.";
+        return std::nullopt;
+    }
+    return games;
 }
 
 Json::Value mergeGames(const Json::Value &schedule, const Json::Value &scoreboard) {
@@ -286,6 +305,40 @@ void recordFailure(const std::string &dbUrl, const std::string &error, std::size
     }
 }
 
+void publishLiveScores(const Json::Value &payload) {
+    cff::live_score_snapshot::publish(jsonText(payload));
+    cff::live_score_index::liveScoreIndex().update(payload);
+}
+
+// Reloads the snapshot and index only when fetched_at moved since the last
+// load; the unchanged case reads one timestamp. Publishing identical bytes is
+// a no-op, so the reload that follows an in-process ingest keeps the same
+// ETag and index version.
+void refreshSnapshotFromCache() {
+    static std::mutex mutex;
+    static std::string loadedFetchedAt;
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto dbUrl = env("DB_URL");
+    if (!dbUrl) return;
+    try {
+        pqxx::connection connection{*dbUrl};
+        pqxx::read_transaction transaction{connection};
+        const auto rows = transaction.exec_params(
+            "SELECT COALESCE(fetched_at::text,''),"
+            "CASE WHEN COALESCE(fetched_at::text,'')=$1 THEN NULL ELSE payload::text END "
+            "FROM live_score_cache WHERE id=1",
+            loadedFetchedAt
+        );
+        if (rows.empty() || rows[0][1].is_null()) return;
+        auto payload = parseJson(rows[0][1].c_str());
+        if (!payload.isArray()) payload = Json::Value(Json::arrayValue);
+        publishLiveScores(payload);
+        loadedFetchedAt = rows[0][0].c_str();
+    } catch (const std::exception &error) {
+        std::cerr << "[cfbd-live] snapshot refresh failed: " << error.what() << std::endl;
+    }
+}
+
 } // namespace
 
 namespace cff {
@@ -308,26 +361,26 @@ LiveScoreIngestResult runLiveScoreIngestOnce() {
     auto scheduleState = loadSchedule(*dbUrl);
 
     std::string error;
-    const auto scoreboardResponse = fetchArray(
+    const auto scoreboardResponse = fetchGames(
         baseUrl + "/scoreboard", *apiKey,
-        cpr::Parameters{{"classification", "fbs"}}, result.apiCalls, error
+        cpr::Parameters{{"classification", "fbs"}}, true, result.apiCalls, error
     );
     if (!scoreboardResponse) {
         result.errors.push_back(error);
         recordFailure(*dbUrl, error, result.apiCalls);
         return result;
     }
-    const auto scoreboard = normalizeGames(*scoreboardResponse, true);
+    const auto &scoreboard = *scoreboardResponse;
 
     Json::Value schedule = scheduleState.games;
     if (scheduleState.refresh) {
-        const auto response = fetchArray(
+        auto response = fetchGames(
             baseUrl + "/games", *apiKey,
             cpr::Parameters{{"year", std::to_string(season)}, {"seasonType", "both"}, {"classification", "fbs"}},
-            result.apiCalls, error
+            false, result.apiCalls, error
         );
         if (response) {
-            schedule = normalizeGames(*response, false);
+            schedule = std::move(*response);
             result.scheduleRefreshed = true;
         } else if (schedule.empty()) {
             result.errors.push_back(error);
@@ -373,26 +426,31 @@ LiveScoreIngestResult runLiveScoreIngestOnce() {
             static_cast<int>(result.games), result.errors.empty() ? "" : result.errors.front()
         );
         transaction.commit();
+        publishLiveScores(payload);
     } catch (const std::exception &exception) {
         result.errors.push_back(std::string{"Unable to cache weekly scores: "} + exception.what());
     }
     return result;
 }
 
-Json::Value cachedLiveScorePayload() {
-    const auto dbUrl = env("DB_URL");
-    if (!dbUrl) return Json::Value(Json::arrayValue);
-    try {
-        pqxx::connection connection{*dbUrl};
-        pqxx::read_transaction transaction{connection};
-        const auto rows = transaction.exec("SELECT payload::text FROM live_score_cache WHERE id=1");
-        if (rows.empty()) return Json::Value(Json::arrayValue);
-        auto payload = parseJson(rows[0][0].c_str());
-        return payload.isArray() ? payload : Json::Value(Json::arrayValue);
-    } catch (const std::exception &error) {
-        std::cerr << "[cfbd-live] cached score read failed: " << error.what() << std::endl;
-        return Json::Value(Json::arrayValue);
-    }
+void startLiveScoreSnapshotLoader() {
+    static std::once_flag started;
+    std::call_once(started, [] {
+        if (!live_score_snapshot::current()) live_score_snapshot::publish("[]");
+        if (!env("DB_URL")) return;
+        const std::chrono::seconds interval{
+            cff::config::readSizeEnv("CFF_LIVE_SCORE_SNAPSHOT_REFRESH_SECONDS", 15, 3600)};
+        std::thread([interval] {
+            for (;;) {
+                refreshSnapshotFromCache();
+                std::this_thread::sleep_for(interval);
+            }
+        }).detach();
+    });
+}
+
+std::shared_ptr<const live_score_snapshot::Snapshot> liveScoreSnapshot() {
+    return live_score_snapshot::current();
 }
 
 Json::Value cachedLiveScoreMeta() {
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "live_score_snapshot.h"
+
 #include <cstddef>
 #include <json/json.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,7 +22,16 @@ struct LiveScoreIngestResult {
 // Refreshes the two-minute scoreboard overlay and periodically refreshes the
 // full season schedule. The public payload is a merged, week-aware cache.
 LiveScoreIngestResult runLiveScoreIngestOnce();
-Json::Value cachedLiveScorePayload();
+
+// Publishes an empty snapshot and starts the background refresher that loads
+// live_score_cache and reloads it whenever it changes, so ingests by another
+// replica are picked up. Called once at startup.
+void startLiveScoreSnapshotLoader();
+
+// The public payload as a pre-serialized, pre-compressed snapshot. Ingest
+// publishes it directly; otherwise it is whatever the loader last read.
+// Serving it never touches Postgres.
+std::shared_ptr<const live_score_snapshot::Snapshot> liveScoreSnapshot();
 Json::Value cachedLiveScoreMeta();
 Json::Value liveScoreIngestStatus();
 
@@ -1,5 +1,7 @@
 #include "live_stat_orchestration.h"
 
+#include <algorithm>
+
 namespace cff::live_stats {
 
 RunDecision mayStartRun(bool matchingRunActive,
@@ -48,6 +50,54 @@ RefreshDecision shouldQueueScoringRefresh(bool statsChanged,
     return {true, "stats_changed"};
 }
 
+Cadence nextCadence(const std::optional<LiveWindow> &loaded, const CadencePolicy &policy) {
+    using std::chrono::seconds;
+    Cadence cadence;
+    if (!loaded && policy.monthlyBudget > 0) {
+        cadence.run = false;
+        cadence.wait = std::max(policy.idle, policy.live);
+        cadence.reason = "ledger_unavailable";
+        return cadence;
+    }
+    const auto window = loaded.value_or(LiveWindow{});
+    if (window.liveGames > 0) {
+        cadence.wait = policy.live;
+        cadence.reason = "live";
+    } else if (window.secondsToKickoff && *window.secondsToKickoff <= policy.kickoffLead.count()) {
+        cadence.wait = policy.live;
+        cadence.reason = "kickoff_imminent";
+    } else {
+        auto wait = policy.idle;
+        if (window.secondsToKickoff) {
+            wait = std::min(wait, seconds{*window.secondsToKickoff - policy.kickoffLead.count()});
+        }
+        cadence.wait = std::max(wait, policy.live);
+        cadence.reason = "idle";
+    }
+    if (policy.monthlyBudget <= 0) return cadence;
+
+    const auto perRun = std::max<long long>(1, policy.callsPerRun);
+    const auto remaining = policy.monthlyBudget - window.monthlyCalls;
+    const auto left = std::max<long long>(0, window.secondsLeftInMonth);
+    if (remaining < perRun) {
+        // Re-check at least every idle period in case the budget is raised.
+        cadence.run = false;
+        cadence.wait = std::max(policy.live, std::min(policy.idle, seconds{left + 1}));
+        cadence.reason = "budget_exhausted";
+        return cadence;
+    }
+    const seconds paced{(left * perRun + remaining - 1) / remaining};
+    if (paced > cadence.wait) {
+        cadence.wait = paced;
+        cadence.reason = "budget_paced";
+    }
+    return cadence;
+}
+
+std::chrono::milliseconds retryDelay(int attempt, std::chrono::milliseconds base) {
+    return base * (1 << std::clamp(attempt - 1, 0, 10));
+}
+
 std::string toString(RunStatus status) {
     switch (status) {
         case RunStatus::queued: return "queued";
@@ -18,6 +18,7 @@ struct SourceResult {
     std::size_t rows{0};
     std::string error;
     std::chrono::system_clock::time_point observedAt{};
+    std::size_t changed{0};
 };
 
 struct RunDecision {
@@ -30,6 +31,31 @@ struct RefreshDecision {
     std::string code;
 };
 
+// What the cached schedule and the call ledger say about the next refresh.
+struct LiveWindow {
+    int liveGames{0};
+    // Seconds until the earliest kickoff that has not gone final; negative
+    // while a game is past its start time but not yet reported live.
+    std::optional<long long> secondsToKickoff;
+    long long monthlyCalls{0};
+    long long secondsLeftInMonth{0};
+};
+
+struct CadencePolicy {
+    std::chrono::seconds live{120};
+    std::chrono::seconds idle{3600};
+    std::chrono::seconds kickoffLead{1800};
+    // Zero leaves the month unmetered.
+    long long monthlyBudget{0};
+    long long callsPerRun{2};
+};
+
+struct Cadence {
+    bool run{true};
+    std::chrono::seconds wait{0};
+    std::string reason;
+};
+
 RunDecision mayStartRun(bool matchingRunActive,
                         bool matchingRunRecentlyCompleted,
                         bool force);
@@ -48,6 +74,16 @@ RefreshDecision shouldQueueScoringRefresh(bool statsChanged,
                                           std::chrono::system_clock::time_point gameEndedAt,
                                           std::chrono::hours correctionWindow);
 
+// Polls at the live cadence while games are live or a kickoff is within the
+// lead window and at the idle cadence otherwise, waking early for the next
+// window. A metered month is spread over its remaining seconds, and once the
+// budget cannot cover another run nothing runs until the month resets. An
+// unreadable window (nullopt) is treated as idle, except that a metered month
+// fails closed: nothing runs until the ledger can be read again.
+Cadence nextCadence(const std::optional<LiveWindow> &window, const CadencePolicy &policy);
+
+std::chrono::milliseconds retryDelay(int attempt, std::chrono::milliseconds base);
+
 std::string toString(RunStatus status);
 std::string toString(SourceState state);
 
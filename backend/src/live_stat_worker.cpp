@@ -1,6 +1,7 @@
 #include "live_stat_worker.h"
 
 #include "app_config.h"
+#include "cfbd_player_stats.h"
 #include "live_scores.h"
 #include "live_stat_orchestration.h"
 
@@ -21,7 +22,8 @@ namespace cff::live_stats {
 namespace {
 
 constexpr const char *kProvider = "cfbd";
-constexpr const char *kSource = "scoreboard_schedule_cache";
+constexpr const char *kScoreboardSource = "scoreboard_schedule_cache";
+constexpr const char *kPlayerStatSource = "player_stats";
 
 struct ClaimResult {
     bool accepted{false};
@@ -203,72 +205,88 @@ ClaimResult claimRun(const std::string &dbUrl, const WorkerRequest &request) {
 void persistCompletedRun(const std::string &dbUrl,
                          const WorkerRequest &request,
                          const std::string &runId,
+                         const std::vector<SourceResult> &sources,
                          const LiveScoreIngestResult &ingest,
+                         const PlayerStatIngestResult &playerStats,
                          RunStatus status,
                          int attempts) {
-    const bool succeeded = status == RunStatus::succeeded;
-    const auto errorSummary = joinErrors(ingest.errors);
+    std::vector<std::string> errors;
+    std::size_t rowsChanged = 0;
+    for (const auto &source : sources) {
+        if (!source.error.empty()) errors.push_back(source.error);
+        rowsChanged += source.changed;
+    }
+    const auto errorSummary = joinErrors(errors);
     try {
         pqxx::connection connection{dbUrl};
         pqxx::work transaction{connection};
-        transaction.exec_params(
-            "INSERT INTO stat_ingest_source_results "
-            "(run_id,source,status,rows_received,rows_changed,error_message,observed_at,completed_at) "
-            "VALUES($1,$2,$3,$4,0,$5,NOW(),NOW()) "
-            "ON CONFLICT(run_id,source) DO UPDATE SET "
-            "status=EXCLUDED.status,rows_received=EXCLUDED.rows_received,"
-            "rows_changed=EXCLUDED.rows_changed,error_message=EXCLUDED.error_message,"
-            "observed_at=EXCLUDED.observed_at,completed_at=NOW()",
-            runId,
-            kSource,
-            succeeded ? "succeeded" : "failed",
-            static_cast<int>(ingest.games),
-            errorSummary);
+        for (const auto &source : sources) {
+            if (!source.attempted) continue;
+            transaction.exec_params(
+                "INSERT INTO stat_ingest_source_results "
+                "(run_id,source,status,rows_received,rows_changed,error_message,observed_at,completed_at) "
+                "VALUES($1,$2,$3,$4,$5,$6,NOW(),NOW()) "
+                "ON CONFLICT(run_id,source) DO UPDATE SET "
+                "status=EXCLUDED.status,rows_received=EXCLUDED.rows_received,"
+                "rows_changed=EXCLUDED.rows_changed,error_message=EXCLUDED.error_message,"
+                "observed_at=EXCLUDED.observed_at,completed_at=NOW()",
+                runId,
+                source.source,
+                source.succeeded ? "succeeded" : "failed",
+                static_cast<int>(source.rows),
+                static_cast<int>(source.changed),
+                source.error);
+
+            if (source.succeeded) {
+                transaction.exec_params(
+                    "INSERT INTO stat_source_freshness "
+                    "(provider,source,season,week,state,last_attempt_at,last_success_at,"
+                    "last_complete_run_id,consecutive_failures,updated_at) "
+                    "VALUES($1,$2,$3,$4,'fresh',NOW(),NOW(),$5,0,NOW()) "
+                    "ON CONFLICT(provider,source,season,week) DO UPDATE SET "
+                    "state='fresh',last_attempt_at=NOW(),last_success_at=NOW(),"
+                    "last_complete_run_id=EXCLUDED.last_complete_run_id,"
+                    "consecutive_failures=0,updated_at=NOW()",
+                    kProvider, source.source, request.season, request.week, runId);
+            } else {
+                transaction.exec_params(
+                    "INSERT INTO stat_source_freshness "
+                    "(provider,source,season,week,state,last_attempt_at,consecutive_failures,updated_at) "
+                    "VALUES($1,$2,$3,$4,'unavailable',NOW(),1,NOW()) "
+                    "ON CONFLICT(provider,source,season,week) DO UPDATE SET "
+                    "state=CASE WHEN stat_source_freshness.last_success_at IS NULL "
+                    "THEN 'unavailable' ELSE 'partial' END,"
+                    "last_attempt_at=NOW(),consecutive_failures="
+                    "stat_source_freshness.consecutive_failures+1,updated_at=NOW()",
+                    kProvider, source.source, request.season, request.week);
+            }
+        }
 
         transaction.exec_params(
-            "UPDATE stat_ingest_runs SET status=$2,rows_changed=0,error_summary=$3,"
+            "UPDATE stat_ingest_runs SET status=$2,rows_changed=$3,error_summary=$4,"
             "completed_at=NOW() WHERE id=$1",
-            runId, toString(status), errorSummary);
-
-        if (succeeded) {
-            transaction.exec_params(
-                "INSERT INTO stat_source_freshness "
-                "(provider,source,season,week,state,last_attempt_at,last_success_at,"
-                "last_complete_run_id,consecutive_failures,updated_at) "
-                "VALUES($1,$2,$3,$4,'fresh',NOW(),NOW(),$5,0,NOW()) "
-                "ON CONFLICT(provider,source,season,week) DO UPDATE SET "
-                "state='fresh',last_attempt_at=NOW(),last_success_at=NOW(),"
-                "last_complete_run_id=EXCLUDED.last_complete_run_id,"
-                "consecutive_failures=0,updated_at=NOW()",
-                kProvider, kSource, request.season, request.week, runId);
-        } else {
-            transaction.exec_params(
-                "INSERT INTO stat_source_freshness "
-                "(provider,source,season,week,state,last_attempt_at,consecutive_failures,updated_at) "
-                "VALUES($1,$2,$3,$4,'unavailable',NOW(),1,NOW()) "
-                "ON CONFLICT(provider,source,season,week) DO UPDATE SET "
-                "state=CASE WHEN stat_source_freshness.last_success_at IS NULL "
-                "THEN 'unavailable' ELSE 'partial' END,"
-                "last_attempt_at=NOW(),consecutive_failures="
-                "stat_source_freshness.consecutive_failures+1,updated_at=NOW()",
-                kProvider, kSource, request.season, request.week);
-        }
+            runId, toString(status), static_cast<int>(rowsChanged), errorSummary);
 
         Json::Value metadata;
         metadata["attempts"] = attempts;
         metadata["games"] = static_cast<Json::UInt64>(ingest.games);
         metadata["liveGames"] = static_cast<Json::UInt64>(ingest.liveGames);
-        metadata["apiCalls"] = static_cast<Json::UInt64>(ingest.apiCalls);
-        metadata["scoringRefreshQueued"] = 0;
+        metadata["apiCalls"] = static_cast<Json::UInt64>(ingest.apiCalls + playerStats.apiCalls);
+        metadata["playerStatCode"] = playerStats.code;
+        metadata["playerStatRowsChanged"] = static_cast<Json::UInt64>(rowsChanged);
+        metadata["scoringRefreshQueued"] = static_cast<Json::UInt64>(playerStats.queuedLeagues);
+        const bool succeeded = status == RunStatus::succeeded;
+        const bool partial = status == RunStatus::partial;
         transaction.exec_params(
             "INSERT INTO ingest_operator_events "
             "(run_id,severity,event_type,message,metadata) "
             "VALUES($1,$2,$3,$4,$5::jsonb)",
             runId,
-            succeeded ? "info" : "error",
-            succeeded ? "live_ingest_succeeded" : "live_ingest_failed",
-            succeeded ? "CFBD live score cache refresh completed." :
-                        "CFBD live score cache refresh failed.",
+            succeeded ? "info" : partial ? "warning" : "error",
+            succeeded ? "live_ingest_succeeded" : partial ? "live_ingest_partial" : "live_ingest_failed",
+            succeeded ? "CFBD live stat refresh completed." :
+            partial   ? "CFBD live stat refresh completed for some sources." :
+                        "CFBD live stat refresh failed.",
             compactJson(metadata));
         transaction.commit();
     } catch (const std::exception &error) {
@@ -288,6 +306,41 @@ Json::Value unavailableStatus(const std::string &message) {
     return payload;
 }
 
+// Reads the scheduler's inputs in one round trip: live games and the next
+// kickoff from the merged live_score_cache payload, and this month's CFBD
+// calls across every resource in ingestion_runs. Games more than four hours
+// past kickoff are assumed over even if the cache never saw them finish.
+// nullopt when the window cannot be read.
+std::optional<LiveWindow> loadLiveWindow() {
+    LiveWindow window;
+    const auto dbUrl = cff::config::readEnv("DB_URL");
+    if (!dbUrl) return std::nullopt;
+    try {
+        pqxx::connection connection{*dbUrl};
+        pqxx::read_transaction transaction{connection};
+        const auto rows = transaction.exec(
+            "SELECT COALESCE((SELECT live_game_count FROM live_score_cache WHERE id=1),0),"
+            "(SELECT EXTRACT(EPOCH FROM MIN(kickoff)-NOW())::bigint FROM ("
+            "SELECT (game->>'startDate')::timestamptz AS kickoff "
+            "FROM live_score_cache,jsonb_array_elements(payload) game "
+            "WHERE id=1 AND jsonb_typeof(payload)='array' "
+            "AND game->>'startDate' ~ '^[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}' "
+            "AND lower(COALESCE(game->>'status','')) NOT IN ('final','completed')) games "
+            "WHERE kickoff > NOW() - interval '4 hours'),"
+            "(SELECT COALESCE(SUM(call_count),0) FROM ingestion_runs "
+            "WHERE started_at >= date_trunc('month',NOW())),"
+            "EXTRACT(EPOCH FROM date_trunc('month',NOW()) + interval '1 month' - NOW())::bigint");
+        window.liveGames = rows[0][0].as<int>();
+        if (!rows[0][1].is_null()) window.secondsToKickoff = rows[0][1].as<long long>();
+        window.monthlyCalls = rows[0][2].as<long long>();
+        window.secondsLeftInMonth = rows[0][3].as<long long>();
+    } catch (const std::exception &error) {
+        std::cerr << "[live-stats] unable to read the live window: " << error.what() << std::endl;
+        return std::nullopt;
+    }
+    return window;
+}
+
 } // namespace
 
 int configuredLiveStatSeason() {
@@ -361,24 +414,22 @@ Json::Value runCfbdLiveStatWorker(const WorkerRequest &provided) {
         return payload;
     }
 
+    // One scoreboard attempt per run. A retryable failure reports when the
+    // next attempt is due instead of sleeping with the run claimed; the
+    // scheduler, or an operator, re-runs it with force after the delay.
     const int maxAttempts = static_cast<int>(
         cff::config::readSizeEnv("CFF_LIVE_STAT_MAX_ATTEMPTS", 3, 5));
-    const int baseBackoffMs = static_cast<int>(
-        cff::config::readSizeEnv("CFF_LIVE_STAT_RETRY_BASE_MS", 750, 10000));
-
-    LiveScoreIngestResult ingest;
-    int attempts = 0;
-    for (int attempt = 1; attempt <= maxAttempts; ++attempt) {
-        attempts = attempt;
-        ingest = cff::runLiveScoreIngestOnce();
-        if (ingest.errors.empty()) break;
-        if (attempt >= maxAttempts || !retryable(ingest.errors)) break;
-
-        const int delay = baseBackoffMs * (1 << (attempt - 1));
+    const std::chrono::milliseconds baseBackoff{
+        cff::config::readSizeEnv("CFF_LIVE_STAT_RETRY_BASE_MS", 750, 10000)};
+    const int attempts = std::clamp(request.attempt, 1, maxAttempts);
+
+    const auto ingest = cff::runLiveScoreIngestOnce();
+    if (!ingest.errors.empty() && attempts < maxAttempts && retryable(ingest.errors)) {
+        const auto delay = retryDelay(attempts, baseBackoff);
         Json::Value metadata;
-        metadata["attempt"] = attempt;
-        metadata["nextAttempt"] = attempt + 1;
-        metadata["delayMs"] = delay;
+        metadata["attempt"] = attempts;
+        metadata["nextAttempt"] = attempts + 1;
+        metadata["delayMs"] = static_cast<Json::Int64>(delay.count());
         metadata["error"] = joinErrors(ingest.errors);
         insertOperatorEvent(
             *dbUrl,
@@ -387,34 +438,74 @@ Json::Value runCfbdLiveStatWorker(const WorkerRequest &provided) {
             "live_ingest_retry",
             "CFBD live score cache refresh will be retried.",
             metadata);
-        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        payload["retry"]["attempt"] = attempts + 1;
+        payload["retry"]["delayMs"] = static_cast<Json::Int64>(delay.count());
+    }
+
+    SourceResult scoreboard;
+    scoreboard.source = kScoreboardSource;
+    scoreboard.attempted = true;
+    scoreboard.succeeded = ingest.errors.empty();
+    scoreboard.rows = ingest.games;
+    scoreboard.error = joinErrors(ingest.errors);
+    scoreboard.observedAt = std::chrono::system_clock::now();
+
+    // Player stats need a concrete week; a week another worker is writing or
+    // that is backing off after a provider failure is left alone this run.
+    // A retry only repeats the failed scoreboard attempt.
+    PlayerStatIngestResult playerStats;
+    SourceResult statSource;
+    statSource.source = kPlayerStatSource;
+    if (attempts > 1) {
+        playerStats.code = "scoreboard_retry";
+    } else if (request.week >= 1) {
+        playerStats = cff::runCfbdPlayerStatIngestOnce(request.season, request.week);
+        statSource.attempted = playerStats.code != "ingestion_run_active" &&
+                               playerStats.code != "ingestion_backoff_active";
+        statSource.succeeded = playerStats.code == "applied";
+        statSource.rows = playerStats.received;
+        statSource.changed = playerStats.inserted + playerStats.corrected;
+        statSource.error = joinErrors(playerStats.errors);
+        statSource.observedAt = std::chrono::system_clock::now();
+    } else {
+        playerStats.code = "week_not_configured";
     }
 
-    SourceResult source;
-    source.source = kSource;
-    source.attempted = true;
-    source.succeeded = ingest.errors.empty();
-    source.rows = ingest.games;
-    source.error = joinErrors(ingest.errors);
-    source.observedAt = std::chrono::system_clock::now();
-    const auto finalStatus = aggregateStatus({source});
-    persistCompletedRun(*dbUrl, request, claim.runId, ingest, finalStatus, attempts);
+    const std::vector<SourceResult> sources{scoreboard, statSource};
+    const auto finalStatus = aggregateStatus(sources);
+    persistCompletedRun(*dbUrl, request, claim.runId, sources, ingest, playerStats, finalStatus, attempts);
 
     payload["status"] = toString(finalStatus);
     payload["attempts"] = attempts;
-    payload["apiCalls"] = static_cast<Json::UInt64>(ingest.apiCalls);
+    payload["apiCalls"] = static_cast<Json::UInt64>(ingest.apiCalls + playerStats.apiCalls);
     payload["games"] = static_cast<Json::UInt64>(ingest.games);
     payload["liveGames"] = static_cast<Json::UInt64>(ingest.liveGames);
     payload["scheduleGames"] = static_cast<Json::UInt64>(ingest.scheduleGames);
     payload["scheduleRefreshed"] = ingest.scheduleRefreshed;
-    if (!ingest.errors.empty()) {
+    payload["playerStats"]["code"] = playerStats.code;
+    payload["playerStats"]["runId"] = Json::Int64(playerStats.runId);
+    payload["playerStats"]["apiCalls"] = static_cast<Json::UInt64>(playerStats.apiCalls);
+    payload["playerStats"]["games"] = static_cast<Json::UInt64>(playerStats.games);
+    payload["playerStats"]["received"] = static_cast<Json::UInt64>(playerStats.received);
+    payload["playerStats"]["inserted"] = static_cast<Json::UInt64>(playerStats.inserted);
+    payload["playerStats"]["corrected"] = static_cast<Json::UInt64>(playerStats.corrected);
+    payload["playerStats"]["unchanged"] = static_cast<Json::UInt64>(playerStats.unchanged);
+    payload["playerStats"]["unknownPlayerRows"] = static_cast<Json::UInt64>(playerStats.unknownPlayerRows);
+    payload["playerStats"]["batches"] = static_cast<Json::UInt64>(playerStats.batches);
+    payload["playerStats"]["changedPlayers"] = static_cast<Json::UInt64>(playerStats.changedPlayers);
+    payload["scoringRefreshReady"] =
+        playerStats.code == "applied" && playerStats.inserted + playerStats.corrected > 0;
+    payload["scoringRefreshQueued"] = static_cast<Json::UInt64>(playerStats.queuedLeagues);
+    if (!ingest.errors.empty() || !playerStats.errors.empty()) {
         Json::Value errors{Json::arrayValue};
         for (const auto &error : ingest.errors) errors.append(error);
+        for (const auto &error : playerStats.errors) errors.append(error);
         payload["errors"] = errors;
     }
-    payload["note"] =
-        "The current adapter refreshes scoreboard and schedule cache data. "
-        "Fantasy scoring refresh remains disabled until the CFBD player-stat adapter is available.";
+    if (request.week < 1) {
+        payload["note"] = "Player stats were not refreshed because no week was requested or configured "
+                          "(CFF_CURRENT_WEEK).";
+    }
     return payload;
 }
 
@@ -428,8 +519,8 @@ Json::Value liveStatOperatorStatus(int season, int week) {
     payload["filter"]["season"] = season;
     payload["filter"]["week"] = week;
     payload["capabilities"]["scoreboardScheduleAdapter"] = true;
-    payload["capabilities"]["playerStatsAdapter"] = false;
-    payload["capabilities"]["scoringRefreshWorker"] = false;
+    payload["capabilities"]["playerStatsAdapter"] = true;
+    payload["capabilities"]["scoringRefreshWorker"] = true;
     payload["capabilities"]["durableRunClaiming"] = true;
     payload["capabilities"]["boundedRetries"] = true;
     payload["cache"] = cff::liveScoreIngestStatus();
@@ -541,25 +632,66 @@ void configureLiveStatWorker() {
         cff::config::readPositiveIntEnv("CFF_LIVE_STAT_INTERVAL_MINUTES");
     if (!runOnStartup && !intervalMinutes) return;
 
-    std::thread([runOnStartup, intervalMinutes]() {
-        const auto run = []() {
+    CadencePolicy policy;
+    if (intervalMinutes) policy.idle = std::chrono::minutes(*intervalMinutes);
+    // Scheduled runs are never forced, so polling faster than the dedupe
+    // window would only record duplicates.
+    const auto dedupeSeconds = static_cast<long long>(
+        cff::config::readSizeEnv("CFF_LIVE_STAT_DEDUPE_MINUTES", 2, 60)) * 60;
+    policy.live = std::chrono::seconds(std::max<long long>(
+        dedupeSeconds,
+        static_cast<long long>(cff::config::readSizeEnv("CFF_LIVE_STAT_LIVE_SECONDS", 120, 3600))));
+    policy.idle = std::max(policy.idle, policy.live);
+    policy.kickoffLead = std::chrono::minutes(
+        cff::config::readSizeEnv("CFF_LIVE_STAT_KICKOFF_LEAD_MINUTES", 30, 360));
+    policy.monthlyBudget = cff::config::readPositiveIntEnv("CFF_CFBD_MONTHLY_CALL_BUDGET").value_or(0);
+
+    std::thread([runOnStartup, intervalMinutes, policy]() mutable {
+        const auto run = [](int attempt) {
             WorkerRequest request;
             request.season = configuredLiveStatSeason();
             request.week = configuredLiveStatWeek();
+            request.attempt = attempt;
+            request.force = attempt > 1;
             const auto result = runCfbdLiveStatWorker(request);
             std::cout << "[live-stats] worker status="
                       << result.get("status", "unknown").asString()
                       << " code=" << result.get("code", "").asString()
                       << std::endl;
+            return result;
         };
 
-        if (runOnStartup) run();
-        if (!intervalMinutes) return;
-        std::cout << "[live-stats] scheduled worker enabled every "
-                  << *intervalMinutes << " minute(s)." << std::endl;
+        if (!intervalMinutes) {
+            run(1);
+            return;
+        }
+        std::cout << "[live-stats] adaptive worker enabled: live every " << policy.live.count()
+                  << "s, idle up to " << policy.idle.count() << "s." << std::endl;
+
+        bool due = runOnStartup;
+        int attempt = 1;
         while (true) {
-            std::this_thread::sleep_for(std::chrono::minutes(*intervalMinutes));
-            run();
+            std::optional<std::chrono::milliseconds> retryAfter;
+            if (due) {
+                const auto result = run(attempt);
+                if (result.isMember("retry")) {
+                    retryAfter = std::chrono::milliseconds(result["retry"]["delayMs"].asInt64());
+                }
+                const auto calls = result.get("apiCalls", 0).asInt64();
+                if (calls > 0) policy.callsPerRun = calls;
+            }
+
+            const auto cadence = nextCadence(loadLiveWindow(), policy);
+            due = cadence.run;
+            if (retryAfter && cadence.run) {
+                ++attempt;
+                std::this_thread::sleep_for(*retryAfter);
+                continue;
+            }
+            attempt = 1;
+            std::cout << "[live-stats] next refresh in " << cadence.wait.count()
+                      << "s (" << cadence.reason << ")." << std::endl;
+            std::this_thread::sleep_for(cadence.wait);
         }
     }).detach();
 }
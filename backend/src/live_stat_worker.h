@@ -11,13 +11,18 @@ struct WorkerRequest {
     int week{0};
     bool force{false};
     std::string runKey;
+    // 1 for a fresh run; a retry passes the "retry.attempt" of the run it
+    // follows, bounded by CFF_LIVE_STAT_MAX_ATTEMPTS, and repeats only the
+    // scoreboard source.
+    int attempt{1};
 };
 
 int configuredLiveStatSeason();
 int configuredLiveStatWeek();
 
 // Claims a durable CFBD live-score refresh run, executes the existing cache
-// adapter with bounded retries, and persists run/source/freshness telemetry.
+// adapter once, and persists run/source/freshness telemetry. A retryable
+// failure adds "retry" with the next attempt and its backoff delay.
 Json::Value runCfbdLiveStatWorker(const WorkerRequest &request);
 
 // Returns recent durable runs, source freshness, queue state, operator events,
@@ -25,7 +30,9 @@ Json::Value runCfbdLiveStatWorker(const WorkerRequest &request);
 Json::Value liveStatOperatorStatus(int season = 0, int week = -1);
 
 // Enables an optional detached worker using CFF_LIVE_STAT_ON_STARTUP and
-// CFF_LIVE_STAT_INTERVAL_MINUTES. No worker starts unless one is configured.
+// CFF_LIVE_STAT_INTERVAL_MINUTES. With an interval, the worker paces itself
+// from the cached schedule and the monthly CFBD call ledger, treating the
+// interval as its idle ceiling. No worker starts unless one is configured.
 void configureLiveStatWorker();
 
 } // namespace cff::live_stats
@@ -1,9 +1,14 @@
 #include "operations_routes.h"
 
 #include "app_config.h"
+#include "auth_session_store.h"
+#include "draft_clock.h"
+#include "draft_room_hub.h"
 #include "cfbd_ingest.h"
 #include "http_security.h"
+#include "ingest_runtime.h"
 #include "live_scores.h"
+#include "scoring_recalculation.h"
 
 #include <iostream>
 #include <memory>
@@ -12,20 +17,73 @@
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_executor.h"
+#include "db_pool.h"
+#include "db_statements.h"
 #endif
 
 namespace cff::operations {
 namespace {
 
-#ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *conn) const {
-        if (conn) {
-            PQfinish(conn);
-        }
+void appendErrors(Json::Value &payload, const std::vector<std::string> &errors) {
+    if (errors.empty()) {
+        return;
     }
-};
+    Json::Value values(Json::arrayValue);
+    for (const auto &error : errors) {
+        values.append(error);
+    }
+    payload["errors"] = values;
+}
+
+// Admin-triggered roster refreshes run here, off the IO threads, one at a
+// time.
+cff::ingest_runtime::IngestJobs &cfbdIngestJobs() {
+    static cff::ingest_runtime::IngestJobs jobs{[](cff::IngestProgress &progress) {
+        return cff::runCfbdIngestJob(progress);
+    }};
+    return jobs;
+}
+
+Json::Value ingestJobPayload(const cff::ingest_runtime::IngestJobSnapshot &job) {
+    Json::Value payload;
+    payload["jobId"] = job.id;
+    payload["status"] = job.state;
+    payload["phase"] = job.phase;
+    payload["requestedBy"] = job.requestedBy;
+    payload["startedAt"] = job.startedAt;
+    payload["finishedAt"] = job.finishedAt;
+    payload["cancelRequested"] = job.cancelRequested;
+    payload["statusUrl"] = "/api/admin/ingest/cfbd/jobs/" + job.id;
+    Json::Value progress;
+    progress["teamsExpected"] = static_cast<Json::UInt64>(job.teamsExpected);
+    progress["teamsFetched"] = static_cast<Json::UInt64>(job.teamsFetched);
+    progress["rowsStaged"] = static_cast<Json::UInt64>(job.rowsStaged);
+    progress["rowsMerged"] = static_cast<Json::UInt64>(job.rowsMerged);
+    payload["progress"] = progress;
+    payload["apiCalls"] = static_cast<Json::UInt64>(job.apiCalls);
+    if (job.result) {
+        payload["ingested"] = static_cast<Json::UInt64>(job.result->ingested);
+        payload["updated"] = static_cast<Json::UInt64>(job.result->updated);
+        payload["retired"] = static_cast<Json::UInt64>(job.result->retired);
+        payload["apiCalls"] = static_cast<Json::UInt64>(job.result->apiCalls);
+        payload["complete"] = job.result->complete;
+        appendErrors(payload, job.result->errors);
+    }
+    return payload;
+}
+
+drogon::HttpResponsePtr ingestJobNotFound(const std::string &jobId) {
+    Json::Value payload;
+    payload["status"] = "not_found";
+    payload["error"] = "No recent ingest job has id " + jobId + ".";
+    auto response = drogon::HttpResponse::newHttpJsonResponse(payload);
+    response->setStatusCode(drogon::k404NotFound);
+    return response;
+}
 
+#ifdef CFF_HAS_POSTGRES
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
         if (result) {
@@ -34,7 +92,7 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 
 bool databaseConfigured() {
@@ -43,18 +101,7 @@ bool databaseConfigured() {
 }
 
 PgConnPtr connectToDatabase() {
-    const auto url = cff::config::readEnv("DB_URL");
-    if (!url || url->empty()) {
-        return nullptr;
-    }
-
-    auto conn = PgConnPtr{PQconnectdb(url->c_str())};
-    if (PQstatus(conn.get()) != CONNECTION_OK) {
-        std::cerr << "[auth] Failed to connect to Postgres: "
-                  << PQerrorMessage(conn.get()) << std::endl;
-        return nullptr;
-    }
-    return conn;
+    return cff::db::acquireConnection();
 }
 
 PgResultPtr executeParameters(
@@ -81,6 +128,92 @@ bool resultOk(PGresult *result, ExecStatusType expected) {
     return result && PQresultStatus(result) == expected;
 }
 
+Json::Value databasePoolPayload() {
+    const auto metrics = cff::db::poolMetrics();
+    Json::Value pool;
+    pool["maxConnections"] = static_cast<Json::UInt64>(metrics.maxConnections);
+    pool["open"] = static_cast<Json::UInt64>(metrics.open);
+    pool["idle"] = static_cast<Json::UInt64>(metrics.idle);
+    pool["inUse"] = static_cast<Json::UInt64>(metrics.inUse);
+    pool["waiting"] = static_cast<Json::UInt64>(metrics.waiting);
+    pool["checkouts"] = static_cast<Json::UInt64>(metrics.checkouts);
+    pool["connectionsCreated"] = static_cast<Json::UInt64>(metrics.connectionsCreated);
+    pool["connectFailures"] = static_cast<Json::UInt64>(metrics.connectFailures);
+    pool["lifetimeRecycled"] = static_cast<Json::UInt64>(metrics.lifetimeRecycled);
+    pool["healthCheckFailures"] = static_cast<Json::UInt64>(metrics.healthCheckFailures);
+    pool["dirtyReturns"] = static_cast<Json::UInt64>(metrics.dirtyReturns);
+    pool["waits"] = static_cast<Json::UInt64>(metrics.waits);
+    pool["waitTimeouts"] = static_cast<Json::UInt64>(metrics.waitTimeouts);
+    pool["totalWaitMicros"] = static_cast<Json::UInt64>(metrics.totalWaitMicros);
+    pool["maxWaitMicros"] = static_cast<Json::UInt64>(metrics.maxWaitMicros);
+    return pool;
+}
+
+Json::Value databaseStatementsPayload() {
+    Json::Value statements{Json::arrayValue};
+    for (const auto &metrics : cff::db::statementMetrics()) {
+        Json::Value statement;
+        statement["name"] = metrics.name;
+        statement["calls"] = static_cast<Json::UInt64>(metrics.calls);
+        statement["failures"] = static_cast<Json::UInt64>(metrics.failures);
+        statement["prepares"] = static_cast<Json::UInt64>(metrics.prepares);
+        statement["totalMicros"] = static_cast<Json::UInt64>(metrics.totalMicros);
+        statement["maxMicros"] = static_cast<Json::UInt64>(metrics.maxMicros);
+        statements.append(statement);
+    }
+    return statements;
+}
+
+Json::Value databaseExecutorPayload() {
+    const auto metrics = cff::db::executorMetrics();
+    Json::Value executor;
+    executor["threads"] = static_cast<Json::UInt64>(metrics.threads);
+    executor["queueCapacity"] = static_cast<Json::UInt64>(metrics.queueCapacity);
+    executor["queued"] = static_cast<Json::UInt64>(metrics.queued);
+    executor["active"] = static_cast<Json::UInt64>(metrics.active);
+    executor["submitted"] = static_cast<Json::UInt64>(metrics.submitted);
+    executor["completed"] = static_cast<Json::UInt64>(metrics.completed);
+    executor["rejected"] = static_cast<Json::UInt64>(metrics.rejected);
+    executor["failed"] = static_cast<Json::UInt64>(metrics.failed);
+    executor["totalQueueMicros"] = static_cast<Json::UInt64>(metrics.totalQueueMicros);
+    executor["maxQueueMicros"] = static_cast<Json::UInt64>(metrics.maxQueueMicros);
+    return executor;
+}
+
+Json::Value sessionCachePayload() {
+    const auto metrics = cff::auth::sessionCacheMetrics();
+    Json::Value cache;
+    cache["entries"] = static_cast<Json::UInt64>(metrics.entries);
+    cache["revoked"] = static_cast<Json::UInt64>(metrics.revoked);
+    cache["hits"] = static_cast<Json::UInt64>(metrics.hits);
+    cache["negativeHits"] = static_cast<Json::UInt64>(metrics.negativeHits);
+    cache["misses"] = static_cast<Json::UInt64>(metrics.misses);
+    cache["evictions"] = static_cast<Json::UInt64>(metrics.evictions);
+    return cache;
+}
+
+Json::Value draftClockPayload() {
+    const auto metrics = cff::draft_clock::clockMetrics();
+    Json::Value clock;
+    clock["armed"] = static_cast<Json::UInt64>(metrics.armed);
+    clock["fired"] = static_cast<Json::UInt64>(metrics.fired);
+    clock["rooms"] = static_cast<Json::UInt64>(cff::draft_room::draftRoomHub().rooms());
+    return clock;
+}
+
+Json::Value scoringRecalculationPayload() {
+    const auto metrics = cff::scoring_recalculation::metrics();
+    Json::Value recalculation;
+    recalculation["drains"] = static_cast<Json::UInt64>(metrics.drains);
+    recalculation["leaguesRescored"] = static_cast<Json::UInt64>(metrics.leaguesRescored);
+    recalculation["leaguesUnchanged"] = static_cast<Json::UInt64>(metrics.leaguesUnchanged);
+    recalculation["leaguesSkipped"] = static_cast<Json::UInt64>(metrics.leaguesSkipped);
+    recalculation["leaguesFailed"] = static_cast<Json::UInt64>(metrics.leaguesFailed);
+    recalculation["profiles"] = static_cast<Json::UInt64>(metrics.profiles);
+    recalculation["lastDrainMillis"] = static_cast<Json::UInt64>(metrics.lastDrainMillis);
+    return recalculation;
+}
+
 Json::Value ingestionStatusPayload() {
     Json::Value payload;
     payload["configured"] = databaseConfigured();
@@ -92,6 +225,13 @@ Json::Value ingestionStatusPayload() {
     payload["ready"] = false;
     payload["runs"] = Json::Value{Json::arrayValue};
     payload["counts"] = Json::Value{Json::objectValue};
+    payload["databasePool"] = databasePoolPayload();
+    payload["databaseStatements"] = databaseStatementsPayload();
+    payload["databaseExecutor"] = databaseExecutorPayload();
+    payload["sessionCache"] = sessionCachePayload();
+    payload["draftClock"] = draftClockPayload();
+    payload["scoringRecalculation"] = scoringRecalculationPayload();
+    if (const auto job = cfbdIngestJobs().latest()) payload["latestJob"] = ingestJobPayload(*job);
 
     auto conn = connectToDatabase();
     if (!conn) {
@@ -172,17 +312,6 @@ Json::Value ingestionStatusPayload() {
 }
 #endif
 
-void appendErrors(Json::Value &payload, const std::vector<std::string> &errors) {
-    if (errors.empty()) {
-        return;
-    }
-    Json::Value values(Json::arrayValue);
-    for (const auto &error : errors) {
-        values.append(error);
-    }
-    payload["errors"] = values;
-}
-
 } // namespace
 
 void registerOperationsRoutes(
@@ -219,22 +348,64 @@ void registerOperationsRoutes(
                 return;
             }
 
-            const auto ingestResult = cff::runCfbdIngestOnce();
-            Json::Value payload;
-            payload["status"] =
-                ingestResult.errors.empty() ? "ok" : "partial";
-            payload["ingested"] =
-                static_cast<Json::UInt64>(ingestResult.ingested);
-            payload["updated"] =
-                static_cast<Json::UInt64>(ingestResult.updated);
-            payload["apiCalls"] =
-                static_cast<Json::UInt64>(ingestResult.apiCalls);
-            appendErrors(payload, ingestResult.errors);
-
+            // The refresh takes minutes; answer with the job and let the
+            // caller poll its status URL.
+            auto &jobs = cfbdIngestJobs();
+            const auto started = jobs.start(adminIdentity);
+            auto payload = ingestJobPayload(*jobs.find(started.id));
+            payload["alreadyRunning"] = !started.created;
             auto response = drogon::HttpResponse::newHttpJsonResponse(payload);
+            response->setStatusCode(drogon::k202Accepted);
+            callback(response);
+        },
+        {drogon::Post});
+
+    app.registerHandler(
+        "/api/admin/ingest/cfbd/jobs/{1}",
+        [jwtSecret](
+            const drogon::HttpRequestPtr &request,
+            std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+            const std::string &jobId) {
+            std::string adminIdentity;
+            if (!cff::http::requireAdmin(
+                    request, callback, jwtSecret, adminIdentity)) {
+                return;
+            }
+            const auto job = cfbdIngestJobs().find(jobId);
+            if (!job) {
+                callback(ingestJobNotFound(jobId));
+                return;
+            }
+            auto response = drogon::HttpResponse::newHttpJsonResponse(ingestJobPayload(*job));
             response->setStatusCode(drogon::k200OK);
             callback(response);
         },
+        {drogon::Get});
+
+    app.registerHandler(
+        "/api/admin/ingest/cfbd/jobs/{1}/cancel",
+        [jwtSecret](
+            const drogon::HttpRequestPtr &request,
+            std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+            const std::string &jobId) {
+            std::string adminIdentity;
+            if (!cff::http::requireAdmin(
+                    request, callback, jwtSecret, adminIdentity)) {
+                return;
+            }
+            auto &jobs = cfbdIngestJobs();
+            const bool cancelling = jobs.cancel(jobId);
+            const auto job = jobs.find(jobId);
+            if (!job) {
+                callback(ingestJobNotFound(jobId));
+                return;
+            }
+            // Cancellation is cooperative: the job reports "cancelled" once
+            // it reaches its next checkpoint.
+            auto response = drogon::HttpResponse::newHttpJsonResponse(ingestJobPayload(*job));
+            response->setStatusCode(cancelling ? drogon::k202Accepted : drogon::k409Conflict);
+            callback(response);
+        },
         {drogon::Post});
 
     app.registerHandler(
@@ -321,6 +492,10 @@ void registerOperationsRoutes(
         "/api/secure/ping", preflight, {drogon::Options});
     app.registerHandler(
         "/api/admin/ingest/cfbd", preflight, {drogon::Options});
+    app.registerHandler(
+        "/api/admin/ingest/cfbd/jobs/{1}", preflight, {drogon::Options});
+    app.registerHandler(
+        "/api/admin/ingest/cfbd/jobs/{1}/cancel", preflight, {drogon::Options});
     app.registerHandler(
         "/api/admin/ingest/cfbd/status", preflight, {drogon::Options});
     app.registerHandler(
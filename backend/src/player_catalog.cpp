@@ -1,44 +1,27 @@
 #include "player_catalog.h"
 
+#include "app_config.h"
+#include "player_search_index.h"
+
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 namespace {
 
-std::string toLower(const std::string &input) {
-    std::string lowered = input;
-    std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char ch) {
-        return static_cast<char>(std::tolower(ch));
-    });
-    return lowered;
-}
-
-std::vector<std::string> tokenizeQuery(const std::string &query) {
-    std::vector<std::string> tokens;
-    std::string current;
-    for (char ch : query) {
-        if (std::isspace(static_cast<unsigned char>(ch))) {
-            if (!current.empty()) {
-                tokens.push_back(toLower(current));
-                current.clear();
-            }
-        } else {
-            current.push_back(ch);
-        }
-    }
-    if (!current.empty()) tokens.push_back(toLower(current));
-    return tokens;
-}
-
 std::size_t clampLimit(std::size_t limit) {
     constexpr std::size_t kMax = 100;
     constexpr std::size_t kDefault = 25;
@@ -52,34 +35,21 @@ std::size_t clampOffset(std::size_t offset) {
 }
 
 #ifdef CFF_HAS_POSTGRES
-struct PgConnDeleter {
-    void operator()(PGconn *connection) const {
-        if (connection) PQfinish(connection);
-    }
-};
-
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
         if (result) PQclear(result);
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 
 PgConnPtr connectToDb() {
-    const char *url = std::getenv("DB_URL");
-    if (!url) {
+    if (!std::getenv("DB_URL")) {
         std::cerr << "[players] DB_URL is not set; player search unavailable." << std::endl;
         return nullptr;
     }
-    auto connection = PgConnPtr{PQconnectdb(url)};
-    if (PQstatus(connection.get()) != CONNECTION_OK) {
-        std::cerr << "[players] Failed to connect to Postgres: "
-                  << PQerrorMessage(connection.get()) << std::endl;
-        return nullptr;
-    }
-    return connection;
+    return cff::db::acquireConnection();
 }
 
 std::string buildLikeToken(const std::string &token) {
@@ -92,6 +62,87 @@ std::vector<const char*> buildParamPointers(const std::vector<std::string> &para
     for (const auto &param : params) pointers.push_back(param.c_str());
     return pointers;
 }
+
+// Count and newest write across all players, so both upserts and
+// retirements change it. Empty when the table cannot be read.
+std::string catalogSignature(PGconn *connection) {
+    PgResultPtr result{PQexec(connection, R"SQL(
+        SELECT COUNT(*) FILTER (WHERE active = TRUE) || '/' || COUNT(*) || '/' ||
+               COALESCE(MAX(updated_at)::text, '')
+        FROM players
+    )SQL")};
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK || PQntuples(result.get()) == 0) return "";
+    return PQgetvalue(result.get(), 0, 0);
+}
+
+std::mutex indexBuildMutex;
+std::string indexedSignature;
+
+// Rebuilds the index unless the catalog signature still matches the loaded
+// one (or `force` is set). Serialized so the ingest hook and the refresher
+// never publish out of order.
+bool loadSearchIndex(bool force) {
+    std::lock_guard<std::mutex> lock(indexBuildMutex);
+    auto connection = connectToDb();
+    if (!connection) return false;
+    const auto signature = catalogSignature(connection.get());
+    if (signature.empty()) return false;
+    if (!force && signature == indexedSignature && cff::player_search_index::current()) return true;
+
+    PgResultPtr result{PQexec(connection.get(), R"SQL(
+        SELECT
+            COALESCE(id, ''), COALESCE(full_name, ''), COALESCE(team, ''),
+            COALESCE(position, ''), COALESCE(conference, ''), COALESCE(year, ''),
+            COALESCE(season, 0), COALESCE(updated_at::text, '')
+        FROM players
+        WHERE active = TRUE
+    )SQL")};
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+        std::cerr << "[players] Search index load failed: " << PQerrorMessage(connection.get()) << std::endl;
+        return false;
+    }
+
+    const auto rows = PQntuples(result.get());
+    std::vector<cff::PlayerCard> players;
+    players.reserve(static_cast<std::size_t>(rows));
+    for (int row = 0; row < rows; ++row) {
+        cff::PlayerCard player;
+        player.id = PQgetvalue(result.get(), row, 0);
+        player.name = PQgetvalue(result.get(), row, 1);
+        player.team = PQgetvalue(result.get(), row, 2);
+        player.position = PQgetvalue(result.get(), row, 3);
+        player.conference = PQgetvalue(result.get(), row, 4);
+        player.classYear = PQgetvalue(result.get(), row, 5);
+        player.season = std::atoi(PQgetvalue(result.get(), row, 6));
+        player.updatedAt = PQgetvalue(result.get(), row, 7);
+        players.push_back(std::move(player));
+    }
+    cff::player_search_index::publish(
+        std::make_shared<const cff::player_search_index::PlayerSearchIndex>(std::move(players)));
+    indexedSignature = signature;
+    return true;
+}
+
+// Loads the index at boot and keeps picking up catalog writes from other
+// processes (the ESPN importer, another replica's ingest).
+void startSearchIndexLoader() {
+    static std::once_flag started;
+    std::call_once(started, [] {
+        if (!std::getenv("DB_URL")) return;
+        const std::chrono::seconds interval{
+            cff::config::readSizeEnv("CFF_PLAYER_INDEX_REFRESH_SECONDS", 300, 86400)};
+        std::thread([interval] {
+            for (;;) {
+                loadSearchIndex(false);
+                std::this_thread::sleep_for(interval);
+            }
+        }).detach();
+    });
+}
+
+std::shared_ptr<const cff::player_search_index::PlayerSearchIndex> searchIndex() {
+    return cff::player_search_index::current();
+}
 #endif
 
 } // namespace
@@ -117,10 +168,15 @@ std::vector<PlayerCard> searchPlayers(const std::string &query,
                                       const std::optional<std::string> &teamFilter,
                                       std::size_t limit,
                                       std::size_t offset) {
-    const auto tokens = tokenizeQuery(query);
+    const auto tokens = player_search_index::tokenizeQuery(query);
     std::vector<PlayerCard> results;
 
 #ifdef CFF_HAS_POSTGRES
+    if (const auto index = searchIndex()) {
+        return index->search(player_search_index::Query{
+            query, positionFilter, conferenceFilter, teamFilter, clampLimit(limit), clampOffset(offset)});
+    }
+
     auto connection = connectToDb();
     if (!connection) return results;
 
@@ -237,6 +293,28 @@ std::vector<PlayerCard> searchPlayers(const std::string &query,
     return results;
 }
 
+void startPlayerSearchIndexLoader() {
+#ifdef CFF_HAS_POSTGRES
+    startSearchIndexLoader();
+#endif
+}
+
+bool rebuildPlayerSearchIndex() {
+#ifdef CFF_HAS_POSTGRES
+    return loadSearchIndex(true);
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<const player_search_index::PlayerSearchIndex> playerSearchIndex() {
+#ifdef CFF_HAS_POSTGRES
+    return searchIndex();
+#else
+    return nullptr;
+#endif
+}
+
 Json::Value playerCatalogMeta() {
     Json::Value payload;
 #ifdef CFF_HAS_POSTGRES
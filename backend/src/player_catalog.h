@@ -1,12 +1,17 @@
 #pragma once
 
 #include <json/json.h>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace cff {
 
+namespace player_search_index {
+class PlayerSearchIndex;
+}
+
 struct PlayerCard {
     std::string id;
     std::string name;
@@ -22,7 +27,9 @@ struct PlayerCard {
 
 // Searches the active current-season player catalog. An empty query returns a
 // browsable player pool, while non-empty tokens match name, team, position,
-// and conference. Optional filters are applied server-side.
+// and conference. Optional filters are applied server-side. Answered from the
+// in-memory player search index once it is loaded; Postgres is only queried
+// while no index is available.
 std::vector<PlayerCard> searchPlayers(const std::string &query,
                                       const std::optional<std::string> &positionFilter,
                                       const std::optional<std::string> &conferenceFilter,
@@ -30,6 +37,19 @@ std::vector<PlayerCard> searchPlayers(const std::string &query,
                                       std::size_t limit = 25,
                                       std::size_t offset = 0);
 
+// Reloads the active catalog from Postgres and swaps in a new search index.
+// Called after each CFBD ingest; a background refresher also rebuilds when
+// the players table changes underneath another writer.
+bool rebuildPlayerSearchIndex();
+
+// Starts the background thread that builds the search index at boot and
+// rebuilds it when the catalog changes. Called once at startup; until the
+// first build lands, searches fall back to Postgres.
+void startPlayerSearchIndexLoader();
+
+// The loaded search index, or nullptr while none is available.
+std::shared_ptr<const player_search_index::PlayerSearchIndex> playerSearchIndex();
+
 // Public, non-sensitive summary used by the player browser to show roster
 // coverage and sync freshness without exposing admin ingestion details.
 Json::Value playerCatalogMeta();
@@ -0,0 +1,206 @@
+#include "player_search_index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <tuple>
+#include <utility>
+
+namespace cff::player_search_index {
+namespace {
+
+std::shared_ptr<const PlayerSearchIndex> published;
+
+std::string lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return value;
+}
+
+// Mirrors the CASE in the catalog's ORDER BY.
+int positionRank(const std::string &position) {
+    const auto key = lower(position);
+    if (key == "qb") return 1;
+    if (key == "rb") return 2;
+    if (key == "wr") return 3;
+    if (key == "te") return 4;
+    if (key == "k") return 5;
+    return 6;
+}
+
+bool hasBit(const std::vector<std::uint64_t> &bitmap, std::uint32_t bit) {
+    return (bitmap[bit / 64] >> (bit % 64)) & 1U;
+}
+
+void setBit(std::vector<std::uint64_t> &bitmap, std::uint32_t bit) {
+    bitmap[bit / 64] |= std::uint64_t{1} << (bit % 64);
+}
+
+} // namespace
+
+std::vector<std::string> tokenizeQuery(const std::string &text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (const char ch : text) {
+        if (std::isspace(static_cast<unsigned char>(ch))) {
+            if (!current.empty()) tokens.push_back(lower(std::move(current)));
+            current.clear();
+        } else {
+            current.push_back(ch);
+        }
+    }
+    if (!current.empty()) tokens.push_back(lower(std::move(current)));
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+    return tokens;
+}
+
+PlayerSearchIndex::PlayerSearchIndex(std::vector<PlayerCard> players) : players_(std::move(players)) {
+    std::stable_sort(players_.begin(), players_.end(), [](const PlayerCard &left, const PlayerCard &right) {
+        return std::make_tuple(-left.season, positionRank(left.position), std::cref(left.name), std::cref(left.id))
+            < std::make_tuple(-right.season, positionRank(right.position), std::cref(right.name), std::cref(right.id));
+    });
+
+    const auto words = (players_.size() + 63) / 64;
+    fantasyPositions_.assign(words, 0);
+    ordinals_.reserve(players_.size());
+    normalized_.reserve(players_.size());
+    for (std::uint32_t player = 0; player < players_.size(); ++player) {
+        const auto &card = players_[player];
+        ordinals_.emplace(card.id, player);
+        if (positionRank(card.position) < 6) setBit(fantasyPositions_, player);
+        normalized_.push_back(Normalized{lower(card.name), lower(card.team), lower(card.position),
+                                         lower(card.conference)});
+        const auto &fields = normalized_.back();
+        for (const auto *field : {&fields.name, &fields.team, &fields.position, &fields.conference}) {
+            for (std::size_t start = 0; start < field->size(); ++start) {
+                for (std::size_t length = 1; length <= 3 && start + length <= field->size(); ++length) {
+                    auto &list = grams_[field->substr(start, length)];
+                    if (list.empty() || list.back() != player) list.push_back(player);
+                }
+            }
+        }
+        auto mark = [&](std::unordered_map<std::string, Bitmap> &bitmaps, const std::string &value) {
+            auto &bitmap = bitmaps[value];
+            if (bitmap.empty()) bitmap.assign(words, 0);
+            setBit(bitmap, player);
+        };
+        mark(positions_, fields.position);
+        mark(conferences_, fields.conference);
+        mark(teams_, fields.team);
+    }
+}
+
+const PlayerSearchIndex::Postings *PlayerSearchIndex::postings(const std::string &gram) const {
+    const auto found = grams_.find(gram);
+    return found == grams_.end() ? nullptr : &found->second;
+}
+
+Bitmap PlayerSearchIndex::bitmapOf(const std::vector<std::string> &playerIds) const {
+    Bitmap bitmap((players_.size() + 63) / 64, 0);
+    for (const auto &id : playerIds) {
+        const auto found = ordinals_.find(id);
+        if (found != ordinals_.end()) setBit(bitmap, found->second);
+    }
+    return bitmap;
+}
+
+bool PlayerSearchIndex::matches(std::uint32_t player, const std::string &token) const {
+    const auto &fields = normalized_[player];
+    return fields.name.find(token) != std::string::npos
+        || fields.team.find(token) != std::string::npos
+        || fields.position.find(token) != std::string::npos
+        || fields.conference.find(token) != std::string::npos;
+}
+
+// AND of the requested filter bitmaps minus the excluded players; nullopt
+// when nothing applies. A value nobody has yields an all-zero bitmap.
+std::optional<Bitmap> PlayerSearchIndex::filterBitmap(const Query &query) const {
+    std::optional<Bitmap> combined;
+    auto apply = [&](const std::unordered_map<std::string, Bitmap> &bitmaps, const std::optional<std::string> &value) {
+        if (!value || value->empty()) return;
+        const auto found = bitmaps.find(lower(*value));
+        if (!combined) combined = Bitmap((players_.size() + 63) / 64, ~std::uint64_t{0});
+        for (std::size_t word = 0; word < combined->size(); ++word) {
+            (*combined)[word] &= found == bitmaps.end() ? 0 : found->second[word];
+        }
+    };
+    apply(positions_, query.position);
+    apply(conferences_, query.conference);
+    apply(teams_, query.team);
+    if (query.fantasyPositionsOnly) {
+        if (!combined) combined = Bitmap((players_.size() + 63) / 64, ~std::uint64_t{0});
+        for (std::size_t word = 0; word < combined->size(); ++word) {
+            (*combined)[word] &= fantasyPositions_[word];
+        }
+    }
+    if (query.excluded && query.excluded->size() == (players_.size() + 63) / 64) {
+        if (!combined) combined = Bitmap((players_.size() + 63) / 64, ~std::uint64_t{0});
+        for (std::size_t word = 0; word < combined->size(); ++word) {
+            (*combined)[word] &= ~(*query.excluded)[word];
+        }
+    }
+    return combined;
+}
+
+std::vector<PlayerCard> PlayerSearchIndex::search(const Query &query) const {
+    std::vector<PlayerCard> results;
+    if (query.limit == 0) return results;
+    const auto filter = filterBitmap(query);
+    const auto tokens = tokenizeQuery(query.text);
+
+    // Drive from the shortest posting list among the tokens: the whole token
+    // when it is a gram itself, otherwise its rarest trigram.
+    const Postings *driver = nullptr;
+    for (const auto &token : tokens) {
+        const auto grams = token.size() <= 3 ? std::size_t{1} : token.size() - 2;
+        for (std::size_t start = 0; start < grams; ++start) {
+            const auto *list = postings(token.size() <= 3 ? token : token.substr(start, 3));
+            if (!list) return results;
+            if (!driver || list->size() < driver->size()) driver = list;
+        }
+    }
+
+    std::size_t skipped = 0;
+    auto accept = [&](std::uint32_t player) {
+        if (filter && !hasBit(*filter, player)) return false;
+        for (const auto &token : tokens) {
+            if (!matches(player, token)) return false;
+        }
+        if (skipped < query.offset) {
+            ++skipped;
+            return false;
+        }
+        results.push_back(players_[player]);
+        return results.size() >= query.limit;
+    };
+
+    if (driver) {
+        for (const auto player : *driver) {
+            if (accept(player)) break;
+        }
+    } else if (filter) {
+        // Browsing a filtered pool: walk only the set bits.
+        for (std::size_t word = 0; word < filter->size(); ++word) {
+            for (auto bits = (*filter)[word]; bits != 0; bits &= bits - 1) {
+                const auto player = static_cast<std::uint32_t>(word * 64 + __builtin_ctzll(bits));
+                if (accept(player)) return results;
+            }
+        }
+    } else {
+        for (std::uint32_t player = 0; player < players_.size(); ++player) {
+            if (accept(player)) break;
+        }
+    }
+    return results;
+}
+
+void publish(std::shared_ptr<const PlayerSearchIndex> index) {
+    std::atomic_store(&published, std::move(index));
+}
+
+std::shared_ptr<const PlayerSearchIndex> current() {
+    return std::atomic_load(&published);
+}
+
+} // namespace cff::player_search_index
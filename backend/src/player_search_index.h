@@ -0,0 +1,87 @@
+#pragma once
+
+#include "player_catalog.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cff::player_search_index {
+
+using Bitmap = std::vector<std::uint64_t>;
+
+struct Query {
+    std::string text;
+    std::optional<std::string> position;
+    std::optional<std::string> conference;
+    std::optional<std::string> team;
+    std::size_t limit{25};
+    std::size_t offset{0};
+    // Only QB/RB/WR/TE/K, the positions a fantasy roster can hold.
+    bool fantasyPositionsOnly{false};
+    // Players whose bit is set are skipped, e.g. a league's rostered players
+    // from bitmapOf(). Must come from this index.
+    const Bitmap *excluded{nullptr};
+};
+
+// Immutable, memory-resident view of the active player catalog. Players are
+// stored in the catalog's rank order (season desc, QB/RB/WR/TE/K first, then
+// name), every posting list and bitmap is keyed by that rank, so a search is
+// an intersection walked front to back that stops once the page is full.
+//
+// Query tokens match case-insensitive substrings of name, team, position or
+// conference, like the ILIKE '%token%' search it replaces; filters are
+// case-insensitive exact matches. '%' and '_' are matched literally.
+class PlayerSearchIndex {
+public:
+    explicit PlayerSearchIndex(std::vector<PlayerCard> players);
+
+    std::vector<PlayerCard> search(const Query &query) const;
+    std::size_t size() const { return players_.size(); }
+
+    // Bitmap over this index's players with the given ids set; ids that are
+    // not in the catalog are ignored.
+    Bitmap bitmapOf(const std::vector<std::string> &playerIds) const;
+
+private:
+    using Postings = std::vector<std::uint32_t>;
+
+    struct Normalized {
+        std::string name;
+        std::string team;
+        std::string position;
+        std::string conference;
+    };
+
+    const Postings *postings(const std::string &gram) const;
+    bool matches(std::uint32_t player, const std::string &token) const;
+    std::optional<Bitmap> filterBitmap(const Query &query) const;
+
+    std::vector<PlayerCard> players_;
+    std::vector<Normalized> normalized_;
+    // Postings for every 1-, 2- and 3-byte gram of each normalized field.
+    // Tokens of up to three bytes are answered exactly by one list; longer
+    // tokens intersect their trigram lists and verify the survivors.
+    std::unordered_map<std::string, Postings> grams_;
+    std::unordered_map<std::string, Bitmap> positions_;
+    std::unordered_map<std::string, Bitmap> conferences_;
+    std::unordered_map<std::string, Bitmap> teams_;
+    Bitmap fantasyPositions_;
+    std::unordered_map<std::string, std::uint32_t> ordinals_;
+};
+
+// Whitespace-separated, lower-cased, de-duplicated search tokens. Shared by
+// the index and the catalog's SQL fallback so both match the same players.
+std::vector<std::string> tokenizeQuery(const std::string &text);
+
+// Swaps in a freshly built index; readers holding the previous one keep it.
+void publish(std::shared_ptr<const PlayerSearchIndex> index);
+
+// Current index, or nullptr before the first successful load.
+std::shared_ptr<const PlayerSearchIndex> current();
+
+} // namespace cff::player_search_index
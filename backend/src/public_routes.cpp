@@ -2,6 +2,7 @@
 
 #ifdef DROGON_FOUND
 #include "http_security.h"
+#include "live_score_index.h"
 #include "live_scores.h"
 #include "player_catalog.h"
 
@@ -26,6 +27,84 @@ std::optional<std::string> getOptionalParam(
     return value;
 }
 
+std::optional<unsigned long long> unsignedParam(const drogon::HttpRequestPtr &request, const std::string &key) {
+    const auto value = request->getParameter(key);
+    if (value.empty()) return std::nullopt;
+    char *end = nullptr;
+    const auto parsed = std::strtoull(value.c_str(), &end, 10);
+    if (end == value.c_str() || *end != '\0') return std::nullopt;
+    return parsed;
+}
+
+// ?week=N, ?live=true and ?since=<version> read the indexed store instead of
+// the full snapshot. Unparseable values are ignored, like the player search
+// parameters.
+std::optional<cff::live_score_index::Query> liveScoreQuery(const drogon::HttpRequestPtr &request) {
+    cff::live_score_index::Query query;
+    if (const auto week = unsignedParam(request, "week"); week && *week > 0 && *week < 100) {
+        query.week = static_cast<int>(*week);
+    }
+    const auto live = request->getParameter("live");
+    query.liveOnly = live == "true" || live == "1";
+    query.since = unsignedParam(request, "since");
+    if (!query.week && !query.liveOnly && !query.since) return std::nullopt;
+    return query;
+}
+
+drogon::HttpResponsePtr indexedLiveScoreResponse(const drogon::HttpRequestPtr &request,
+                                                 const cff::live_score_index::Query &query) {
+    const auto result = cff::live_score_index::liveScoreIndex().query(query);
+    const auto etag = "\"ix-" + std::to_string(result.version) + "-" + std::to_string(query.week.value_or(0))
+        + (query.liveOnly ? "-live" : "") + (query.since ? "-" + std::to_string(*query.since) : "") + "\"";
+    auto response = drogon::HttpResponse::newHttpResponse();
+    response->addHeader("Cache-Control", "no-cache");
+    response->addHeader("ETag", etag);
+    if (cff::live_score_snapshot::etagMatches(request->getHeader("if-none-match"), etag)) {
+        response->setStatusCode(drogon::k304NotModified);
+        return response;
+    }
+    response->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    response->setBody(result.body);
+    return response;
+}
+
+// Serves the published snapshot as-is: no database read and no JSON work,
+// only a header check and a copy of the chosen encoding.
+drogon::HttpResponsePtr liveScoreResponse(const drogon::HttpRequestPtr &request) {
+    using cff::live_score_snapshot::Encoding;
+    if (const auto query = liveScoreQuery(request)) return indexedLiveScoreResponse(request, *query);
+    const auto snapshot = cff::liveScoreSnapshot();
+    auto response = drogon::HttpResponse::newHttpResponse();
+    response->addHeader("Cache-Control", "no-cache");
+    response->addHeader("Vary", "Accept-Encoding");
+    if (!snapshot) {
+        response->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+        response->setBody("[]");
+        return response;
+    }
+    response->addHeader("ETag", snapshot->etag);
+    if (cff::live_score_snapshot::etagMatches(request->getHeader("if-none-match"), snapshot->etag)) {
+        response->setStatusCode(drogon::k304NotModified);
+        return response;
+    }
+    response->setStatusCode(drogon::k200OK);
+    response->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    switch (cff::live_score_snapshot::preferredEncoding(request->getHeader("accept-encoding"), *snapshot)) {
+    case Encoding::Brotli:
+        response->addHeader("Content-Encoding", "br");
+        response->setBody(snapshot->brotli);
+        break;
+    case Encoding::Gzip:
+        response->addHeader("Content-Encoding", "gzip");
+        response->setBody(snapshot->gzip);
+        break;
+    case Encoding::Identity:
+        response->setBody(snapshot->body);
+        break;
+    }
+    return response;
+}
+
 } // namespace
 
 namespace cff::public_api {
@@ -43,13 +122,9 @@ void registerPublicRoutes(
 
     app.registerHandler(
            "/api/scores/live",
-           [](const drogon::HttpRequestPtr &,
+           [](const drogon::HttpRequestPtr &request,
               std::function<void(const drogon::HttpResponsePtr &)> &&callback) {
-               auto response = drogon::HttpResponse::newHttpJsonResponse(
-                   cff::cachedLiveScorePayload()
-               );
-               response->setStatusCode(drogon::k200OK);
-               callback(response);
+               callback(liveScoreResponse(request));
            },
            {drogon::Get}
        )
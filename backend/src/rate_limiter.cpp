@@ -0,0 +1,117 @@
+#include "rate_limiter.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace cff::rate_limit {
+namespace {
+
+constexpr std::size_t kProbeRun = 16;
+
+std::uint64_t mix(std::uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+std::size_t roundUpPowerOfTwo(std::size_t value) {
+    std::size_t rounded = 1;
+    while (rounded < value) rounded <<= 1;
+    return rounded;
+}
+
+} // namespace
+
+ShardedRateLimiter::ShardedRateLimiter(std::size_t capacity, std::size_t shards) {
+    shards = std::max<std::size_t>(shards, 1);
+    slotsPerShard_ = roundUpPowerOfTwo(std::max(kProbeRun, (capacity + shards - 1) / shards));
+    shards_.reserve(shards);
+    for (std::size_t index = 0; index < shards; ++index) {
+        auto shard = std::make_unique<Shard>();
+        shard->slots.resize(slotsPerShard_);
+        shards_.push_back(std::move(shard));
+    }
+}
+
+double ShardedRateLimiter::estimate(const Slot &slot, std::int64_t at, std::int64_t window) {
+    const auto aligned = at - at % window;
+    auto previous = slot.previous;
+    auto current = slot.current;
+    if (aligned != slot.windowStart) {
+        previous = aligned - slot.windowStart == window ? slot.current : 0;
+        current = 0;
+    }
+    const auto overlap = static_cast<double>(window - (at - aligned)) / static_cast<double>(window);
+    return static_cast<double>(previous) * overlap + static_cast<double>(current);
+}
+
+ShardedRateLimiter::Slot *ShardedRateLimiter::slotFor(Shard &shard,
+                                                      std::uint64_t hash,
+                                                      std::size_t limit,
+                                                      std::int64_t now,
+                                                      std::int64_t window) {
+    const auto mask = slotsPerShard_ - 1;
+    const auto home = static_cast<std::size_t>(hash) & mask;
+    Slot *reusable = nullptr;
+    Slot *lightest = nullptr;
+    double lightestLoad = 0;
+    for (std::size_t step = 0; step < kProbeRun; ++step) {
+        auto &slot = shard.slots[(home + step) & mask];
+        if (slot.hash == hash) return &slot;
+        if (reusable) continue;
+        if (slot.hash == 0 || slot.expiresAt <= now) {
+            reusable = &slot;
+            continue;
+        }
+        const auto load = estimate(slot, now, window);
+        if (!lightest || load < lightestLoad
+            || (load == lightestLoad && slot.expiresAt < lightest->expiresAt)) {
+            lightest = &slot;
+            lightestLoad = load;
+        }
+    }
+    if (!reusable) {
+        // Every slot is live. Recycling one that is still limited would let a
+        // flood of fresh keys reset it, so the new key is refused instead.
+        if (lightestLoad >= static_cast<double>(limit)) return nullptr;
+        reusable = lightest;
+    }
+    *reusable = Slot{};
+    reusable->hash = hash;
+    reusable->windowStart = now - now % window;
+    return reusable;
+}
+
+bool ShardedRateLimiter::take(std::string_view key,
+                              std::size_t limit,
+                              std::chrono::nanoseconds window,
+                              Clock::time_point now) {
+    if (limit == 0) return false;
+    const auto hashed = mix(std::hash<std::string_view>{}(key));
+    const auto hash = hashed == 0 ? 1 : hashed;
+    const auto length = std::max<std::int64_t>(window.count(), 1);
+    const auto at = std::max<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count(), 0);
+    const auto aligned = at - at % length;
+
+    auto &shard = *shards_[static_cast<std::size_t>(hash >> 40) % shards_.size()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto *slot = slotFor(shard, hash, limit, at, length);
+    if (!slot) return false;
+    const auto load = estimate(*slot, at, length);
+    if (aligned != slot->windowStart) {
+        slot->previous = aligned - slot->windowStart == length ? slot->current : 0;
+        slot->current = 0;
+        slot->windowStart = aligned;
+    }
+    // Rejected attempts still keep the slot live, so a key that keeps
+    // hammering stays limited instead of aging out under a flood.
+    slot->expiresAt = aligned + 2 * length;
+    if (load >= static_cast<double>(limit)) return false;
+    if (slot->current < std::numeric_limits<std::uint32_t>::max()) ++slot->current;
+    return true;
+}
+
+} // namespace cff::rate_limit
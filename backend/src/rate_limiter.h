@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace cff::rate_limit {
+
+using Clock = std::chrono::steady_clock;
+
+// Fixed-memory sliding-window limiter. Keys are hashed to 64 bits and kept
+// in a preallocated open-addressed table split into independently locked
+// shards, so concurrent requests only contend when they land on the same
+// shard and no attempt allocates.
+//
+// Each key holds the attempt counts of the current and previous fixed
+// windows; an attempt is admitted while the previous count, weighted by how
+// much of it still overlaps the sliding window, plus the current count stays
+// below the limit. Rejected attempts are not counted, but they do keep the
+// key's slot live.
+//
+// Expiry is implicit: a slot whose previous window has fully slid out
+// carries no state and is reused by the next key probing past it. When every
+// slot in a key's probe run is live, the one with the lowest weighted count
+// (then the least recently active) is recycled, so a flood of one-shot keys
+// displaces only other light keys. If even that slot is at the limit, the
+// new key is refused rather than resetting a limited one.
+class ShardedRateLimiter {
+public:
+    // `capacity` is rounded up so every shard holds a power-of-two number of
+    // slots.
+    explicit ShardedRateLimiter(std::size_t capacity = 1 << 16, std::size_t shards = 64);
+
+    bool take(std::string_view key,
+              std::size_t limit,
+              std::chrono::nanoseconds window,
+              Clock::time_point now = Clock::now());
+
+    std::size_t capacity() const { return shards_.size() * slotsPerShard_; }
+
+private:
+    struct Slot {
+        std::uint64_t hash{0};
+        std::int64_t windowStart{0};
+        std::int64_t expiresAt{0};
+        std::uint32_t previous{0};
+        std::uint32_t current{0};
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<Slot> slots;
+    };
+
+    static double estimate(const Slot &slot, std::int64_t at, std::int64_t window);
+    Slot *slotFor(Shard &shard,
+                  std::uint64_t hash,
+                  std::size_t limit,
+                  std::int64_t now,
+                  std::int64_t window);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t slotsPerShard_{0};
+};
+
+} // namespace cff::rate_limit
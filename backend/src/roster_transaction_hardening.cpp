@@ -10,16 +10,22 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
+#include "db_statements.h"
 #endif
 
 #include "app_config.h"
 #include "http_security.h"
+#include "league_access_cache.h"
 #include "league_roster.h"
 #include "roster_transaction.h"
+#include "route_dispatch.h"
 
 namespace {
 
@@ -105,32 +111,6 @@ std::optional<std::string> accountEmail(const drogon::HttpRequestPtr &request) {
     return canonicalEmail(*email);
 }
 
-std::string pathLeagueId(const std::string &path, const std::string &suffix) {
-    const std::string prefix = "/api/leagues/";
-    if (path.rfind(prefix, 0) != 0 || suffix.empty()) return "";
-    if (path.size() <= prefix.size() + suffix.size()) return "";
-    if (path.substr(path.size() - suffix.size()) != suffix) return "";
-    return path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
-}
-
-bool parseRosterSlotPath(const std::string &path,
-                         std::string &leagueId,
-                         std::string &playerId) {
-    const std::string prefix = "/api/leagues/";
-    const std::string marker = "/roster/";
-    const std::string suffix = "/slot";
-    if (path.rfind(prefix, 0) != 0 || path.size() <= prefix.size() + marker.size() + suffix.size()) {
-        return false;
-    }
-    if (path.substr(path.size() - suffix.size()) != suffix) return false;
-    const auto markerAt = path.find(marker, prefix.size());
-    if (markerAt == std::string::npos) return false;
-    leagueId = path.substr(prefix.size(), markerAt - prefix.size());
-    playerId = path.substr(markerAt + marker.size(),
-                           path.size() - markerAt - marker.size() - suffix.size());
-    return !leagueId.empty() && !playerId.empty() && playerId.find('/') == std::string::npos;
-}
-
 #ifdef CFF_HAS_POSTGRES
 #include "roster_transaction_hardening_db.inc"
 #include "roster_transaction_hardening_payload.inc"
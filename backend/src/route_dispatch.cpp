@@ -0,0 +1,64 @@
+#include "route_dispatch.h"
+
+#include "db_offload.h"
+
+#include <utility>
+#include <vector>
+
+namespace cff::http {
+namespace {
+
+struct DispatchRegistry {
+    RouteTable table;
+    std::vector<RouteHandler> handlers;
+};
+
+// Function-local so modules in other translation units can register from
+// their own static initialisers regardless of link order.
+DispatchRegistry &registry() {
+    static DispatchRegistry instance;
+    return instance;
+}
+
+void dispatchAdvice(const drogon::HttpRequestPtr &request,
+                    drogon::AdviceCallback &&callback,
+                    drogon::AdviceChainCallback &&chain) {
+    RouteParams params;
+    const auto *targets = registry().table.match(request->getMethod(), request->getPath(), params);
+    if (!targets) return chain();
+    cff::db::adviseOnExecutor(request, std::move(callback), std::move(chain),
+                              [request, targets, params = std::move(params)]() -> drogon::HttpResponsePtr {
+        const auto &handlers = registry().handlers;
+        for (const auto index : *targets) {
+            if (auto response = handlers[index](request, params)) return response;
+        }
+        return nullptr;
+    });
+}
+
+struct RouteDispatchInstaller {
+    RouteDispatchInstaller() {
+        drogon::app().registerPreRoutingAdvice(dispatchAdvice);
+    }
+};
+
+RouteDispatchInstaller routeDispatchInstaller;
+
+} // namespace
+
+void addDispatchRoute(drogon::HttpMethod method,
+                      std::string_view pattern,
+                      RouteHandler handler) {
+    addDispatchRoute({method}, pattern, std::move(handler));
+}
+
+void addDispatchRoute(std::initializer_list<drogon::HttpMethod> methods,
+                      std::string_view pattern,
+                      RouteHandler handler) {
+    auto &dispatch = registry();
+    const auto target = dispatch.handlers.size();
+    dispatch.handlers.push_back(std::move(handler));
+    for (const auto method : methods) dispatch.table.add(method, pattern, target);
+}
+
+} // namespace cff::http
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "route_table.h"
+
+#include <drogon/drogon.h>
+
+#include <functional>
+#include <initializer_list>
+#include <string_view>
+
+namespace cff::http {
+
+// Returns a response to answer the request, or nullptr to let the next
+// handler registered for the same route (and finally the legacy Drogon
+// handler) take it.
+using RouteHandler = std::function<drogon::HttpResponsePtr(
+    const drogon::HttpRequestPtr &, const RouteParams &)>;
+
+// Hardening modules register their routes here from static initialisers.
+// A single pre-routing advice resolves every request with one RouteTable
+// lookup; matched handlers run on the DB executor in registration order.
+void addDispatchRoute(drogon::HttpMethod method,
+                      std::string_view pattern,
+                      RouteHandler handler);
+void addDispatchRoute(std::initializer_list<drogon::HttpMethod> methods,
+                      std::string_view pattern,
+                      RouteHandler handler);
+
+} // namespace cff::http
@@ -0,0 +1,97 @@
+#include "route_table.h"
+
+#include <array>
+#include <utility>
+
+namespace cff::http {
+namespace {
+
+constexpr std::size_t kMethodSlots = static_cast<std::size_t>(drogon::Invalid) + 1;
+
+std::size_t methodSlot(drogon::HttpMethod method) {
+    const auto slot = static_cast<std::size_t>(method);
+    return slot < kMethodSlots ? slot : static_cast<std::size_t>(drogon::Invalid);
+}
+
+// Splits "/a/b" into "a" and "/b". Returns false when `rest` is not rooted.
+bool nextSegment(std::string_view rest, std::string_view &segment, std::string_view &remainder) {
+    if (rest.empty() || rest.front() != '/') return false;
+    rest.remove_prefix(1);
+    const auto slash = rest.find('/');
+    segment = rest.substr(0, slash);
+    remainder = slash == std::string_view::npos ? std::string_view{} : rest.substr(slash);
+    return true;
+}
+
+} // namespace
+
+struct RouteTable::Node {
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> literals;
+    std::unique_ptr<Node> placeholder;
+    std::array<std::vector<std::size_t>, kMethodSlots> targets;
+
+    Node &literalChild(std::string_view segment) {
+        for (auto &[literal, child] : literals) {
+            if (literal == segment) return *child;
+        }
+        literals.emplace_back(std::string{segment}, std::make_unique<Node>());
+        return *literals.back().second;
+    }
+
+    const std::vector<std::size_t> *match(std::size_t method,
+                                          std::string_view rest,
+                                          RouteParams &params) const {
+        if (rest.empty()) {
+            const auto &found = targets[method];
+            return found.empty() ? nullptr : &found;
+        }
+        std::string_view segment;
+        std::string_view remainder;
+        if (!nextSegment(rest, segment, remainder)) return nullptr;
+        for (const auto &[literal, child] : literals) {
+            if (literal != segment) continue;
+            if (const auto *found = child->match(method, remainder, params)) return found;
+            break;
+        }
+        if (placeholder && !segment.empty()) {
+            params.emplace_back(segment);
+            if (const auto *found = placeholder->match(method, remainder, params)) return found;
+            params.pop_back();
+        }
+        return nullptr;
+    }
+};
+
+RouteTable::RouteTable() : root_(std::make_unique<Node>()) {}
+RouteTable::~RouteTable() = default;
+RouteTable::RouteTable(RouteTable &&) noexcept = default;
+RouteTable &RouteTable::operator=(RouteTable &&) noexcept = default;
+
+void RouteTable::add(drogon::HttpMethod method, std::string_view pattern, std::size_t target) {
+    auto *node = root_.get();
+    std::string_view segment;
+    std::string_view remainder;
+    while (nextSegment(pattern, segment, remainder)) {
+        if (segment == "{}") {
+            if (!node->placeholder) node->placeholder = std::make_unique<Node>();
+            node = node->placeholder.get();
+        } else {
+            node = &node->literalChild(segment);
+        }
+        pattern = remainder;
+    }
+    node->targets[methodSlot(method)].push_back(target);
+    ++routes_;
+}
+
+const std::vector<std::size_t> *RouteTable::match(drogon::HttpMethod method,
+                                                  std::string_view path,
+                                                  RouteParams &params) const {
+    params.clear();
+    if (path.empty()) return nullptr;
+    const auto *found = root_->match(methodSlot(method), path, params);
+    if (!found) params.clear();
+    return found;
+}
+
+} // namespace cff::http
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <drogon/drogon.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cff::http {
+
+using RouteParams = std::vector<std::string>;
+
+// Segment trie keyed on HTTP method plus path segments. A "{}" segment in a
+// pattern matches exactly one non-empty path segment and is captured into
+// RouteParams in order. Literal segments are tried before placeholders, with
+// backtracking, so "/waivers/process" and "/waivers/{}/process" coexist.
+//
+// Patterns are added during startup; match() is const and safe to call from
+// any number of threads once registration is finished.
+class RouteTable {
+public:
+    RouteTable();
+    ~RouteTable();
+    RouteTable(RouteTable &&) noexcept;
+    RouteTable &operator=(RouteTable &&) noexcept;
+    RouteTable(const RouteTable &) = delete;
+    RouteTable &operator=(const RouteTable &) = delete;
+
+    void add(drogon::HttpMethod method, std::string_view pattern, std::size_t target);
+
+    // Targets registered for the matched pattern, in registration order, or
+    // nullptr when nothing matches. `params` receives the captured segments.
+    const std::vector<std::size_t> *match(drogon::HttpMethod method,
+                                          std::string_view path,
+                                          RouteParams &params) const;
+
+    std::size_t size() const { return routes_; }
+
+private:
+    struct Node;
+    std::unique_ptr<Node> root_;
+    std::size_t routes_{0};
+};
+
+} // namespace cff::http
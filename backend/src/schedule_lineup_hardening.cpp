@@ -14,15 +14,21 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
+#include "db_statements.h"
 #endif
 
 #include "app_config.h"
 #include "http_security.h"
+#include "league_access_cache.h"
 #include "league_roster.h"
+#include "route_dispatch.h"
 #include "schedule_lineup_lifecycle.h"
 
 namespace {
@@ -172,50 +178,15 @@ int requestWeek(const drogon::HttpRequestPtr &request, int fallback = 1) {
     return std::max(1, fallback);
 }
 
-std::string pathLeagueId(const std::string &path, const std::string &suffix) {
-    const std::string prefix = "/api/leagues/";
-    if (path.rfind(prefix, 0) != 0 || suffix.empty()) return "";
-    if (path.size() <= prefix.size() + suffix.size()) return "";
-    if (path.substr(path.size() - suffix.size()) != suffix) return "";
-    return path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
-}
-
-bool parseLineupPath(const std::string &path,
-                     const std::string &suffix,
-                     std::string &leagueId,
-                     int &week) {
-    const std::string prefix = "/api/leagues/";
-    const std::string marker = "/lineups/week/";
-    if (path.rfind(prefix, 0) != 0) return false;
-    if (!suffix.empty() && (path.size() <= suffix.size()
-        || path.substr(path.size() - suffix.size()) != suffix)) return false;
-    const auto markerAt = path.find(marker, prefix.size());
-    if (markerAt == std::string::npos) return false;
-    leagueId = path.substr(prefix.size(), markerAt - prefix.size());
-    const auto weekStart = markerAt + marker.size();
-    const auto weekLength = path.size() - weekStart - suffix.size();
-    const auto rawWeek = path.substr(weekStart, weekLength);
-    if (leagueId.empty() || rawWeek.empty() || rawWeek.find('/') != std::string::npos) return false;
-    try { week = std::max(1, std::stoi(rawWeek)); } catch (...) { return false; }
+bool parseWeekSegment(const std::string &raw, int &week) {
+    try {
+        week = std::max(1, std::stoi(raw));
+    } catch (...) {
+        return false;
+    }
     return true;
 }
 
-bool parseRosterSlotPath(const std::string &path,
-                         std::string &leagueId,
-                         std::string &playerId) {
-    const std::string prefix = "/api/leagues/";
-    const std::string marker = "/roster/";
-    const std::string suffix = "/slot";
-    if (path.rfind(prefix, 0) != 0 || path.size() <= suffix.size()
-        || path.substr(path.size() - suffix.size()) != suffix) return false;
-    const auto markerAt = path.find(marker, prefix.size());
-    if (markerAt == std::string::npos) return false;
-    leagueId = path.substr(prefix.size(), markerAt - prefix.size());
-    const auto playerStart = markerAt + marker.size();
-    playerId = path.substr(playerStart, path.size() - playerStart - suffix.size());
-    return !leagueId.empty() && !playerId.empty() && playerId.find('/') == std::string::npos;
-}
-
 #ifdef CFF_HAS_POSTGRES
 #include "schedule_lineup_hardening_db.inc"
 #include "schedule_lineup_hardening_payload.inc"
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cff::scoring_lifecycle {
@@ -43,13 +45,59 @@ double numberValue(const Json::Value &value, const char *key, double fallback) {
     return node.isNumeric() ? node.asDouble() : fallback;
 }
 
-bool tokenMatches(const std::string &value,
-                  std::initializer_list<const char *> options) {
-    const auto token = canonicalStatToken(value);
-    for (const auto *option : options) {
-        if (token == option) return true;
-    }
-    return false;
+struct KnownStat {
+    const char *category; // empty matches any category
+    const char *stat;
+    StatRule rule;
+};
+
+// The db/stat_keys.md keys plus the looser spellings older ingestion wrote,
+// as canonical tokens.
+constexpr KnownStat kKnownStats[] = {
+    {"passing", "passyards", StatRule::PassingYards},
+    {"passing", "passingyards", StatRule::PassingYards},
+    {"passing", "yds", StatRule::PassingYards},
+    {"passing", "passtd", StatRule::PassingTd},
+    {"passing", "passingtd", StatRule::PassingTd},
+    {"passing", "passingtouchdown", StatRule::PassingTd},
+    {"passing", "touchdowns", StatRule::PassingTd},
+    {"passing", "interception", StatRule::Interception},
+    {"passing", "interceptions", StatRule::Interception},
+    {"passing", "int", StatRule::Interception},
+    {"passing", "passint", StatRule::Interception},
+    {"rushing", "rushyards", StatRule::RushingYards},
+    {"rushing", "rushingyards", StatRule::RushingYards},
+    {"rushing", "yds", StatRule::RushingYards},
+    {"rushing", "rushtd", StatRule::RushingTd},
+    {"rushing", "rushingtd", StatRule::RushingTd},
+    {"rushing", "rushingtouchdown", StatRule::RushingTd},
+    {"rushing", "touchdowns", StatRule::RushingTd},
+    {"receiving", "recyards", StatRule::ReceivingYards},
+    {"receiving", "receivingyards", StatRule::ReceivingYards},
+    {"receiving", "yds", StatRule::ReceivingYards},
+    {"receiving", "rectd", StatRule::ReceivingTd},
+    {"receiving", "receivingtd", StatRule::ReceivingTd},
+    {"receiving", "receivingtouchdown", StatRule::ReceivingTd},
+    {"receiving", "touchdowns", StatRule::ReceivingTd},
+    {"receiving", "reception", StatRule::Reception},
+    {"receiving", "receptions", StatRule::Reception},
+    {"receiving", "rec", StatRule::Reception},
+    {"receiving", "catches", StatRule::Reception},
+    {"", "fumblelost", StatRule::FumbleLost},
+    {"", "fumbleslost", StatRule::FumbleLost},
+    {"", "twopoint", StatRule::TwoPoint},
+    {"", "twopointconversion", StatRule::TwoPoint},
+    {"", "twopt", StatRule::TwoPoint},
+    {"", "passtwopt", StatRule::TwoPoint},
+    {"", "rushtwopt", StatRule::TwoPoint},
+    {"", "rectwopt", StatRule::TwoPoint},
+};
+
+std::string statLookupKey(const std::string &category, const std::string &stat) {
+    auto key = category;
+    key.push_back('\x1f');
+    key += stat;
+    return key;
 }
 
 struct StandingRow {
@@ -116,51 +164,67 @@ bool scoredStatus(const std::string &status) {
     return normalized == "scored" || normalized == "final";
 }
 
+StatKey internStat(const std::string &category, const std::string &statName) {
+    static const auto known = [] {
+        std::unordered_map<std::string, StatKey> keys;
+        for (const auto &entry : kKnownStats) {
+            const auto id = static_cast<std::uint32_t>(keys.size() + 1);
+            keys.emplace(statLookupKey(entry.category, entry.stat), StatKey{id, entry.rule});
+        }
+        return keys;
+    }();
+    const auto stat = canonicalStatToken(statName);
+    auto found = known.find(statLookupKey(canonicalStatToken(category), stat));
+    if (found == known.end()) found = known.find(statLookupKey("", stat));
+    return found == known.end() ? StatKey{} : found->second;
+}
+
+CompiledScoring::CompiledScoring(const Json::Value &settings) {
+    const auto set = [this](StatRule rule, double value) {
+        scales_[static_cast<std::size_t>(rule)] = value;
+    };
+    const auto perPoint = [&settings](const char *key, double fallback) {
+        const auto divisor = numberValue(settings, key, fallback);
+        return divisor == 0.0 ? 0.0 : 1.0 / divisor;
+    };
+    set(StatRule::PassingYards, perPoint("passingYardsPerPoint", 25.0));
+    set(StatRule::PassingTd, numberValue(settings, "passingTd", 4.0));
+    set(StatRule::Interception, numberValue(settings, "interception", -2.0));
+    set(StatRule::RushingYards, perPoint("rushingYardsPerPoint", 10.0));
+    set(StatRule::RushingTd, numberValue(settings, "rushingTd", 6.0));
+    set(StatRule::ReceivingYards, perPoint("receivingYardsPerPoint", 10.0));
+    set(StatRule::ReceivingTd, numberValue(settings, "receivingTd", 6.0));
+    set(StatRule::Reception, numberValue(settings, "reception", 1.0));
+    set(StatRule::FumbleLost, numberValue(settings, "fumbleLost", -2.0));
+    set(StatRule::TwoPoint, numberValue(settings, "twoPointConversion", 2.0));
+}
+
+std::shared_ptr<const CompiledScoring> compiledScoringFor(const std::string &leagueId,
+                                                          const Json::Value &settings) {
+    struct Entry {
+        Json::Value settings;
+        std::shared_ptr<const CompiledScoring> compiled;
+    };
+    constexpr std::size_t kMaxCachedLeagues = 4096;
+    static std::mutex mutex;
+    static std::unordered_map<std::string, Entry> cache;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = cache.find(leagueId);
+        if (found != cache.end() && found->second.settings == settings) return found->second.compiled;
+    }
+    auto compiled = std::make_shared<const CompiledScoring>(settings);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cache.size() >= kMaxCachedLeagues && !cache.count(leagueId)) cache.clear();
+    cache[leagueId] = Entry{settings, compiled};
+    return compiled;
+}
+
 double fantasyPointsForStat(const Json::Value &settings,
                             const std::string &category,
                             const std::string &statName,
                             double value) {
-    const auto cat = canonicalStatToken(category);
-    if (cat == "passing") {
-        if (tokenMatches(statName, {"passyards", "passingyards", "yds"})) {
-            const auto divisor = numberValue(settings, "passingYardsPerPoint", 25.0);
-            return divisor == 0.0 ? 0.0 : value / divisor;
-        }
-        if (tokenMatches(statName, {"passtd", "passingtd", "passingtouchdown", "touchdowns"})) {
-            return value * numberValue(settings, "passingTd", 4.0);
-        }
-        if (tokenMatches(statName, {"interception", "interceptions", "int"})) {
-            return value * numberValue(settings, "interception", -2.0);
-        }
-    }
-    if (cat == "rushing") {
-        if (tokenMatches(statName, {"rushyards", "rushingyards", "yds"})) {
-            const auto divisor = numberValue(settings, "rushingYardsPerPoint", 10.0);
-            return divisor == 0.0 ? 0.0 : value / divisor;
-        }
-        if (tokenMatches(statName, {"rushtd", "rushingtd", "rushingtouchdown", "touchdowns"})) {
-            return value * numberValue(settings, "rushingTd", 6.0);
-        }
-    }
-    if (cat == "receiving") {
-        if (tokenMatches(statName, {"recyards", "receivingyards", "yds"})) {
-            const auto divisor = numberValue(settings, "receivingYardsPerPoint", 10.0);
-            return divisor == 0.0 ? 0.0 : value / divisor;
-        }
-        if (tokenMatches(statName, {"rectd", "receivingtd", "receivingtouchdown", "touchdowns"})) {
-            return value * numberValue(settings, "receivingTd", 6.0);
-        }
-        if (tokenMatches(statName, {"reception", "receptions", "rec", "catches"})) {
-            return value * numberValue(settings, "reception", 1.0);
-        }
-    }
-    if (tokenMatches(statName, {"fumblelost", "fumbleslost"})) {
-        return value * numberValue(settings, "fumbleLost", -2.0);
-    }
-    if (tokenMatches(statName, {"twopoint", "twopointconversion", "twopt"})) {
-        return value * numberValue(settings, "twoPointConversion", 2.0);
-    }
-    return 0.0;
+    return CompiledScoring{settings}.points(internStat(category, statName), value);
 }
 
 Json::Value standingsFromFinalMatchups(const Json::Value &members,
@@ -2,6 +2,10 @@
 
 #include <json/json.h>
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace cff::scoring_lifecycle {
@@ -17,6 +21,58 @@ bool expectedVersionMatches(long long currentVersion,
 bool finalizedStatus(const std::string &status);
 bool scoredStatus(const std::string &status);
 
+// Scoring rules a (category, stat) pair can resolve to. Every stat row maps
+// to exactly one; unscored stats resolve to None.
+enum class StatRule : std::uint8_t {
+    None,
+    PassingYards,
+    PassingTd,
+    Interception,
+    RushingYards,
+    RushingTd,
+    ReceivingYards,
+    ReceivingTd,
+    Reception,
+    FumbleLost,
+    TwoPoint,
+    Count
+};
+
+struct StatKey {
+    std::uint32_t id{0};
+    StatRule rule{StatRule::None};
+};
+
+// Resolves a raw (category, stat_name) pair against a fixed table of the
+// db/stat_keys.md vocabulary, so a row costs normalization and a hash lookup.
+// Pairs outside the vocabulary share the unknown key (id 0, rule None); no
+// state is kept per distinct spelling.
+StatKey internStat(const std::string &category, const std::string &statName);
+
+// A league's scoring_settings compiled to one multiplier per rule. Yardage
+// divisors are stored as reciprocals (0 when the divisor is 0), so scoring a
+// stat is a table lookup and a fused multiply-add.
+class CompiledScoring {
+public:
+    CompiledScoring() = default;
+    explicit CompiledScoring(const Json::Value &settings);
+
+    double scale(StatRule rule) const { return scales_[static_cast<std::size_t>(rule)]; }
+    double points(StatKey stat, double value) const { return value * scale(stat.rule); }
+    double accumulate(double total, StatKey stat, double value) const {
+        return std::fma(value, scale(stat.rule), total);
+    }
+
+private:
+    std::array<double, static_cast<std::size_t>(StatRule::Count)> scales_{};
+};
+
+// Compiled table for a league, rebuilt only when its settings change.
+std::shared_ptr<const CompiledScoring> compiledScoringFor(const std::string &leagueId,
+                                                          const Json::Value &settings);
+
+// One-off convenience that compiles `settings` on every call. Code scoring
+// more than one row should compile once (compiledScoringFor) and reuse it.
 double fantasyPointsForStat(const Json::Value &settings,
                             const std::string &category,
                             const std::string &statName,
@@ -7,23 +7,35 @@
 #include <cstdlib>
 #include <ctime>
 #include <iomanip>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "bulk_scoring.h"
+#include "db_executor.h"
+#include "db_pool.h"
+#include "db_statements.h"
 #endif
 
 #include "app_config.h"
 #include "http_security.h"
+#include "league_access_cache.h"
 #include "league_roster.h"
 #include "league_schedule.h"
+#include "route_dispatch.h"
 #include "schedule_lineup_hardening.h"
 #include "scoring_lifecycle.h"
+#include "scoring_recalculation.h"
 
 namespace {
 
@@ -161,32 +173,9 @@ int requestWeek(const drogon::HttpRequestPtr &request, int fallback = 1) {
     return std::max(1, fallback);
 }
 
-std::string pathLeagueId(const std::string &path, const std::string &suffix) {
-    const std::string prefix = "/api/leagues/";
-    if (path.rfind(prefix, 0) != 0 || suffix.empty()) return "";
-    if (path.size() <= prefix.size() + suffix.size()) return "";
-    if (path.substr(path.size() - suffix.size()) != suffix) return "";
-    return path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
-}
-
-bool parseScoreWeekPath(const std::string &path,
-                        const std::string &suffix,
-                        std::string &leagueId,
-                        int &week) {
-    const std::string prefix = "/api/leagues/";
-    const std::string marker = "/score/week/";
-    if (path.rfind(prefix, 0) != 0) return false;
-    if (!suffix.empty() && (path.size() <= suffix.size()
-        || path.substr(path.size() - suffix.size()) != suffix)) return false;
-    const auto markerAt = path.find(marker, prefix.size());
-    if (markerAt == std::string::npos) return false;
-    leagueId = path.substr(prefix.size(), markerAt - prefix.size());
-    const auto weekStart = markerAt + marker.size();
-    const auto weekLength = path.size() - weekStart - suffix.size();
-    const auto rawWeek = path.substr(weekStart, weekLength);
-    if (leagueId.empty() || rawWeek.empty() || rawWeek.find('/') != std::string::npos) return false;
+bool parseWeekSegment(const std::string &raw, int &week) {
     try {
-        week = std::max(1, std::stoi(rawWeek));
+        week = std::max(1, std::stoi(raw));
     } catch (...) {
         return false;
     }
@@ -197,8 +186,48 @@ bool parseScoreWeekPath(const std::string &path,
 #include "scoring_lifecycle_hardening_db.inc"
 #include "scoring_lifecycle_hardening_payload.inc"
 #include "scoring_lifecycle_hardening_mutations.inc"
+#include "scoring_lifecycle_hardening_bulk.inc"
 #endif
 
 #include "scoring_lifecycle_hardening_advice.inc"
 
 } // namespace
+
+namespace cff::scoring_recalculation {
+
+bool requestDrain(int season, int week) {
+#ifdef CFF_HAS_POSTGRES
+    const auto key = std::make_pair(season, week);
+    auto &counters = recalculationCounters();
+    {
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        if (counters.running.count(key)) {
+            counters.rerun.insert(key);
+            return true;
+        }
+        counters.running.insert(key);
+    }
+    const bool queued = cff::db::submit([season, week] { runRecalculationDrain(season, week); });
+    if (!queued) {
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        counters.running.erase(key);
+    }
+    return queued;
+#else
+    (void) season;
+    (void) week;
+    return false;
+#endif
+}
+
+RecalculationMetrics metrics() {
+#ifdef CFF_HAS_POSTGRES
+    auto &counters = recalculationCounters();
+    std::lock_guard<std::mutex> lock(counters.mutex);
+    return counters.metrics;
+#else
+    return {};
+#endif
+}
+
+} // namespace cff::scoring_recalculation
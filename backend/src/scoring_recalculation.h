@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cff::scoring_recalculation {
+
+struct RecalculationMetrics {
+    std::uint64_t drains{0};
+    std::uint64_t leaguesRescored{0};
+    std::uint64_t leaguesUnchanged{0};
+    std::uint64_t leaguesSkipped{0};
+    std::uint64_t leaguesFailed{0};
+    std::uint64_t profiles{0};
+    std::uint64_t lastDrainMillis{0};
+};
+
+// Rescores every pending scoring_recalculation_queue entry for a week in one
+// bulk pass on the DB executor. A request made while that week is already
+// draining is folded into one more pass. Returns false when the executor
+// queue is full; the entries stay pending for the next request.
+bool requestDrain(int season, int week);
+
+RecalculationMetrics metrics();
+
+} // namespace cff::scoring_recalculation
@@ -5,30 +5,24 @@
 #include <chrono>
 #include <cctype>
 #include <cstdlib>
-#include <deque>
 #include <functional>
 #include <iomanip>
 #include <iostream>
-#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
-namespace {
-
-using Clock = std::chrono::steady_clock;
+#include "rate_limiter.h"
 
-struct RateBucket {
-    std::deque<Clock::time_point> attempts;
-    Clock::time_point lastSeen{Clock::now()};
-};
+namespace {
 
-std::mutex rateMutex;
-std::unordered_map<std::string, RateBucket> rateBuckets;
+cff::rate_limit::ShardedRateLimiter &rateLimiter() {
+    static cff::rate_limit::ShardedRateLimiter limiter;
+    return limiter;
+}
 
 std::optional<std::string> envValue(const char *name) {
     const char *value = std::getenv(name);
@@ -326,27 +320,7 @@ std::string authSubject(const drogon::HttpRequestPtr &req) {
 bool takeRateLimit(const std::string &key,
                    std::size_t limit,
                    std::chrono::seconds window) {
-    const auto now = Clock::now();
-    const auto cutoff = now - window;
-    std::lock_guard<std::mutex> lock(rateMutex);
-    auto &bucket = rateBuckets[key];
-    bucket.lastSeen = now;
-    while (!bucket.attempts.empty() && bucket.attempts.front() <= cutoff) {
-        bucket.attempts.pop_front();
-    }
-    if (bucket.attempts.size() >= limit) return false;
-    bucket.attempts.push_back(now);
-
-    if (rateBuckets.size() > 25000) {
-        for (auto it = rateBuckets.begin(); it != rateBuckets.end();) {
-            if (it->second.attempts.empty() || it->second.lastSeen <= now - std::chrono::hours(1)) {
-                it = rateBuckets.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-    return true;
+    return rateLimiter().take(key, limit, window);
 }
 
 struct RatePolicy {
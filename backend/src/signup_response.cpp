@@ -9,13 +9,9 @@
 #include <memory>
 #include <string>
 
-namespace {
+#include "db_pool.h"
 
-struct PgConnDeleter {
-    void operator()(PGconn *connection) const {
-        if (connection) PQfinish(connection);
-    }
-};
+namespace {
 
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
@@ -23,7 +19,7 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 
 enum class AccountPresence {
@@ -59,8 +55,8 @@ AccountPresence accountPresence(const std::string &email) {
     const char *url = std::getenv("DB_URL");
     if (!url || !*url || email.empty()) return AccountPresence::Unavailable;
 
-    auto connection = PgConnPtr{PQconnectdb(url)};
-    if (!connection || PQstatus(connection.get()) != CONNECTION_OK) {
+    auto connection = cff::db::acquireConnection();
+    if (!connection) {
         std::cerr << "[auth] unable to verify duplicate signup state" << std::endl;
         return AccountPresence::Unavailable;
     }
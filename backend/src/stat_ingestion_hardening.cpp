@@ -14,15 +14,22 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #ifdef CFF_HAS_POSTGRES
 #include <postgresql/libpq-fe.h>
+
+#include "db_pool.h"
 #endif
 
 #include "app_config.h"
 #include "http_security.h"
+#include "route_dispatch.h"
+#include "scoring_recalculation.h"
 #include "stat_ingestion_lifecycle.h"
+#include "stat_ingestion_provider.h"
 
 namespace {
 
@@ -161,8 +168,65 @@ int requestWeek(const drogon::HttpRequestPtr &request) {
 #include "stat_ingestion_hardening_db.inc"
 #include "stat_ingestion_hardening_payload.inc"
 #include "stat_ingestion_hardening_mutations.inc"
+#include "stat_ingestion_hardening_provider.inc"
 #endif
 
 #include "stat_ingestion_hardening_advice.inc"
 
 } // namespace
+
+namespace cff::stat_ingestion {
+
+#ifdef CFF_HAS_POSTGRES
+ProviderRun startProviderRun(int season, int week, const std::string &owner, int leaseSeconds) {
+    return providerStart(season, week, owner, leaseSeconds);
+}
+
+ProviderApplyResult applyProviderStats(const ProviderRun &run,
+                                       int season,
+                                       int week,
+                                       const std::string &owner,
+                                       const cfbd_stats::WeekStats &stats,
+                                       int apiCalls,
+                                       int leaseSeconds,
+                                       std::size_t batchSize) {
+    return providerApply(run, season, week, owner, stats, apiCalls, leaseSeconds, batchSize);
+}
+
+bool failProviderRun(const ProviderRun &run,
+                     int season,
+                     int week,
+                     const std::string &owner,
+                     int providerStatus,
+                     bool networkFailure,
+                     int apiCalls,
+                     const std::string &error) {
+    return providerFail(run, season, week, owner, providerStatus, networkFailure, apiCalls, error);
+}
+#else
+ProviderRun startProviderRun(int, int, const std::string &, int) {
+    ProviderRun run;
+    run.code = "storage_unavailable";
+    return run;
+}
+
+ProviderApplyResult applyProviderStats(const ProviderRun &,
+                                       int,
+                                       int,
+                                       const std::string &,
+                                       const cfbd_stats::WeekStats &stats,
+                                       int,
+                                       int,
+                                       std::size_t) {
+    ProviderApplyResult result;
+    result.code = "storage_unavailable";
+    result.received = stats.rows.size();
+    return result;
+}
+
+bool failProviderRun(const ProviderRun &, int, int, const std::string &, int, bool, int, const std::string &) {
+    return false;
+}
+#endif
+
+} // namespace cff::stat_ingestion
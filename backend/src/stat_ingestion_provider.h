@@ -0,0 +1,65 @@
+#pragma once
+
+#include "cfbd_stat_mapping.h"
+
+#include <cstddef>
+#include <string>
+
+namespace cff::stat_ingestion {
+
+// In-process counterpart of the admin stat transactions API, for adapters
+// that fetch provider stats themselves. Runs hold the same season/week
+// lease in ingestion_runs, so an adapter and an external worker never write
+// a week at the same time.
+struct ProviderRun {
+    long long id{0};
+    int attempt{1};
+    // "started", or why no run was opened: "ingestion_run_active",
+    // "ingestion_backoff_active", "storage_unavailable".
+    std::string code;
+};
+
+ProviderRun startProviderRun(int season, int week, const std::string &owner, int leaseSeconds);
+
+struct ProviderApplyResult {
+    bool applied{false};
+    std::string code;
+    std::size_t received{0};
+    std::size_t inserted{0};
+    std::size_t corrected{0};
+    std::size_t unchanged{0};
+    std::size_t unknownPlayerRows{0};
+    std::size_t changedPlayers{0};
+    // Distinct leagues queued for rescoring by committed batches.
+    std::size_t queuedLeagues{0};
+    std::size_t batches{0};
+    long long sourceRevision{0};
+};
+
+// Diffs `stats` against the week's stored source hashes and writes only new
+// or corrected rows, `batchSize` rows per transaction. Each batch renews the
+// lease and queues the leagues rostering its players, so a run that dies
+// midway leaves nothing written but unscored. The last transaction closes
+// the run and marks the week fresh; queued leagues are then drained.
+ProviderApplyResult applyProviderStats(const ProviderRun &run,
+                                       int season,
+                                       int week,
+                                       const std::string &owner,
+                                       const cfbd_stats::WeekStats &stats,
+                                       int apiCalls,
+                                       int leaseSeconds,
+                                       std::size_t batchSize);
+
+// Releases the lease after a provider or storage failure, classifying it as
+// retry_wait or failed exactly like the "fail" transaction action, and
+// records the provider calls the run spent before failing.
+bool failProviderRun(const ProviderRun &run,
+                     int season,
+                     int week,
+                     const std::string &owner,
+                     int providerStatus,
+                     bool networkFailure,
+                     int apiCalls,
+                     const std::string &error);
+
+} // namespace cff::stat_ingestion
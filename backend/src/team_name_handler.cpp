@@ -12,13 +12,9 @@
 #include <utility>
 #include <vector>
 
-namespace {
+#include "db_pool.h"
 
-struct PgConnDeleter {
-    void operator()(PGconn *connection) const {
-        if (connection) PQfinish(connection);
-    }
-};
+namespace {
 
 struct PgResultDeleter {
     void operator()(PGresult *result) const {
@@ -26,16 +22,12 @@ struct PgResultDeleter {
     }
 };
 
-using PgConnPtr = std::unique_ptr<PGconn, PgConnDeleter>;
+using PgConnPtr = cff::db::PooledConnection;
 using PgResultPtr = std::unique_ptr<PGresult, PgResultDeleter>;
 using Callback = std::function<void(const drogon::HttpResponsePtr &)>;
 
 PgConnPtr connectToDb() {
-    const char *url = std::getenv("DB_URL");
-    if (!url || !*url) return nullptr;
-    auto connection = PgConnPtr{PQconnectdb(url)};
-    if (PQstatus(connection.get()) != CONNECTION_OK) return nullptr;
-    return connection;
+    return cff::db::acquireConnection();
 }
 
 PgResultPtr execParams(PGconn *connection,
@@ -4,6 +4,7 @@
 #include <cctype>
 #include <limits>
 #include <tuple>
+#include <utility>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -40,6 +41,12 @@ std::string stringValue(const Json::Value &value,
     return node.isString() ? node.asString() : fallback;
 }
 
+std::string rosteredPlayerId(const Json::Value &player) {
+    auto id = stringValue(player, "id");
+    if (id.empty()) id = stringValue(player, "playerId");
+    return id;
+}
+
 } // namespace
 
 std::string canonicalEmail(std::string value) {
@@ -181,4 +188,140 @@ std::vector<Json::ArrayIndex> orderedClaimIndexes(const Json::Value &claims,
     return indexes;
 }
 
+WaiverRun resolveWaiverRun(const Json::Value &claims,
+                           const Json::Value &priorityBoard,
+                           const Json::Value &rosters,
+                           const SlotAssigner &assignSlot,
+                           std::size_t maxClaims) {
+    struct Pending {
+        Json::ArrayIndex index;
+        std::string managerEmail;
+        int fallbackPriority;
+        int claimOrder;
+        std::string createdAt;
+        std::string id;
+    };
+    WaiverRun run;
+    run.priorityBoard = priorityBoard.isArray() ? priorityBoard : Json::Value{Json::arrayValue};
+    run.rosters = rosters.isObject() ? rosters : Json::Value{Json::objectValue};
+
+    std::unordered_map<std::string, std::string> owners;
+    for (const auto &manager : run.rosters.getMemberNames()) {
+        for (const auto &player : run.rosters[manager]) {
+            owners[canonicalPlayerId(rosteredPlayerId(player))] = manager;
+        }
+    }
+    std::unordered_map<std::string, int> priorities;
+    auto loadPriorities = [&]() {
+        priorities.clear();
+        for (const auto &entry : run.priorityBoard) {
+            priorities[canonicalEmail(stringValue(entry, "managerEmail"))]
+                = intValue(entry, "priority", std::numeric_limits<int>::max());
+        }
+    };
+    loadPriorities();
+
+    std::vector<Pending> pending;
+    if (claims.isArray()) {
+        pending.reserve(claims.size());
+        for (Json::ArrayIndex index = 0; index < claims.size(); ++index) {
+            const auto &claim = claims[index];
+            pending.push_back({index,
+                               canonicalEmail(stringValue(claim, "managerEmail")),
+                               intValue(claim, "priority", std::numeric_limits<int>::max()),
+                               intValue(claim, "claimOrder", std::numeric_limits<int>::max()),
+                               stringValue(claim, "createdAt"),
+                               stringValue(claim, "id")});
+        }
+    }
+    auto priorityOf = [&](const Pending &claim) {
+        const auto found = priorities.find(claim.managerEmail);
+        return found == priorities.end() ? claim.fallbackPriority : found->second;
+    };
+
+    while (!pending.empty() && run.outcomes.size() < maxClaims) {
+        // Priorities move after every win, so the next claim is re-selected
+        // each step; the same ordering as orderedClaimIndexes.
+        auto next = pending.begin();
+        auto nextPriority = priorityOf(*next);
+        for (auto candidate = std::next(pending.begin()); candidate != pending.end(); ++candidate) {
+            const auto candidatePriority = priorityOf(*candidate);
+            if (std::tie(candidatePriority, candidate->claimOrder, candidate->createdAt, candidate->id)
+                < std::tie(nextPriority, next->claimOrder, next->createdAt, next->id)) {
+                next = candidate;
+                nextPriority = candidatePriority;
+            }
+        }
+        const auto &claim = claims[next->index];
+        ClaimOutcome outcome;
+        outcome.claimId = next->id;
+        outcome.managerEmail = next->managerEmail;
+        outcome.playerId = canonicalPlayerId(stringValue(claim, "addPlayerId"));
+        outcome.player = claim["addPlayer"].isObject() ? claim["addPlayer"] : Json::Value{Json::objectValue};
+        outcome.player["id"] = outcome.playerId;
+        outcome.player["playerId"] = outcome.playerId;
+        pending.erase(next);
+
+        const auto dropId = canonicalPlayerId(stringValue(claim, "dropPlayerId"));
+        auto &roster = run.rosters[outcome.managerEmail];
+        if (!roster.isArray()) roster = Json::Value{Json::arrayValue};
+        Json::ArrayIndex dropIndex = roster.size();
+        if (!dropId.empty()) {
+            for (Json::ArrayIndex index = 0; index < roster.size(); ++index) {
+                if (canonicalPlayerId(rosteredPlayerId(roster[index])) == dropId) dropIndex = index;
+            }
+        }
+
+        std::optional<std::string> slot;
+        if (outcome.playerId.empty()) outcome.failureCode = "player_id_missing";
+        else if (owners.count(outcome.playerId)) outcome.failureCode = "player_unavailable";
+        else if (!dropId.empty() && dropIndex == roster.size()) outcome.failureCode = "drop_player_not_rostered";
+        else if (!(slot = assignSlot(outcome.player, roster, dropId))) outcome.failureCode = "roster_full";
+        if (!outcome.failureCode.empty()) {
+            outcome.status = "failed";
+            run.outcomes.push_back(std::move(outcome));
+            continue;
+        }
+
+        if (dropIndex < roster.size()) {
+            outcome.dropPlayerId = rosteredPlayerId(roster[dropIndex]);
+            owners.erase(dropId);
+            Json::Value removed;
+            roster.removeIndex(dropIndex, &removed);
+        }
+        outcome.rosterSlot = *slot;
+        auto added = outcome.player;
+        added["rosterSlot"] = outcome.rosterSlot;
+        added["acquiredVia"] = "waiver";
+        roster.append(added);
+        owners[outcome.playerId] = outcome.managerEmail;
+        moveManagerToBack(run.priorityBoard, outcome.managerEmail);
+        loadPriorities();
+        outcome.status = "processed";
+        run.outcomes.push_back(std::move(outcome));
+    }
+    return run;
+}
+
+NetRosterChanges netRosterChanges(const WaiverRun &run) {
+    NetRosterChanges changes;
+    std::vector<std::string> addOrder;
+    std::unordered_set<std::string> ordered;
+    std::unordered_map<std::string, const ClaimOutcome *> adds;
+    for (const auto &outcome : run.outcomes) {
+        if (outcome.status != "processed") continue;
+        if (!outcome.dropPlayerId.empty() && adds.erase(canonicalPlayerId(outcome.dropPlayerId)) == 0) {
+            changes.drops.push_back(RosterDrop{outcome.managerEmail, outcome.dropPlayerId});
+        }
+        // A player dropped and claimed again keeps its first position.
+        adds.emplace(outcome.playerId, &outcome);
+        if (ordered.insert(outcome.playerId).second) addOrder.push_back(outcome.playerId);
+    }
+    for (const auto &playerId : addOrder) {
+        const auto found = adds.find(playerId);
+        if (found != adds.end()) changes.adds.push_back(found->second);
+    }
+    return changes;
+}
+
 } // namespace cff::waiver_lifecycle
@@ -2,6 +2,9 @@
 
 #include <json/json.h>
 
+#include <cstddef>
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -22,4 +25,55 @@ void moveManagerToBack(Json::Value &priorityBoard,
 std::vector<Json::ArrayIndex> orderedClaimIndexes(const Json::Value &claims,
                                                   const Json::Value &priorityBoard);
 
+struct ClaimOutcome {
+    std::string claimId;
+    std::string managerEmail;
+    std::string playerId;
+    std::string dropPlayerId;
+    Json::Value player;
+    std::string rosterSlot;
+    std::string status;
+    std::string failureCode;
+};
+
+struct WaiverRun {
+    std::vector<ClaimOutcome> outcomes;
+    Json::Value priorityBoard;
+    Json::Value rosters;
+};
+
+// Picks the roster slot for `player` on `roster` once `dropPlayerId` leaves
+// it, or nullopt when the roster has no room.
+using SlotAssigner = std::function<std::optional<std::string>(const Json::Value &player,
+                                                              const Json::Value &roster,
+                                                              const std::string &dropPlayerId)>;
+
+// Resolves up to `maxClaims` pending claims against one league snapshot:
+// claims as nextPendingClaim shapes them, the priority board, and every
+// manager's roster keyed by canonical email. Each step takes the first claim
+// in current priority order, fails it or applies it to the in-memory rosters,
+// and sends a winning manager to the back of the line, exactly as resolving
+// the claims one at a time in the database would.
+WaiverRun resolveWaiverRun(const Json::Value &claims,
+                           const Json::Value &priorityBoard,
+                           const Json::Value &rosters,
+                           const SlotAssigner &assignSlot,
+                           std::size_t maxClaims);
+
+struct RosterDrop {
+    std::string managerEmail;
+    std::string playerId;
+};
+
+// The roster rows a resolved run writes: drops of players rostered before the
+// run, and one add per player that ends the run rostered, in first-claim
+// order, carrying the outcome that placed it there. A player added and then
+// dropped within the run appears in neither list.
+struct NetRosterChanges {
+    std::vector<RosterDrop> drops;
+    std::vector<const ClaimOutcome *> adds;
+};
+
+NetRosterChanges netRosterChanges(const WaiverRun &run);
+
 } // namespace cff::waiver_lifecycle
@@ -0,0 +1,92 @@
+#include "auth_session_cache.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+} // namespace
+
+int main() {
+    using cff::auth::SessionCacheSettings;
+    using cff::auth::SessionTokenCache;
+    using State = SessionTokenCache::State;
+    using std::chrono::seconds;
+
+    SessionCacheSettings settings;
+    settings.capacity = 32;
+    settings.ttl = seconds{60};
+    settings.negativeTtl = seconds{5};
+    SessionTokenCache cache{settings};
+    const auto start = SessionTokenCache::Clock::now();
+
+    expect(cache.find("token-a", start).state == State::Miss, "unknown tokens miss");
+    expect(cache.storeValid("token-a", "a@example.com", start + std::chrono::hours{24}, start),
+           "valid tokens are cached");
+    const auto hit = cache.find("token-a", start + seconds{1});
+    expect(hit.state == State::Valid && hit.email == "a@example.com", "cached tokens resolve to their account");
+    expect(cache.find("token-a", start + seconds{61}).state == State::Miss,
+           "positive entries expire after the cache ttl and are revalidated");
+
+    cache.storeValid("token-short", "short@example.com", start + seconds{10}, start);
+    expect(cache.find("token-short", start + seconds{11}).state == State::Miss,
+           "positive entries never outlive the token expiry");
+
+    cache.storeInvalid("token-unknown", start);
+    expect(cache.find("token-unknown", start + seconds{1}).state == State::Invalid,
+           "unknown tokens are negatively cached");
+    expect(cache.find("token-unknown", start + seconds{6}).state == State::Miss,
+           "negative entries expire quickly");
+
+    cache.storeValid("token-b", "b@example.com", start + std::chrono::hours{24}, start);
+    cache.revoke("token-b", start + std::chrono::hours{24});
+    expect(cache.find("token-b", start + seconds{1}).state == State::Invalid,
+           "revocation replaces a cached session");
+    expect(!cache.storeValid("token-b", "b@example.com", start + std::chrono::hours{24}, start + seconds{2}),
+           "a lookup racing a logout cannot re-admit the session");
+    expect(cache.find("token-b", start + seconds{3}).state == State::Invalid,
+           "revoked sessions stay denied");
+
+    for (int index = 0; index < 1000; ++index) {
+        cache.storeValid("filler-" + std::to_string(index), "f@example.com",
+                         start + std::chrono::hours{24}, start);
+    }
+    const auto bounded = cache.metrics();
+    expect(bounded.entries <= settings.capacity, "cache size stays within capacity");
+    expect(bounded.evictions > 0, "least recently used entries are evicted");
+    expect(cache.find("token-b", start + seconds{4}).state == State::Invalid,
+           "eviction pressure cannot resurrect a revoked session");
+
+    cache.sweep(start + std::chrono::hours{25});
+    const auto swept = cache.metrics();
+    expect(swept.entries == 0, "sweep removes expired entries");
+    expect(swept.revoked == 0, "sweep removes revocations past the token lifetime");
+    expect(swept.hits >= 1 && swept.negativeHits >= 1 && swept.misses >= 1, "lookups are counted");
+
+    expect(cff::auth::tokenDigest("") ==
+               "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+           "empty token digest matches sha256");
+    expect(cff::auth::tokenDigest("abc") ==
+               "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+           "token digest matches the hex sha256 auth_tokens stores");
+    expect(cff::auth::tokenDigest(std::string(64, 'a')) ==
+               "ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb",
+           "multi-block token digest matches sha256");
+
+    if (failures != 0) {
+        std::cerr << failures << " session cache assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "session cache contracts passed\n";
+    return 0;
+}
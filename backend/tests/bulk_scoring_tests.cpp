@@ -0,0 +1,143 @@
+#include "bulk_scoring.h"
+
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+bool closeTo(double left, double right) {
+    return std::fabs(left - right) < 0.000001;
+}
+
+Json::Value slot(const std::string &manager, const std::string &playerId, const std::string &rosterSlot) {
+    Json::Value entry(Json::objectValue);
+    entry["managerEmail"] = manager;
+    entry["playerId"] = playerId;
+    entry["rosterSlot"] = rosterSlot;
+    entry["player"]["name"] = "Player " + playerId;
+    return entry;
+}
+
+} // namespace
+
+int main() {
+    using cff::bulk_scoring::ProfilePoints;
+    using cff::bulk_scoring::WeekStatTable;
+
+    WeekStatTable table;
+    table.add("qb-1", "passing", "passYards", 250);
+    table.add("qb-1", "passing", "passTD", 2);
+    table.add("rb-1", "rushing", "rushYards", 100);
+    table.add("rb-1", "rushing", "rushAttempts", 20);
+    table.add("wr-1", "receiving", "receptions", 6);
+    table.add("wr-1", "receiving", "recYards", 80);
+    table.add("k-1", "", "", 0);
+    expect(table.players() == 4 && table.rows() == 6, "players and stat rows are tracked separately");
+    expect(table.index("k-1").has_value() && !table.index("missing").has_value(),
+           "players registered without stats are indexed");
+    expect(closeTo(table.stats(*table.index("rb-1"))["rushing.rushAttempts"].asDouble(), 20),
+           "unscored stats still reach the snapshot");
+
+    const auto defaults = table.points(cff::scoring_lifecycle::CompiledScoring{Json::Value{Json::objectValue}});
+    expect(closeTo(defaults[*table.index("qb-1")], 18), "passing points use the default profile");
+    expect(closeTo(defaults[*table.index("rb-1")], 10), "unscored stats add nothing");
+    expect(closeTo(defaults[*table.index("wr-1")], 14), "receptions and yards both count");
+    expect(closeTo(defaults[*table.index("k-1")], 0), "players without stats score zero");
+
+    ProfilePoints profiles(table);
+    Json::Value ppr(Json::objectValue);
+    ppr["reception"] = 1;
+    Json::Value halfPpr(Json::objectValue);
+    halfPpr["reception"] = 0.5;
+    const auto first = profiles.pointsFor(ppr);
+    const auto second = profiles.pointsFor(ppr);
+    const auto third = profiles.pointsFor(halfPpr);
+    expect(first == second, "leagues sharing settings share one points vector");
+    expect(profiles.profiles() == 2, "points are computed once per distinct profile");
+    expect(closeTo((*third)[*table.index("wr-1")], 11), "each profile applies its own scales");
+
+    Json::Value lineup(Json::arrayValue);
+    lineup.append(slot("Zed@Example.com", "wr-1", "wr"));
+    lineup.append(slot("amy@example.com", "rb-1", "rb"));
+    lineup.append(slot("amy@example.com", "qb-1", "qb"));
+    lineup.append(slot("amy@example.com", "wr-1", "Bench"));
+    lineup.append(slot("zed@example.com", "unknown", "flex"));
+    const auto scores = cff::bulk_scoring::scoreLineup(lineup, table, *first);
+    expect(scores.playerScores.size() == 4, "bench slots are not scored");
+    expect(scores.playerScores[0]["playerId"].asString() == "qb-1"
+               && scores.playerScores[1]["playerId"].asString() == "rb-1"
+               && scores.playerScores[2]["playerId"].asString() == "unknown"
+               && scores.playerScores[3]["playerId"].asString() == "wr-1",
+           "scores come out in manager then player order");
+    expect(scores.playerScores[3]["managerEmail"].asString() == "zed@example.com",
+           "manager emails are canonicalized");
+    expect(scores.playerScores[0]["player"]["playerId"].asString() == "qb-1"
+               && scores.playerScores[0]["player"]["name"].asString() == "Player qb-1",
+           "player snapshots keep their fields and gain ids");
+    expect(closeTo(scores.playerScores[0]["stats"]["passing.passTD"].asDouble(), 2),
+           "scores carry the player's stat map");
+    expect(scores.playerScores[2]["stats"].isObject() && scores.playerScores[2]["stats"].empty()
+               && closeTo(scores.playerScores[2]["fantasyPoints"].asDouble(), 0),
+           "players missing from the table score zero");
+    expect(closeTo(scores.managerTotals.at("amy@example.com"), 28)
+               && closeTo(scores.managerTotals.at("zed@example.com"), 14),
+           "manager totals sum their starters");
+
+    std::vector<std::thread> helpers;
+    const cff::bulk_scoring::Submit spawn = [&helpers](std::function<void()> task) {
+        helpers.emplace_back(std::move(task));
+        return true;
+    };
+    std::vector<int> visits(1000, 0);
+    std::atomic<int> calls{0};
+    cff::bulk_scoring::forEachPartitioned(visits.size(), 7, spawn, [&](std::size_t index) {
+        ++visits[index];
+        ++calls;
+    });
+    bool once = true;
+    for (const auto visit : visits) once = once && visit == 1;
+    expect(once && calls == 1000, "every item is visited exactly once across partitions");
+    expect(helpers.size() == 6, "the caller is one of the partitions");
+    calls = 0;
+    cff::bulk_scoring::forEachPartitioned(3, 16, spawn, [&](std::size_t) { ++calls; });
+    expect(calls == 3, "more threads than items still visits each item once");
+    cff::bulk_scoring::forEachPartitioned(0, 4, spawn, [&](std::size_t) { ++calls; });
+    expect(calls == 3, "an empty range does no work");
+    for (auto &helper : helpers) helper.join();
+
+    calls = 0;
+    const cff::bulk_scoring::Submit full = [](std::function<void()>) { return false; };
+    cff::bulk_scoring::forEachPartitioned(50, 4, full, [&](std::size_t) { ++calls; });
+    expect(calls == 50, "a rejected helper leaves its share to the caller");
+    std::vector<std::function<void()>> stalled;
+    const cff::bulk_scoring::Submit deferred = [&stalled](std::function<void()> task) {
+        stalled.push_back(std::move(task));
+        return true;
+    };
+    calls = 0;
+    cff::bulk_scoring::forEachPartitioned(50, 4, deferred, [&](std::size_t) { ++calls; });
+    expect(calls == 50, "helpers that never start do not block the caller");
+    for (const auto &task : stalled) task();
+    expect(calls == 50, "a helper starting after the range is done claims nothing");
+
+    if (failures != 0) {
+        std::cerr << failures << " bulk scoring assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Bulk scoring contracts passed\n";
+    return 0;
+}
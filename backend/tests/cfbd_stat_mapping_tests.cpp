@@ -0,0 +1,130 @@
+#include "cfbd_stat_mapping.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+Json::Value parse(const std::string &text) {
+    Json::Value value;
+    std::string errors;
+    std::istringstream stream{text};
+    Json::parseFromStream(Json::CharReaderBuilder{}, stream, &value, &errors);
+    return value;
+}
+
+const cff::cfbd_stats::StatRow *find(const cff::cfbd_stats::WeekStats &stats,
+                                     const std::string &playerId,
+                                     const std::string &statName) {
+    const auto found = std::find_if(stats.rows.begin(), stats.rows.end(), [&](const auto &row) {
+        return row.playerId == playerId && row.statName == statName;
+    });
+    return found == stats.rows.end() ? nullptr : &*found;
+}
+
+const char *kGame = R"({
+  "id": 401520281,
+  "teams": [
+    {"team": "Georgia", "conference": "SEC", "homeAway": "home", "points": 35, "categories": [
+      {"name": "passing", "types": [
+        {"name": "C/ATT", "athletes": [{"id": "4430", "name": "QB One", "stat": "21/30"}]},
+        {"name": "YDS", "athletes": [{"id": "4430", "name": "QB One", "stat": "287"}]},
+        {"name": "AVG", "athletes": [{"id": "4430", "name": "QB One", "stat": "9.6"}]},
+        {"name": "TD", "athletes": [{"id": "4430", "name": "QB One", "stat": "3"}]},
+        {"name": "INT", "athletes": [{"id": "4430", "name": "QB One", "stat": "1"}]}
+      ]},
+      {"name": "rushing", "types": [
+        {"name": "CAR", "athletes": [{"id": "5120", "name": "RB One", "stat": "18"},
+                                      {"id": "-9999", "name": "Team", "stat": "2"}]},
+        {"name": "YDS", "athletes": [{"id": 5120, "name": "RB One", "stat": "-4"}]}
+      ]}
+    ]},
+    {"school": "Tennessee", "conference": "SEC", "homeAway": "away", "categories": [
+      {"name": "receiving", "types": [
+        {"name": "REC", "athletes": [{"id": "6001", "name": "WR One", "stat": "7"}]},
+        {"name": "YDS", "athletes": [{"id": "6001", "name": "WR One", "stat": "--"}]},
+        {"name": "LONG", "athletes": [{"id": "6001", "name": "WR One", "stat": "44"}]}
+      ]},
+      {"name": "defensive", "types": [
+        {"name": "SACKS", "athletes": [{"id": "7001", "name": "DE One", "stat": "2"}]}
+      ]}
+    ]}
+  ]
+})";
+
+} // namespace
+
+int main() {
+    using namespace cff::cfbd_stats;
+
+    WeekStats stats;
+    appendGame(parse(kGame), stats);
+    expect(stats.games.size() == 1 && stats.games[0].id == 401520281, "each game is carried for its foreign key");
+    expect(stats.games[0].homeTeam == "Georgia" && stats.games[0].awayTeam == "Tennessee",
+           "home and away teams come from homeAway");
+
+    const auto *completions = find(stats, "4430", "passCompletions");
+    const auto *attempts = find(stats, "4430", "passAttempts");
+    expect(completions && completions->value == 21.0 && attempts && attempts->value == 30.0,
+           "C/ATT is split into completions and attempts");
+    const auto *yards = find(stats, "4430", "passYards");
+    expect(yards && yards->value == 287.0 && yards->category == "passing" && yards->team == "Georgia"
+               && yards->conference == "SEC" && yards->gameId == 401520281,
+           "passing yards keep their category, team and game");
+    expect(find(stats, "4430", "passTD") && find(stats, "4430", "passInt"), "touchdowns and interceptions map");
+    const auto *rushYards = find(stats, "5120", "rushYards");
+    expect(rushYards && rushYards->value == -4.0, "numeric ids and negative yardage are kept");
+    expect(find(stats, "6001", "receptions") && find(stats, "6001", "receptions")->team == "Tennessee",
+           "teams can be named by school");
+    expect(!find(stats, "6001", "recYards"), "non-numeric values are skipped");
+    expect(!find(stats, "7001", "defSacks"), "defense stays reserved");
+    expect(stats.rows.size() == 8, "averages and long gains have no stat key");
+    expect(stats.skipped == 2, "team totals and placeholders are counted as skipped");
+
+    WeekStats empty;
+    appendGame(parse(R"({"id": "not-a-number", "teams": []})"), empty);
+    appendGame(parse(R"({"id": 1})"), empty);
+    expect(empty.games.empty() && empty.rows.empty(), "games without an id or teams are ignored");
+
+    const auto record = statRecord(*yards, 2026, 3);
+    expect(record["statName"].asString() == "passyards" && record["season"].asInt() == 2026,
+           "records use the canonical tokens the manual apply path stores");
+
+    std::unordered_map<std::string, std::string> stored;
+    auto initial = diffStats(stats.rows, 2026, 3, stored);
+    expect(initial.changes.size() == stats.rows.size() && initial.unchanged == 0, "an empty week inserts every row");
+    expect(std::all_of(initial.changes.begin(), initial.changes.end(), [](const auto &change) {
+               return change.inserted;
+           }),
+           "rows without a stored hash are inserts");
+    for (const auto &change : initial.changes) stored[statKey(change.row, 2026, 3)] = change.sourceHash;
+
+    auto corrected = stats.rows;
+    corrected.push_back(*yards);
+    corrected.back().value = 301.0;
+    const auto second = diffStats(corrected, 2026, 3, stored);
+    expect(second.duplicates == 1, "repeated feed rows are collapsed");
+    expect(second.changes.size() == 1 && !second.changes[0].inserted && second.changes[0].row.value == 301.0,
+           "only the corrected row changes, keeping its last value");
+    expect(second.unchanged == stats.rows.size() - 1, "identical rows are unchanged");
+    expect(diffStats(stats.rows, 2026, 4, stored).changes.size() == stats.rows.size(),
+           "stored hashes are per week");
+
+    if (failures != 0) {
+        std::cerr << failures << " CFBD stat mapping assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "CFBD stat mapping contracts passed\n";
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "db_executor.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+void setEnvironment(const char *name, const char *value) {
+    if (setenv(name, value, 1) != 0) {
+        std::cerr << "Unable to set test environment variable " << name << '\n';
+        std::exit(2);
+    }
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+} // namespace
+
+int main() {
+    using namespace cff::db;
+
+    setEnvironment("CFF_DB_EXECUTOR_THREADS", "2");
+    setEnvironment("CFF_DB_EXECUTOR_QUEUE_CAPACITY", "2");
+
+    const auto settings = executorSettings();
+    expect(settings.threads == 2, "thread count is read from CFF_DB_EXECUTOR_THREADS");
+    expect(settings.queueCapacity == 2, "queue capacity is read from CFF_DB_EXECUTOR_QUEUE_CAPACITY");
+    expect(executorMetrics().threads == 0, "workers are not started before the first task");
+    expect(!onExecutorThread(), "the calling thread is not an executor worker");
+
+    std::mutex gateMutex;
+    std::condition_variable gate;
+    bool released = false;
+    std::atomic<int> ran{0};
+    std::atomic<int> offCaller{0};
+    std::atomic<int> onWorker{0};
+    const auto caller = std::this_thread::get_id();
+    const auto blockingTask = [&] {
+        if (std::this_thread::get_id() != caller) ++offCaller;
+        if (onExecutorThread()) ++onWorker;
+        std::unique_lock<std::mutex> lock(gateMutex);
+        gate.wait(lock, [&] { return released; });
+        ++ran;
+    };
+
+    expect(submit(blockingTask), "first task is accepted");
+    expect(submit(blockingTask), "second task is accepted");
+    expect(waitFor([] { return executorMetrics().active == 2; }),
+           "both workers pick up blocking tasks");
+    expect(submit(blockingTask), "third task queues behind busy workers");
+    expect(submit(blockingTask), "fourth task fills the queue");
+    expect(!submit(blockingTask), "a full queue rejects instead of blocking the caller");
+
+    auto metrics = executorMetrics();
+    expect(metrics.threads == 2, "metrics report started workers");
+    expect(metrics.queued == 2, "queued tasks are reported");
+    expect(metrics.rejected == 1, "rejections are counted");
+
+    {
+        std::lock_guard<std::mutex> lock(gateMutex);
+        released = true;
+    }
+    gate.notify_all();
+    expect(waitFor([] { return executorMetrics().completed == 4; }),
+           "every accepted task runs once the workers are released");
+    expect(ran == 4, "rejected tasks never run");
+    expect(offCaller == 4, "tasks run off the submitting thread");
+    expect(onWorker == 4, "workers identify themselves as executor threads");
+
+    expect(submit([] { throw std::runtime_error("boom"); }), "throwing task is accepted");
+    std::atomic<bool> survived{false};
+    expect(submit([&] { survived = true; }), "follow-up task is accepted");
+    expect(waitFor([&] { return survived.load(); }),
+           "a throwing task does not take its worker down");
+    expect(waitFor([] { return executorMetrics().failed == 1; }), "task failures are counted");
+
+    expect(waitFor([] { return executorMetrics().completed == 6; }),
+           "the throwing task still releases its slot");
+    expect(executorMetrics().submitted == 6, "accepted tasks are counted");
+
+    if (failures != 0) {
+        std::cerr << failures << " DB executor assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "DB executor contracts passed\n";
+    return 0;
+}
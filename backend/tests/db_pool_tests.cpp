@@ -0,0 +1,86 @@
+#include "db_pool.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+void setEnvironment(const char *name, const char *value) {
+    if (setenv(name, value, 1) != 0) {
+        std::cerr << "Unable to set test environment variable " << name << '\n';
+        std::exit(2);
+    }
+}
+
+void clearEnvironment(const char *name) {
+    if (unsetenv(name) != 0) {
+        std::cerr << "Unable to clear test environment variable " << name << '\n';
+        std::exit(2);
+    }
+}
+
+} // namespace
+
+int main() {
+    using namespace cff::db;
+
+    setEnvironment("CFF_DB_POOL_SIZE", "3");
+    setEnvironment("CFF_DB_POOL_ACQUIRE_TIMEOUT_MS", "50");
+    clearEnvironment("DB_URL");
+
+    const auto settings = poolSettings();
+    expect(settings.maxConnections == 3, "pool size is read from CFF_DB_POOL_SIZE");
+    expect(settings.acquireTimeout == std::chrono::milliseconds(50),
+           "acquire timeout is read from CFF_DB_POOL_ACQUIRE_TIMEOUT_MS");
+
+    auto missing = acquireConnection();
+    expect(!missing, "no connection is handed out when DB_URL is unset");
+    expect(missing.get() == nullptr, "an empty handle exposes a null connection");
+
+    // A socket directory that cannot exist fails immediately without DNS or
+    // network access, which keeps the failure path deterministic in CI.
+    setEnvironment("DB_URL", "host=/nonexistent-cff-pool-test port=1 connect_timeout=1");
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        auto unreachable = acquireConnection();
+        expect(!unreachable, "unreachable databases produce an empty handle");
+    }
+
+    const auto metrics = poolMetrics();
+    expect(metrics.maxConnections == 3, "metrics report the configured bound");
+    expect(metrics.connectFailures == 5, "every failed connect attempt is counted");
+    expect(metrics.open == 0, "failed connect attempts release their reserved slot");
+    expect(metrics.inUse == 0, "failed connect attempts are not left checked out");
+    expect(metrics.idle == 0, "failed connect attempts never become idle connections");
+    expect(metrics.checkouts == 0, "failed connect attempts are not counted as checkouts");
+    expect(metrics.waitTimeouts == 0,
+           "connect failures do not masquerade as wait-queue timeouts");
+
+    PooledConnection empty = nullptr;
+    PooledConnection moved = std::move(empty);
+    expect(!moved && !empty, "moving an empty handle keeps both handles empty");
+    moved.reset();
+    moved.discard();
+    expect(!moved, "reset and discard are safe on empty handles");
+
+    drainPool();
+    expect(poolMetrics().open == 0, "draining an empty pool leaves no open connections");
+
+    clearEnvironment("DB_URL");
+    if (failures != 0) {
+        std::cerr << failures << " connection pool assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "connection pool contracts passed\n";
+    return 0;
+}
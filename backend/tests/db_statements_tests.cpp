@@ -0,0 +1,97 @@
+#include "db_statements.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+// A one-row result whose columns carry the given wire format, built without
+// a server.
+PGresult *makeResult(int format, int columns) {
+    auto *result = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+    PGresAttDesc attributes[4] = {};
+    static char name[] = "value";
+    for (int column = 0; column < columns; ++column) {
+        attributes[column].name = name;
+        attributes[column].format = format;
+        attributes[column].typlen = -1;
+        attributes[column].atttypmod = -1;
+    }
+    PQsetResultAttrs(result, columns, attributes);
+    return result;
+}
+
+void setValue(PGresult *result, int column, const std::string &bytes) {
+    PQsetvalue(result, 0, column, const_cast<char *>(bytes.data()), static_cast<int>(bytes.size()));
+}
+
+const cff::db::Statement kOffline{"tests.offline", "SELECT 1", 0};
+const cff::db::Statement kBatched{"tests.batched", "SELECT $1::int", 1};
+
+const cff::db::StatementMetrics *findMetrics(const std::vector<cff::db::StatementMetrics> &metrics,
+                                             const std::string &name) {
+    const auto found = std::find_if(metrics.begin(), metrics.end(), [&](const auto &entry) {
+        return entry.name == name;
+    });
+    return found == metrics.end() ? nullptr : &*found;
+}
+
+} // namespace
+
+int main() {
+    using cff::db::integerValue;
+
+    auto *text = makeResult(0, 2);
+    setValue(text, 0, "-42");
+    PQsetvalue(text, 0, 1, nullptr, -1);
+    expect(integerValue(text, 0, 0) == -42, "text integers are parsed");
+    expect(integerValue(text, 0, 1, 7) == 7, "NULL columns return the fallback");
+    PQclear(text);
+
+    auto *binary = makeResult(1, 4);
+    setValue(binary, 0, std::string{"\x01\x02", 2});
+    setValue(binary, 1, std::string{"\xff\xff\xff\xfe", 4});
+    setValue(binary, 2, std::string{"\x00\x00\x00\x01\x00\x00\x00\x00", 8});
+    setValue(binary, 3, std::string{"\x01\x02\x03", 3});
+    expect(integerValue(binary, 0, 0) == 0x0102, "binary int2 is read in network order");
+    expect(integerValue(binary, 0, 1) == -2, "binary int4 is sign-extended");
+    expect(integerValue(binary, 0, 2) == 4294967296LL, "binary int8 keeps all 64 bits");
+    expect(integerValue(binary, 0, 3, -1) == -1, "other binary widths return the fallback");
+    PQclear(binary);
+
+    expect(integerValue(nullptr, 0, 0, 5) == 5, "a missing result returns the fallback");
+
+    expect(cff::db::execPrepared(nullptr, kOffline) == nullptr, "a null connection yields no result");
+    const auto batch = cff::db::execPipeline(nullptr, {{kBatched, {"1"}}, {kBatched, {"2"}}, {kOffline, {}}});
+    expect(batch.size() == 3 && std::all_of(batch.begin(), batch.end(), [](auto *result) { return !result; }),
+           "a pipeline without a connection yields one empty slot per query");
+    expect(cff::db::execPipeline(nullptr, {}).empty(), "an empty pipeline returns no results");
+
+    const auto metrics = cff::db::statementMetrics();
+    const auto *offline = findMetrics(metrics, "tests.offline");
+    expect(offline != nullptr, "executed statements are reported");
+    expect(offline && offline->calls == 2 && offline->failures == 2 && offline->prepares == 0,
+           "failed calls are counted without a prepare");
+    const auto *batched = findMetrics(metrics, "tests.batched");
+    expect(batched && batched->calls == 2 && batched->failures == 2,
+           "each pipelined query is counted on its statement");
+
+    cff::db::forgetConnection(nullptr);
+
+    if (failures != 0) {
+        std::cerr << failures << " db statements assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Database statement contracts passed\n";
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "draft_clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+bool contains(const std::vector<std::string> &values, const std::string &value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+} // namespace
+
+int main() {
+    using namespace cff::draft_clock;
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+
+    const auto origin = Clock::now();
+    TimerWheel wheel{milliseconds{250}, 8, origin};
+    expect(!wheel.nextWake(), "an empty wheel never wakes");
+
+    wheel.schedule("league-a", origin + seconds{1});
+    wheel.schedule("league-b", origin + milliseconds{1500});
+    expect(wheel.size() == 2, "scheduled leagues are tracked");
+    expect(wheel.nextWake() == origin + seconds{1}, "wakes exactly at the earliest deadline");
+    expect(wheel.advance(origin + milliseconds{999}).empty(), "nothing fires before its deadline");
+
+    auto fired = wheel.advance(origin + seconds{1});
+    expect(fired.size() == 1 && fired.front() == "league-a", "the due league fires once");
+    expect(!wheel.scheduled("league-a"), "fired leagues are disarmed");
+    expect(wheel.advance(origin + seconds{1}).empty(), "a fired deadline does not repeat");
+
+    wheel.schedule("league-b", origin + seconds{3});
+    expect(wheel.advance(origin + seconds{2}).empty(), "rescheduling replaces the earlier deadline");
+    expect(wheel.nextWake() == origin + seconds{3}, "replacement deadline drives the next wake");
+
+    wheel.cancel("league-b");
+    expect(wheel.advance(origin + seconds{4}).empty(), "cancelled deadlines never fire");
+    expect(!wheel.nextWake(), "cancelled deadlines do not keep the wheel awake");
+
+    wheel.schedule("league-far", origin + seconds{60});
+    const auto firstWake = wheel.nextWake();
+    expect(firstWake && *firstWake < origin + seconds{60},
+           "deadlines beyond one rotation wake at the rotation boundary");
+    expect(wheel.advance(origin + seconds{10}).empty(), "later rounds stay parked in their slot");
+    expect(contains(wheel.advance(origin + seconds{61}), "league-far"), "later rounds fire when due");
+
+    wheel.schedule("league-late", origin + seconds{30});
+    expect(wheel.nextWake() == origin + seconds{30}, "a deadline already behind the cursor wakes immediately");
+    expect(contains(wheel.advance(origin + seconds{61}), "league-late"),
+           "a deadline already behind the cursor fires on the next advance");
+
+    std::mutex mutex;
+    std::condition_variable firedSignal;
+    std::vector<std::string> dueLeagues;
+    setDueHandler([&](const std::string &leagueId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        dueLeagues.push_back(leagueId);
+        firedSignal.notify_all();
+    });
+    arm("league-live", Clock::now() + milliseconds{20});
+    arm("league-cancelled", Clock::now() + milliseconds{20});
+    disarm("league-cancelled");
+    expect(armed("league-live"), "armed leagues are visible");
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        firedSignal.wait_for(lock, seconds{5}, [&] { return !dueLeagues.empty(); });
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        expect(dueLeagues == std::vector<std::string>{"league-live"}, "the clock thread fires due leagues");
+    }
+    expect(!armed("league-live"), "the clock disarms a league once it fires");
+    expect(clockMetrics().fired == 1, "fired deadlines are counted");
+
+    if (failures != 0) {
+        std::cerr << failures << " draft clock assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Draft clock contracts passed\n";
+    return 0;
+}
@@ -84,7 +84,7 @@ require(HARDENING, '"/draft/readiness"', "readiness endpoint must be handled by
 require(HARDENING, "last_seen_at", "draft GET/readiness requests must maintain presence")
 require(HARDENING, "draft_date <= NOW() + INTERVAL '30 minutes'", "draft lobby must auto-open before scheduled draft time")
 require(HARDENING, "version = version + 1", "every authoritative draft mutation must advance revision")
-require(HARDENING, "registerSyncAdvice(draftLifecycleAdvice)", "hardening must run before legacy draft handlers")
+require(HARDENING, 'addDraftRoute({drogon::Post}, "/draft/picks", DraftRoute::Pick)', "hardening must run before legacy draft handlers")
 
 require(LIFECYCLE, "std::sort(emails.begin(), emails.end())", "default order must be deterministic")
 require(LIFECYCLE, "league_schedule::currentDraftManager", "snake turns must use the shared deterministic schedule helper")
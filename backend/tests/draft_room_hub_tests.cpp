@@ -0,0 +1,123 @@
+#include "draft_room_hub.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+Json::Value parse(const std::string &raw) {
+    Json::CharReaderBuilder builder;
+    Json::Value parsed;
+    std::string errors;
+    std::istringstream stream(raw);
+    return Json::parseFromStream(builder, stream, &parsed, &errors) ? parsed : Json::Value{};
+}
+
+Json::Value board(int currentPick) {
+    Json::Value data(Json::objectValue);
+    data["status"] = "open";
+    data["currentPick"] = currentPick;
+    return data;
+}
+
+} // namespace
+
+int main() {
+    using cff::draft_room::DraftRoomHub;
+
+    DraftRoomHub hub{3};
+    std::vector<std::string> first;
+    const auto firstId = hub.subscribe("league-1", 0, [&](const std::string &message) { first.push_back(message); });
+    expect(first.size() == 1, "subscribing sends a hello");
+    const auto hello = parse(first.front());
+    expect(hello["type"].asString() == "subscribed" && hello["sequence"].asUInt64() == 0,
+           "the hello carries the room sequence");
+    expect(!hello.isMember("resync"), "a fresh subscriber does not need a resync");
+    expect(hub.subscribers("league-1") == 1 && hub.rooms() == 1, "subscribers are counted per room");
+
+    std::vector<std::string> other;
+    hub.subscribe("league-2", 0, [&](const std::string &message) { other.push_back(message); });
+    hub.publish("league-1", "pick_made", 7, board(2));
+    expect(first.size() == 2, "deltas reach the room");
+    expect(other.size() == 1, "deltas never cross rooms");
+    const auto delta = parse(first.back());
+    expect(delta["type"].asString() == "pick_made", "deltas keep their type");
+    expect(delta["sequence"].asUInt64() == 1 && delta["version"].asInt64() == 7, "deltas carry sequence and version");
+    expect(delta["data"]["currentPick"].asInt() == 2, "deltas carry the shared board");
+
+    hub.publish("league-1", "clock_reset", 6, board(1));
+    expect(first.size() == 2, "a delta read at an older version is dropped");
+    hub.publish("league-1", "readiness_changed", 7, board(2));
+    expect(first.size() == 3, "deltas at the current version still fan out");
+    hub.publish("league-1", "pick_made", 8, board(3));
+
+    std::vector<std::string> replayed;
+    hub.subscribe("league-1", 1, [&](const std::string &message) { replayed.push_back(message); });
+    expect(replayed.size() == 3, "a reconnect replays deltas after its sequence");
+    expect(parse(replayed[1])["sequence"].asUInt64() == 2 && parse(replayed[2])["sequence"].asUInt64() == 3,
+           "replayed deltas arrive in order");
+
+    hub.publish("league-1", "pick_made", 9, board(4));
+    hub.publish("league-1", "pick_made", 10, board(5));
+    std::vector<std::string> late;
+    hub.subscribe("league-1", 1, [&](const std::string &message) { late.push_back(message); });
+    expect(late.size() == 1 && parse(late.front())["resync"].asBool(),
+           "a reconnect past the backlog is told to resync");
+    std::vector<std::string> ahead;
+    hub.subscribe("league-1", 99, [&](const std::string &message) { ahead.push_back(message); });
+    expect(ahead.size() == 1 && parse(ahead.front())["resync"].asBool(),
+           "a sequence from an earlier process is told to resync");
+
+    hub.unsubscribe("league-1", firstId);
+    const auto before = first.size();
+    hub.publish("league-1", "pick_made", 11, board(6));
+    expect(first.size() == before, "unsubscribed sinks stop receiving deltas");
+
+    DraftRoomHub single;
+    const auto only = single.subscribe("league-3", 0, [](const std::string &) {});
+    single.unsubscribe("league-3", only);
+    expect(single.rooms() == 0, "empty rooms are released");
+    single.publish("league-3", "pick_made", 1, board(1));
+    expect(single.rooms() == 0, "publishing to an empty room does not create it");
+
+    DraftRoomHub racing;
+    racing.subscribe("league-4", 0, [](const std::string &) {});
+    std::mutex receivedMutex;
+    std::vector<std::string> received;
+    std::atomic<bool> helloStarted{false};
+    std::thread publisher([&] {
+        while (!helloStarted.load()) std::this_thread::yield();
+        racing.publish("league-4", "pick_made", 1, board(1));
+    });
+    racing.subscribe("league-4", 0, [&](const std::string &message) {
+        if (!helloStarted.exchange(true)) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> lock(receivedMutex);
+        received.push_back(message);
+    });
+    publisher.join();
+    expect(received.size() == 2 && parse(received[0])["type"].asString() == "subscribed"
+               && parse(received[1])["sequence"].asUInt64() == 1,
+           "a concurrent delta never overtakes the hello");
+
+    if (failures != 0) {
+        std::cerr << failures << " draft room hub assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Draft room hub contracts passed\n";
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "free_agent_pool.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+cff::PlayerCard player(const std::string &id, const std::string &position, const std::string &team) {
+    cff::PlayerCard card;
+    card.id = id;
+    card.name = "Player " + id;
+    card.team = team;
+    card.position = position;
+    card.conference = "SEC";
+    card.season = 2025;
+    return card;
+}
+
+std::string ids(const std::optional<std::vector<cff::PlayerCard>> &players) {
+    if (!players) return "<none>";
+    std::string output;
+    for (const auto &card : *players) output += card.id + ",";
+    return output;
+}
+
+} // namespace
+
+int main() {
+    using cff::player_search_index::PlayerSearchIndex;
+    using cff::player_search_index::Query;
+
+    const auto catalog = std::make_shared<const PlayerSearchIndex>(std::vector<cff::PlayerCard>{
+        player("a", "QB", "Alabama"),
+        player("b", "RB", "Alabama"),
+        player("c", "WR", "Georgia"),
+        player("d", "OL", "Georgia"),
+        player("e", "TE", "Texas"),
+    });
+
+    Query fantasy;
+    fantasy.fantasyPositionsOnly = true;
+    fantasy.limit = 25;
+
+    cff::free_agent_pool::FreeAgentPool pool;
+    expect(!pool.version("league-1"), "an unknown league has no version");
+    expect(!pool.freeAgents("league-1", catalog, fantasy), "an unknown league is not answered from memory");
+
+    pool.store("league-1", 3, {"b", "missing-player"});
+    expect(pool.version("league-1") == 3, "a stored league keeps its roster version");
+    expect(ids(pool.freeAgents("league-1", catalog, fantasy)) == "a,c,e,",
+           "rostered and non-fantasy players are excluded");
+
+    Query alabama = fantasy;
+    alabama.team = std::string{"alabama"};
+    expect(ids(pool.freeAgents("league-1", catalog, alabama)) == "a,", "filters combine with the exclusion");
+
+    Query paged = fantasy;
+    paged.limit = 1;
+    paged.offset = 1;
+    expect(ids(pool.freeAgents("league-1", catalog, paged)) == "c,", "pages skip rostered players");
+
+    pool.store("league-1", 2, {});
+    expect(pool.version("league-1") == 3, "an older roster version does not replace a newer one");
+    pool.store("league-1", 4, {"a", "c"});
+    expect(ids(pool.freeAgents("league-1", catalog, fantasy)) == "b,e,", "a newer roster version replaces the set");
+
+    pool.store("league-2", 1, {"e"});
+    expect(ids(pool.freeAgents("league-2", catalog, fantasy)) == "a,b,c,", "leagues are independent");
+
+    const auto rebuilt = std::make_shared<const PlayerSearchIndex>(std::vector<cff::PlayerCard>{
+        player("e", "TE", "Texas"),
+        player("f", "QB", "Texas"),
+        player("a", "QB", "Alabama"),
+    });
+    expect(ids(pool.freeAgents("league-1", rebuilt, fantasy)) == "f,e,",
+           "a swapped catalog remaps the rostered players by id");
+    expect(ids(pool.freeAgents("league-1", catalog, fantasy)) == "b,e,", "the previous catalog still answers");
+
+    if (failures != 0) {
+        std::cerr << failures << " free agent pool assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Free agent pool contracts passed\n";
+    return 0;
+}
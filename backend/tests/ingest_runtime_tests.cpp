@@ -1,10 +1,12 @@
 #include "ingest_runtime.h"
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -46,6 +48,17 @@ void testResultLogging() {
             "[cfbd] contract ingest error: second failure\n",
         "ingestion error logging changed"
     );
+
+    auto cancelled = sampleResult();
+    cancelled.cancelled = true;
+    cancelled.errors.clear();
+    std::ostringstream cancelledOutput;
+    cff::ingest_runtime::logIngestResult("admin ingest", cancelled, cancelledOutput, errors);
+    require(
+        cancelledOutput.str() ==
+            "[cfbd] admin ingest cancelled. inserted=12 updated=4 api_calls=3\n",
+        "cancelled ingests must not be logged as complete"
+    );
 }
 
 void testDisabledStartupDoesNothing() {
@@ -137,6 +150,80 @@ void testScheduledCycleSleepsBeforeRunning() {
     );
 }
 
+void testJobsRunInTheBackgroundOneAtATime() {
+    std::atomic<bool> release{false};
+    std::atomic<int> calls{0};
+    cff::ingest_runtime::IngestJobs jobs{[&](cff::IngestProgress &progress) {
+        ++calls;
+        progress.phase.store(cff::IngestPhase::Staging);
+        progress.rowsStaged.store(42);
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return sampleResult();
+    }};
+
+    const auto first = jobs.start("admin@example.com");
+    require(first.created && !first.id.empty(), "starting an idle runner did not create a job");
+    const auto second = jobs.start("other@example.com");
+    require(!second.created && second.id == first.id, "a second start did not join the running job");
+
+    while (jobs.find(first.id)->phase != "staging") std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const auto running = jobs.find(first.id);
+    require(running->state == "running", "an unfinished job is not reported as running");
+    require(running->rowsStaged == 42, "job progress counters are not visible while it runs");
+    require(running->requestedBy == "admin@example.com", "the requesting admin was not kept");
+    require(!running->result, "an unfinished job reported a result");
+
+    release = true;
+    jobs.wait();
+    const auto finished = jobs.find(first.id);
+    require(finished->state == "partial", "a job with errors did not finish as partial");
+    require(finished->phase == "finished", "a finished job kept its last phase");
+    require(finished->result && finished->result->ingested == 12, "the ingest result was not kept");
+    require(!finished->finishedAt.empty(), "a finished job has no finish time");
+    require(!jobs.cancel(first.id), "a finished job accepted a cancellation");
+    require(calls == 1, "joining a running job started another ingest");
+
+    const auto next = jobs.start("admin@example.com");
+    require(next.created && next.id != first.id, "a new job could not start after the first finished");
+    jobs.wait();
+    require(jobs.latest()->id == next.id, "the latest job is not the newest one");
+}
+
+void testJobsCancelCooperatively() {
+    cff::ingest_runtime::IngestJobs jobs{[](cff::IngestProgress &progress) {
+        progress.phase.store(cff::IngestPhase::FetchingRosters);
+        while (!progress.cancelled()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        cff::IngestResult result;
+        result.cancelled = true;
+        return result;
+    }};
+    const auto started = jobs.start("admin@example.com");
+    require(!jobs.cancel("unknown"), "an unknown job accepted a cancellation");
+    require(jobs.cancel(started.id), "the running job refused a cancellation");
+    jobs.wait();
+    const auto job = jobs.find(started.id);
+    require(job->state == "cancelled" && job->cancelRequested, "a cancelled job did not report it");
+}
+
+void testJobFailuresAndHistory() {
+    cff::ingest_runtime::IngestJobs jobs{[](cff::IngestProgress &) -> cff::IngestResult {
+        throw std::runtime_error("provider exploded");
+    }, 2};
+    const auto first = jobs.start("admin@example.com");
+    jobs.wait();
+    const auto failed = jobs.find(first.id);
+    require(failed->state == "partial", "a throwing runner did not finish as partial");
+    require(failed->result->errors.size() == 1
+                && failed->result->errors.front() == "Ingest failed: provider exploded",
+            "a throwing runner did not record its error");
+
+    jobs.start("admin@example.com");
+    jobs.wait();
+    jobs.start("admin@example.com");
+    jobs.wait();
+    require(!jobs.find(first.id), "jobs beyond the history limit were kept");
+}
+
 } // namespace
 
 int main() {
@@ -145,6 +232,9 @@ int main() {
         testDisabledStartupDoesNothing();
         testEnabledStartupRunsOnce();
         testScheduledCycleSleepsBeforeRunning();
+        testJobsRunInTheBackgroundOneAtATime();
+        testJobsCancelCooperatively();
+        testJobFailuresAndHistory();
         std::cout << "ingest runtime contracts passed" << std::endl;
         return 0;
     } catch (const std::exception &error) {
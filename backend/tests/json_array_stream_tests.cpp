@@ -0,0 +1,83 @@
+#include "json_array_stream.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+struct Split {
+    bool ok{false};
+    std::vector<std::string> elements;
+    std::string error;
+};
+
+Split split(const std::string &input, std::size_t chunkSize) {
+    Split result;
+    cff::json_stream::ArraySplitter splitter{[&](std::string_view element) {
+        result.elements.emplace_back(element);
+    }};
+    for (std::size_t start = 0; start < input.size(); start += chunkSize) {
+        splitter.feed(std::string_view(input).substr(start, chunkSize));
+    }
+    result.ok = splitter.finish();
+    result.error = splitter.error();
+    return result;
+}
+
+} // namespace
+
+int main() {
+    const std::string roster =
+        " [ {\"id\":1,\"name\":\"A \\\"Quote\\\" ]}, [\",\"tags\":[1,{\"x\":[]}]},\n"
+        "   {\"id\":2,\"name\":\"back\\\\slash\"} , 3 , \"plain, string\" ,null ] \n";
+    const std::vector<std::string> expected{
+        "{\"id\":1,\"name\":\"A \\\"Quote\\\" ]}, [\",\"tags\":[1,{\"x\":[]}]}",
+        "{\"id\":2,\"name\":\"back\\\\slash\"}",
+        "3",
+        "\"plain, string\"",
+        "null",
+    };
+
+    bool everyChunking = true;
+    for (std::size_t chunk = 1; chunk <= roster.size(); ++chunk) {
+        const auto result = split(roster, chunk);
+        if (!result.ok || result.elements != expected) {
+            everyChunking = false;
+            std::cerr << "chunk size " << chunk << " split differently\n";
+        }
+    }
+    expect(everyChunking, "elements are identical for every chunk boundary");
+
+    expect(split("[]", 1).ok && split("[]", 1).elements.empty(), "an empty array has no elements");
+    expect(split(" [ \n ] ", 2).ok, "whitespace around an empty array is allowed");
+
+    const auto object = split("{\"message\":\"Unauthorized\"}", 4);
+    expect(!object.ok && object.elements.empty() && !object.error.empty(), "an object is not an array");
+    expect(!split("", 1).ok, "an empty body is rejected");
+    expect(!split("[{\"id\":1},", 3).ok, "a truncated array is rejected");
+    expect(!split("[{\"id\":1}", 3).ok, "an unterminated array is rejected");
+    expect(!split("[1,]", 1).ok, "a trailing comma is rejected");
+    expect(!split("[,1]", 1).ok, "a leading comma is rejected");
+    expect(!split("[1}]", 1).ok, "unbalanced brackets are rejected");
+    expect(!split("[1] [2]", 1).ok, "data after the array is rejected");
+
+    const auto partial = split("[1,2,3", 1);
+    expect(partial.elements.size() == 2, "complete elements are delivered before a truncation is seen");
+
+    if (failures != 0) {
+        std::cerr << failures << " JSON array stream assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "JSON array stream contracts passed\n";
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "league_access_cache.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+cff::league_access::Membership membership(bool owner, const std::string &role, const std::string &status) {
+    cff::league_access::Membership value;
+    value.exists = true;
+    value.owner = owner;
+    value.role = role;
+    value.status = status;
+    return value;
+}
+
+} // namespace
+
+int main() {
+    using cff::league_access::Membership;
+    using cff::league_access::MembershipCache;
+    using cff::league_access::MembershipCacheSettings;
+    using std::chrono::seconds;
+
+    expect(membership(true, "", "").commissioner(), "the owner is a commissioner without a member row");
+    expect(membership(false, "commissioner", "active").commissioner(), "active commissioners manage the league");
+    expect(!membership(false, "commissioner", "pending").commissioner(), "pending commissioners do not");
+    expect(membership(false, "member", "active").member(), "active members can read the league");
+    expect(!membership(false, "member", "invited").member(), "invited members cannot yet");
+    expect(!Membership{}.member() && !Membership{}.commissioner(), "a missing league grants nothing");
+
+    MembershipCacheSettings settings;
+    settings.capacity = 32;
+    settings.ttl = seconds{30};
+    MembershipCache cache{settings};
+    const auto start = MembershipCache::Clock::now();
+
+    expect(!cache.find("league-1", "a@example.com", start), "unknown pairs miss");
+    auto generation = cache.generation("league-1");
+    expect(cache.store("league-1", "a@example.com", membership(false, "member", "active"), generation, start),
+           "loaded memberships are cached");
+    const auto hit = cache.find("league-1", "A@Example.com", start + seconds{1});
+    expect(hit && hit->member(), "lookups ignore email case");
+    expect(!cache.find("league-2", "a@example.com", start), "entries are per league");
+    expect(!cache.find("league-1", "a@example.com", start + seconds{31}), "entries expire after the ttl");
+
+    generation = cache.generation("league-1");
+    cache.store("league-1", "a@example.com", membership(false, "member", "pending"), generation, start);
+    cache.store("league-1", "b@example.com", membership(false, "member", "active"), generation, start);
+    cache.invalidate("league-1");
+    expect(!cache.find("league-1", "a@example.com", start) && !cache.find("league-1", "b@example.com", start),
+           "invalidating a league drops every member");
+    expect(!cache.store("league-1", "a@example.com", membership(false, "member", "pending"), generation, start),
+           "a load that started before an invalidation is not stored");
+    expect(!cache.find("league-1", "a@example.com", start), "so the replaced status cannot be served");
+
+    Membership missing;
+    generation = cache.generation("league-404");
+    cache.store("league-404", "a@example.com", missing, generation, start);
+    const auto negative = cache.find("league-404", "a@example.com", start);
+    expect(negative && !negative->exists, "missing leagues are cached until invalidated");
+
+    for (int league = 0; league < 500; ++league) {
+        const auto id = "bulk-" + std::to_string(league);
+        cache.store(id, "a@example.com", membership(false, "member", "active"), cache.generation(id), start);
+    }
+    expect(cache.size() <= settings.capacity, "the cache stays within its configured capacity");
+
+    if (failures != 0) {
+        std::cerr << failures << " league access cache assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "League access cache contracts passed\n";
+    return 0;
+}
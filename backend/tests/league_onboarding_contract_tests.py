@@ -46,7 +46,7 @@ require(BACKEND, "currentStatus == \"pending\"", "duplicate join requests must b
 require(BACKEND, "status <> 'removed'", "invite capacity must count all current invited or reserved managers")
 require(BACKEND, "WHERE league_id = $1 AND email = $2 AND status IN ('invited', 'pending')", "approval must use a compare-and-set transition")
 require(BACKEND, '"join_request_conflict"', "approval races need a stable retryable conflict")
-require(BACKEND, "registerSyncAdvice(onboardingAdvice)", "hardening must run before legacy route handlers")
+require(BACKEND, 'cff::http::addDispatchRoute(drogon::Post, "/api/leagues/{}/join"', "hardening must run before legacy route handlers")
 
 require(ROUTES, '"/api/leagues"', "create route must remain registered")
 require(ROUTES, '"/api/leagues/{1}/join"', "join route must remain registered")
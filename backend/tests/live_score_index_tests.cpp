@@ -0,0 +1,131 @@
+#include "live_score_index.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+Json::Value parse(const std::string &raw) {
+    Json::CharReaderBuilder builder;
+    Json::Value parsed;
+    std::string errors;
+    std::istringstream stream(raw);
+    return Json::parseFromStream(builder, stream, &parsed, &errors) ? parsed : Json::Value{};
+}
+
+Json::Value game(const std::string &id, int week, int homeScore, bool live, const std::string &status = "scheduled") {
+    Json::Value value(Json::objectValue);
+    value["id"] = id;
+    value["week"] = week;
+    value["home"] = "Home " + id;
+    value["away"] = "Away " + id;
+    value["homeScore"] = homeScore;
+    value["awayScore"] = 0;
+    value["status"] = status;
+    value["live"] = live;
+    return value;
+}
+
+std::string ids(const Json::Value &games) {
+    std::string output;
+    for (const auto &item : games) output += item["id"].asString() + ",";
+    return output;
+}
+
+} // namespace
+
+int main() {
+    using cff::live_score_index::LiveScoreIndex;
+    using cff::live_score_index::Query;
+
+    LiveScoreIndex index{1000};
+    expect(index.version() == 0, "an empty index has no version");
+    expect(index.query(Query{1, false, std::nullopt}).body == "[]", "an empty index serves empty weeks");
+
+    Json::Value games(Json::arrayValue);
+    games.append(game("a", 1, 0, false, "final"));
+    games.append(game("b", 2, 7, true, "in progress"));
+    games.append(game("c", 2, 0, false));
+    games.append(game("d", 3, 0, false));
+    games.append(game("", 3, 0, false));
+    const auto first = index.update(games);
+    expect(first == 1000, "the first change takes the first version");
+
+    const auto weekTwo = parse(index.query(Query{2, false, std::nullopt}).body);
+    expect(weekTwo.isArray() && ids(weekTwo) == "b,c,", "week reads return only that week in payload order");
+    expect(weekTwo[0]["homeScore"].asInt() == 7, "games keep the payload fields");
+    expect(index.query(Query{9, false, std::nullopt}).body == "[]", "an unknown week is empty");
+    expect(ids(parse(index.query(Query{std::nullopt, true, std::nullopt}).body)) == "b,", "live reads return live games");
+    expect(ids(parse(index.query(Query{3, true, std::nullopt}).body)).empty(), "week and live filters combine");
+    expect(ids(parse(index.query(Query{std::nullopt, false, std::nullopt}).body)) == "a,b,c,d,",
+           "games without ids are dropped");
+
+    expect(index.update(games) == first, "an identical payload keeps the version");
+    const auto upToDate = parse(index.query(Query{std::nullopt, false, first}).body);
+    expect(upToDate["version"].asUInt64() == first && !upToDate["full"].asBool() && upToDate["games"].empty(),
+           "a caller at the current version gets an empty delta");
+
+    Json::Value next(Json::arrayValue);
+    next.append(game("a", 1, 0, false, "final"));
+    next.append(game("b", 2, 14, false, "final"));
+    next.append(game("c", 2, 3, true, "in progress"));
+    const auto second = index.update(next);
+    expect(second == first + 1, "a changed payload bumps the version by one");
+
+    const auto delta = parse(index.query(Query{std::nullopt, false, first}).body);
+    expect(!delta["full"].asBool() && delta["version"].asUInt64() == second, "a known version gets a delta");
+    expect(ids(delta["games"]) == "b,c,", "the delta carries only changed games");
+    expect(delta["removed"].size() == 1 && delta["removed"][0].asString() == "d", "the delta lists removed games");
+
+    const auto liveDelta = parse(index.query(Query{std::nullopt, true, first}).body);
+    expect(ids(liveDelta["games"]) == "b,c,", "a live delta keeps games that just went final");
+    const auto weekDelta = parse(index.query(Query{1, false, first}).body);
+    expect(weekDelta["games"].empty(), "a week delta only covers that week");
+
+    const auto stale = parse(index.query(Query{std::nullopt, false, 5}).body);
+    expect(stale["full"].asBool() && ids(stale["games"]) == "a,b,c," && stale["removed"].empty(),
+           "a version from before this index gets a full response");
+    const auto ahead = parse(index.query(Query{std::nullopt, false, second + 50}).body);
+    expect(ahead["full"].asBool() && ahead["games"].size() == 3, "a version from a newer process gets a full response");
+
+    next.append(game("d", 3, 0, false));
+    index.update(next);
+    const auto returned = parse(index.query(Query{std::nullopt, false, second}).body);
+    expect(ids(returned["games"]) == "d," && returned["removed"].empty(), "a returning game is no longer removed");
+
+    // Tombstones outlive the delta window only as a full-response floor.
+    LiveScoreIndex churn{1};
+    Json::Value start(Json::arrayValue);
+    start.append(game("gone", 1, 0, false));
+    start.append(game("tick", 1, 0, true));
+    const auto before = churn.update(start);
+    Json::Value tick(Json::arrayValue);
+    tick.append(game("tick", 1, 1, true));
+    const auto removedAt = churn.update(tick);
+    for (int score = 2; score < 2 + static_cast<int>(LiveScoreIndex::kTombstoneVersions); ++score) {
+        tick[0] = game("tick", 1, score, true);
+        churn.update(tick);
+    }
+    const auto pruned = parse(churn.query(Query{std::nullopt, false, removedAt}).body);
+    expect(!pruned["full"].asBool() && pruned["removed"].empty(), "expired tombstones are dropped from deltas");
+    const auto tooOld = parse(churn.query(Query{std::nullopt, false, before}).body);
+    expect(tooOld["full"].asBool() && ids(tooOld["games"]) == "tick,",
+           "a version older than a dropped tombstone gets a full response");
+
+    if (failures != 0) {
+        std::cerr << failures << " live score index assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Live score index contracts passed\n";
+    return 0;
+}
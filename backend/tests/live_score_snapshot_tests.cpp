@@ -0,0 +1,102 @@
+#include "live_score_snapshot.h"
+
+#include <zlib.h>
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+std::string gunzip(const std::string &compressed) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) return "";
+    std::string output;
+    char buffer[4096];
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    int status = Z_OK;
+    while (status == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef *>(buffer);
+        stream.avail_out = sizeof(buffer);
+        status = inflate(&stream, Z_NO_FLUSH);
+        output.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    return status == Z_STREAM_END ? output : "";
+}
+
+std::string season(int games, int homeScore) {
+    std::string body = "[";
+    for (int game = 0; game < games; ++game) {
+        if (game) body += ',';
+        body += "{\"id\":\"" + std::to_string(400000 + game) + "\",\"week\":" + std::to_string(game / 60 + 1)
+            + ",\"home\":\"Home\",\"away\":\"Away\",\"homeScore\":" + std::to_string(homeScore)
+            + ",\"awayScore\":0,\"status\":\"scheduled\",\"live\":false}";
+    }
+    return body + "]";
+}
+
+} // namespace
+
+int main() {
+    namespace snapshot = cff::live_score_snapshot;
+    using snapshot::Encoding;
+
+    expect(snapshot::current() == nullptr, "nothing is served before the first publish");
+
+    const auto body = season(800, 7);
+    expect(snapshot::publish(body), "the first payload is published");
+    const auto first = snapshot::current();
+    expect(first && first->version == 1 && first->body == body, "the snapshot keeps the serialized bytes");
+    expect(first->etag.size() > 2 && first->etag.front() == '"' && first->etag.back() == '"',
+           "the ETag is a quoted strong validator");
+    expect(!first->gzip.empty() && first->gzip.size() < body.size(), "a gzip variant is prepared");
+    expect(gunzip(first->gzip) == body, "the gzip variant decodes to the body");
+    expect(!first->brotli.empty() && first->brotli.size() < body.size(), "a brotli variant is prepared");
+
+    expect(!snapshot::publish(body), "publishing identical bytes is a no-op");
+    expect(snapshot::current() == first, "an identical publish keeps the snapshot and its ETag");
+
+    expect(snapshot::publish(season(800, 14)), "changed bytes publish a new snapshot");
+    const auto second = snapshot::current();
+    expect(second->version == 2 && second->etag != first->etag, "a new snapshot gets a new version and ETag");
+    expect(first->body == body, "readers holding the old snapshot keep its bytes");
+
+    expect(snapshot::etagMatches(second->etag, second->etag), "the current ETag matches");
+    expect(snapshot::etagMatches("\"other\", " + second->etag, second->etag), "any listed ETag matches");
+    expect(snapshot::etagMatches("W/" + second->etag, second->etag), "a weakened ETag still matches");
+    expect(snapshot::etagMatches("*", second->etag), "a wildcard matches");
+    expect(!snapshot::etagMatches(first->etag, second->etag), "an older ETag does not match");
+    expect(!snapshot::etagMatches("", second->etag), "a missing header does not match");
+
+    expect(snapshot::preferredEncoding("gzip, deflate, br", *second) == Encoding::Brotli, "brotli is preferred");
+    expect(snapshot::preferredEncoding("gzip", *second) == Encoding::Gzip, "gzip is used when brotli is not offered");
+    expect(snapshot::preferredEncoding("br;q=0, gzip", *second) == Encoding::Gzip, "q=0 rejects an encoding");
+    expect(snapshot::preferredEncoding("br;q=0.2, gzip;q=0.8", *second) == Encoding::Gzip,
+           "the higher quality wins");
+    expect(snapshot::preferredEncoding("*", *second) == Encoding::Brotli, "a wildcard accepts brotli");
+    expect(snapshot::preferredEncoding("", *second) == Encoding::Identity, "no header means identity");
+    expect(snapshot::preferredEncoding("identity", *second) == Encoding::Identity, "identity stays identity");
+
+    snapshot::publish("[]");
+    const auto tiny = snapshot::current();
+    expect(tiny->gzip.empty() && tiny->brotli.empty(), "encodings that do not shrink the body are skipped");
+    expect(snapshot::preferredEncoding("br, gzip", *tiny) == Encoding::Identity,
+           "a body without variants is served as identity");
+
+    if (failures != 0) {
+        std::cerr << failures << " live score snapshot assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Live score snapshot contracts passed\n";
+    return 0;
+}
@@ -35,5 +35,55 @@ int main() {
     assert(!shouldQueueScoringRefresh(true, true, now, now, std::chrono::hours(24)).enqueue);
     assert(!shouldQueueScoringRefresh(true, false, now, now - std::chrono::hours(30), std::chrono::hours(24)).enqueue);
 
+    using std::chrono::seconds;
+    CadencePolicy policy;
+    policy.live = seconds(120);
+    policy.idle = seconds(3600);
+    policy.kickoffLead = seconds(1800);
+
+    LiveWindow window;
+    window.liveGames = 3;
+    assert(nextCadence(window, policy).wait == seconds(120));
+    assert(nextCadence(window, policy).reason == "live");
+
+    window.liveGames = 0;
+    assert(nextCadence(window, policy).wait == seconds(3600));
+    assert(nextCadence(window, policy).reason == "idle");
+    window.secondsToKickoff = 600;
+    assert(nextCadence(window, policy).reason == "kickoff_imminent");
+    window.secondsToKickoff = -300;
+    assert(nextCadence(window, policy).wait == seconds(120));
+    window.secondsToKickoff = 2400;
+    assert(nextCadence(window, policy).wait == seconds(600));
+    window.secondsToKickoff = 1830;
+    assert(nextCadence(window, policy).wait == seconds(120));
+
+    window.secondsToKickoff.reset();
+    window.liveGames = 1;
+    policy.monthlyBudget = 1000;
+    policy.callsPerRun = 2;
+    window.monthlyCalls = 400;
+    window.secondsLeftInMonth = 600000;
+    assert(nextCadence(window, policy).reason == "budget_paced");
+    assert(nextCadence(window, policy).wait == seconds(2000));
+    assert(nextCadence(window, policy).run);
+    window.secondsLeftInMonth = 30000;
+    assert(nextCadence(window, policy).reason == "live");
+    window.monthlyCalls = 999;
+    assert(!nextCadence(window, policy).run);
+    assert(nextCadence(window, policy).reason == "budget_exhausted");
+    assert(nextCadence(window, policy).wait == seconds(3600));
+    window.secondsLeftInMonth = 30;
+    assert(nextCadence(window, policy).wait == seconds(120));
+    assert(!nextCadence(std::nullopt, policy).run);
+    assert(nextCadence(std::nullopt, policy).reason == "ledger_unavailable");
+    assert(nextCadence(std::nullopt, policy).wait == seconds(3600));
+    policy.monthlyBudget = 0;
+    assert(nextCadence(std::nullopt, policy).run);
+    assert(nextCadence(std::nullopt, policy).reason == "idle");
+
+    assert(retryDelay(1, std::chrono::milliseconds(750)) == std::chrono::milliseconds(750));
+    assert(retryDelay(3, std::chrono::milliseconds(750)) == std::chrono::milliseconds(3000));
+
     return 0;
 }
@@ -3,6 +3,7 @@ from pathlib import Path
 
 ROOT = Path(__file__).resolve().parents[2]
 SESSION_STORE = ROOT / "backend" / "src" / "auth_session_store.cpp"
+SESSION_CACHE = ROOT / "backend" / "src" / "auth_session_cache.cpp"
 SESSION_TESTS = ROOT / "backend" / "tests" / "auth_session_store_tests.cpp"
 AUTH_CONTRACTS = ROOT / "scripts" / "auth_contract_tests.py"
 
@@ -13,15 +14,18 @@ def require(condition, message):
 
 
 store = SESSION_STORE.read_text(encoding="utf-8")
+cache = SESSION_CACHE.read_text(encoding="utf-8")
 tests = SESSION_TESTS.read_text(encoding="utf-8")
 contracts = AUTH_CONTRACTS.read_text(encoding="utf-8")
 
-require("revokedTokens" in store,
+require("shard.revoked[digest]" in cache and "tokenDigest(token)" in cache,
         "session revocation does not retain an in-process denylist")
-require("tokenRevokedInMemory(token)" in store,
+require("cached.state == SessionTokenCache::State::Invalid" in store,
         "session lookup does not reject denylisted bearer tokens before storage lookup")
-require("revokedTokens[token] = now + kTokenTtl" in store,
+require("sessionCache().revoke(token, now + kTokenTtl)" in store,
         "revocation entries are not retained through the original token lifetime")
+require("revoked != shard.revoked.end() && revoked->second > now" in cache,
+        "a lookup racing logout can re-admit a revoked session")
 require("DELETE FROM auth_tokens" in store,
         "logout does not delete the persistent bearer token")
 require("persistent token revocation could not be confirmed" in store,
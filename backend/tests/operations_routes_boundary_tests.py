@@ -11,6 +11,8 @@ cmake = (root / "backend/CMakeLists.txt").read_text(encoding="utf-8")
 route_paths = (
     "/api/secure/ping",
     "/api/admin/ingest/cfbd",
+    "/api/admin/ingest/cfbd/jobs/{1}",
+    "/api/admin/ingest/cfbd/jobs/{1}/cancel",
     "/api/admin/ingest/cfbd/status",
     "/api/admin/ingest/cfbd/live",
     "/api/admin/ingest/cfbd/live/status",
@@ -48,7 +50,10 @@ required_contracts = (
     'response->setBody("unauthorized")',
     'response->setBody(R"({"status":"ok","scope":"secure"})")',
     "cff::http::requireAdmin(",
-    "cff::runCfbdIngestOnce()",
+    "cff::runCfbdIngestJob(progress)",
+    "cfbdIngestJobs().find(jobId)",
+    "jobs.cancel(jobId)",
+    "drogon::k202Accepted",
     "cff::runLiveScoreIngestOnce()",
     "cff::liveScoreIngestStatus()",
     'payload["status"] =',
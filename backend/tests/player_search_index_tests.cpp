@@ -0,0 +1,98 @@
+#include "player_search_index.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+cff::PlayerCard player(const std::string &id, const std::string &name, const std::string &team,
+                       const std::string &position, const std::string &conference, int season) {
+    cff::PlayerCard card;
+    card.id = id;
+    card.name = name;
+    card.team = team;
+    card.position = position;
+    card.conference = conference;
+    card.season = season;
+    return card;
+}
+
+std::string ids(const std::vector<cff::PlayerCard> &players) {
+    std::string output;
+    for (const auto &card : players) output += card.id + ",";
+    return output;
+}
+
+} // namespace
+
+int main() {
+    using cff::player_search_index::PlayerSearchIndex;
+    using cff::player_search_index::Query;
+
+    expect(cff::player_search_index::current() == nullptr, "no index is served before the first load");
+
+    PlayerSearchIndex index{{
+        player("wr1", "Ryan Williams", "Alabama", "WR", "SEC", 2025),
+        player("qb1", "Jalen Milroe", "Alabama", "QB", "SEC", 2025),
+        player("k1", "Will Reichard", "Alabama", "K", "SEC", 2025),
+        player("rb1", "Ashton Jeanty", "Boise State", "RB", "Mountain West", 2025),
+        player("qb2", "Cade Klubnik", "Clemson", "QB", "ACC", 2025),
+        player("ol1", "Kelvin Banks", "Texas", "OL", "SEC", 2025),
+        player("qb3", "Carson Beck", "Georgia", "QB", "SEC", 2024),
+        player("te1", "Brock Bowers", "Georgia", "te", "SEC", 2025),
+    }};
+    expect(index.size() == 8, "every player is indexed");
+
+    expect(ids(index.search(Query{"", {}, {}, {}, 25, 0})) == "qb2,qb1,rb1,wr1,te1,k1,ol1,qb3,",
+           "browsing follows season, position rank, then name");
+    expect(ids(index.search(Query{"", {}, {}, {}, 3, 2})) == "rb1,wr1,te1,", "limit and offset page the rank order");
+    expect(index.search(Query{"", {}, {}, {}, 25, 50}).empty(), "an offset past the end is empty");
+
+    expect(ids(index.search(Query{"JALEN", {}, {}, {}, 25, 0})) == "qb1,", "tokens match names case-insensitively");
+    expect(ids(index.search(Query{"lliam", {}, {}, {}, 25, 0})) == "wr1,", "tokens match inside a name");
+    expect(ids(index.search(Query{"alabama qb", {}, {}, {}, 25, 0})) == "qb1,",
+           "every token must match some field");
+    expect(ids(index.search(Query{"mountain", {}, {}, {}, 25, 0})) == "rb1,", "tokens match conferences");
+    expect(ids(index.search(Query{"k", {}, {}, {}, 25, 0})).find("k1,") != std::string::npos,
+           "single-character tokens match");
+    expect(ids(index.search(Query{"  te  ", {}, {}, {}, 25, 0})) == "rb1,te1,ol1,", "short tokens match any field");
+    expect(index.search(Query{"zzz", {}, {}, {}, 25, 0}).empty(), "an unknown gram matches nothing");
+    expect(index.search(Query{"alabamax", {}, {}, {}, 25, 0}).empty(), "trigram candidates are verified");
+    expect(index.search(Query{"ban%", {}, {}, {}, 25, 0}).empty(), "wildcard characters are literal");
+
+    expect(ids(index.search(Query{"", std::string{"qb"}, {}, {}, 25, 0})) == "qb2,qb1,qb3,",
+           "position filters are case-insensitive");
+    expect(ids(index.search(Query{"", std::string{"QB"}, std::string{"sec"}, {}, 25, 0})) == "qb1,qb3,",
+           "filters combine");
+    expect(ids(index.search(Query{"beck", std::string{"QB"}, {}, std::string{"GEORGIA"}, 25, 0})) == "qb3,",
+           "filters combine with tokens");
+    expect(index.search(Query{"", std::string{"Q"}, {}, {}, 25, 0}).empty(), "filters match whole values");
+    expect(index.search(Query{"", {}, {}, std::string{"Nowhere"}, 25, 0}).empty(), "an unknown filter is empty");
+    expect(ids(index.search(Query{"", std::string{""}, {}, {}, 2, 0})) == "qb2,qb1,", "an empty filter is ignored");
+
+    auto shared = std::make_shared<const PlayerSearchIndex>(std::vector<cff::PlayerCard>{
+        player("a", "A", "T", "QB", "C", 2025)});
+    cff::player_search_index::publish(shared);
+    expect(cff::player_search_index::current() == shared, "a published index is served");
+
+    const auto tokens = cff::player_search_index::tokenizeQuery("  Smith\tQB smith ");
+    expect(tokens == std::vector<std::string>{"qb", "smith"}, "query tokens are split, lower-cased and de-duplicated");
+    expect(cff::player_search_index::tokenizeQuery(" \n").empty(), "a blank query has no tokens");
+
+    if (failures != 0) {
+        std::cerr << failures << " player search index assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Player search index contracts passed\n";
+    return 0;
+}
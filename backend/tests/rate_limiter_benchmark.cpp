@@ -0,0 +1,143 @@
+// Auth rate-limit contention before and after the sharded limiter.
+//
+// The "global" baseline reproduces the previous takeRateLimit: one mutex for
+// every request, a deque of timestamps per key, and a full sweep of the map
+// under that mutex once it holds more than 25,000 keys. The "sharded" side is
+// cff::rate_limit::ShardedRateLimiter. Every thread replays a credential
+// stuffing burst: mostly fresh client keys with a few hot ones mixed in, so
+// the baseline map keeps crossing its sweep threshold.
+//
+//   rate_limiter_benchmark [attempts-per-thread] [threads]
+
+#include "rate_limiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+class GlobalLimiter {
+public:
+    bool take(const std::string &key, std::size_t limit, std::chrono::seconds window) {
+        const auto now = Clock::now();
+        const auto cutoff = now - window;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &bucket = buckets_[key];
+        bucket.lastSeen = now;
+        while (!bucket.attempts.empty() && bucket.attempts.front() <= cutoff) {
+            bucket.attempts.pop_front();
+        }
+        if (bucket.attempts.size() >= limit) return false;
+        bucket.attempts.push_back(now);
+
+        if (buckets_.size() > 25000) {
+            for (auto it = buckets_.begin(); it != buckets_.end();) {
+                if (it->second.attempts.empty() || it->second.lastSeen <= now - std::chrono::hours(1)) {
+                    it = buckets_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Bucket {
+        std::deque<Clock::time_point> attempts;
+        Clock::time_point lastSeen{Clock::now()};
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Bucket> buckets_;
+};
+
+struct Result {
+    double nanosPerAttempt{0};
+    double p99Micros{0};
+    double maxMicros{0};
+};
+
+// Keys are built before timing so both sides pay the same formatting cost.
+std::vector<std::string> burstKeys(std::size_t thread, std::size_t attempts) {
+    std::vector<std::string> keys;
+    keys.reserve(attempts);
+    for (std::size_t attempt = 0; attempt < attempts; ++attempt) {
+        if (attempt % 8 == 0) {
+            keys.push_back("/api/auth/login:client:hot-" + std::to_string(attempt % 64));
+        } else {
+            keys.push_back("/api/auth/login:client:" + std::to_string(thread) + "-" + std::to_string(attempt));
+        }
+    }
+    return keys;
+}
+
+template <typename Take>
+Result run(std::size_t threads, const std::vector<std::vector<std::string>> &keys, Take take) {
+    std::vector<std::vector<double>> latencies(threads);
+    std::vector<std::thread> workers;
+    const auto started = Clock::now();
+    for (std::size_t thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&, thread] {
+            auto &samples = latencies[thread];
+            samples.reserve(keys[thread].size());
+            for (const auto &key : keys[thread]) {
+                const auto before = Clock::now();
+                take(key);
+                samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - started).count();
+
+    std::vector<double> all;
+    for (auto &samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    std::sort(all.begin(), all.end());
+    Result result;
+    result.nanosPerAttempt = elapsed / static_cast<double>(all.size());
+    result.p99Micros = all[all.size() * 99 / 100];
+    result.maxMicros = all.back();
+    return result;
+}
+
+void print(const char *label, const Result &result) {
+    std::cout << label << result.nanosPerAttempt << " ns/attempt (wall), p99 "
+              << result.p99Micros << " us, max " << result.maxMicros << " us\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const std::size_t attempts = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const std::size_t threads = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::vector<std::string>> keys;
+    for (std::size_t thread = 0; thread < threads; ++thread) keys.push_back(burstKeys(thread, attempts));
+
+    GlobalLimiter global;
+    const auto baseline = run(threads, keys, [&](const std::string &key) {
+        return global.take(key, 10, std::chrono::seconds(60));
+    });
+    cff::rate_limit::ShardedRateLimiter sharded;
+    const auto current = run(threads, keys, [&](const std::string &key) {
+        return sharded.take(key, 10, std::chrono::seconds(60));
+    });
+
+    std::cout << "threads:           " << threads << '\n'
+              << "attempts/thread:   " << attempts << '\n';
+    print("global mutex:      ", baseline);
+    print("sharded limiter:   ", current);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "rate_limiter.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+using cff::rate_limit::Clock;
+
+// Aligned to a whole minute so window boundaries are predictable.
+const Clock::time_point origin{std::chrono::hours(1000)};
+
+std::size_t admitted(cff::rate_limit::ShardedRateLimiter &limiter,
+                     const std::string &key,
+                     std::size_t attempts,
+                     std::size_t limit,
+                     Clock::time_point now) {
+    std::size_t count = 0;
+    for (std::size_t attempt = 0; attempt < attempts; ++attempt) {
+        if (limiter.take(key, limit, std::chrono::seconds(60), now)) ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+    cff::rate_limit::ShardedRateLimiter limiter(1024, 8);
+    expect(limiter.capacity() == 1024, "capacity is split evenly across shards");
+
+    expect(admitted(limiter, "login:client:a", 10, 5, origin) == 5, "a window admits exactly the limit");
+    expect(admitted(limiter, "login:client:b", 10, 5, origin) == 5, "keys are limited independently");
+    expect(!limiter.take("login:client:a", 5, 60s, origin + 59s), "the limit holds for the whole window");
+    expect(!limiter.take("anything", 0, 60s, origin), "a zero limit admits nothing");
+
+    // Half of the previous window still overlaps: 5 * 0.5 = 2.5 counted.
+    expect(admitted(limiter, "login:client:a", 10, 5, origin + 90s) == 3,
+           "the previous window is weighted by its remaining overlap");
+    expect(admitted(limiter, "login:client:a", 10, 5, origin + 240s) == 5,
+           "a key idle for two windows starts fresh");
+
+    // Rejected attempts are not counted against the next window.
+    cff::rate_limit::ShardedRateLimiter rejected(1024, 8);
+    expect(admitted(rejected, "k", 100, 2, origin) == 2, "rejections are free");
+    expect(admitted(rejected, "k", 100, 2, origin + 120s) == 2, "rejections do not carry over");
+
+    // Far more keys than slots: the table never grows and a busy key that
+    // keeps refreshing its window outlives one-shot keys around it.
+    cff::rate_limit::ShardedRateLimiter small(64, 4);
+    for (int key = 0; key < 10000; ++key) {
+        small.take("busy", 3, 60s, origin + 30s);
+        small.take("one-shot-" + std::to_string(key), 3, 60s, origin + 30s);
+    }
+    expect(small.capacity() == 64, "the table stays at its fixed capacity");
+    expect(!small.take("busy", 3, 60s, origin + 30s), "the busy key kept its count through the flood");
+
+    // Junk keys flooding a limited key's shard cannot recycle its slot, even
+    // when every junk key is pushed to the limit itself.
+    cff::rate_limit::ShardedRateLimiter flooded(64, 4);
+    expect(admitted(flooded, "login:account:victim", 5, 5, origin + 10s) == 5, "the victim is limited");
+    for (int key = 0; key < 10000; ++key) {
+        flooded.take("login:account:junk-" + std::to_string(key), 5, 60s, origin + 20s);
+    }
+    expect(!flooded.take("login:account:victim", 5, 60s, origin + 30s),
+           "one-shot junk keys do not evict a limited key");
+    for (int key = 0; key < 1000; ++key) {
+        admitted(flooded, "login:account:heavy-" + std::to_string(key), 5, 5, origin + 40s);
+    }
+    expect(!flooded.take("login:account:victim", 5, 60s, origin + 50s),
+           "junk keys at the limit do not evict a limited key");
+
+    // Concurrent callers on one key never admit more than the limit.
+    cff::rate_limit::ShardedRateLimiter shared;
+    std::atomic<std::size_t> granted{0};
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&] {
+            for (int attempt = 0; attempt < 1000; ++attempt) {
+                if (shared.take("shared", 100, 60s, origin)) granted.fetch_add(1);
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    expect(granted.load() == 100, "concurrent takes admit exactly the limit");
+
+    if (failures != 0) {
+        std::cerr << failures << " rate limiter assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Rate limiter contracts passed\n";
+    return 0;
+}
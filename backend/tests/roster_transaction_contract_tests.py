@@ -26,7 +26,7 @@ def main() -> None:
     config = text("frontend/config.js")
     cmake = text("backend/CMakeLists.txt")
 
-    require('registerSyncAdvice(rosterTransactionAdvice)' in advice,
+    require('cff::http::addDispatchRoute(' in advice,
             "production advice is not installed")
     require('/roster/transactions' in advice and '/roster/state' in advice,
             "authoritative roster endpoints are missing")
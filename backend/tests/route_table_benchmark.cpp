@@ -0,0 +1,221 @@
+// Per-request routing overhead before and after the shared dispatch table.
+//
+// The "chained" baseline reproduces the pre-dispatch behaviour: every request
+// walked the onboarding advice and seven lifecycle advices in turn, and each
+// one tried its own pathLeagueId()/parse*Path() suffix matchers before
+// handing the request on. The "table" side resolves the same route set with
+// one RouteTable lookup. Neither side touches the database, so the numbers
+// isolate matching cost only.
+//
+//   route_table_benchmark [iterations]
+
+#include "route_table.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Route {
+    std::vector<drogon::HttpMethod> methods;
+    std::string suffix;
+};
+
+using Module = std::vector<Route>;
+
+std::vector<Module> lifecycleModules() {
+    using drogon::Delete;
+    using drogon::Get;
+    using drogon::Head;
+    using drogon::Patch;
+    using drogon::Post;
+    using drogon::Put;
+    return {
+        // schedule/lineup
+        {{{Get}, "/schedule/state"},
+         {{Post}, "/schedule/transactions"},
+         {{Post}, "/matchups/generate-season"},
+         {{Post}, "/matchups/generate"},
+         {{Get}, "/lineups/week/{}"},
+         {{Post}, "/lineups/week/{}/lock"},
+         {{Post}, "/lineups/week/{}/unlock"},
+         {{Post, Put}, "/roster/{}/slot"},
+         {{Post}, "/roster/drop"}},
+        // draft
+        {{{Get}, "/draft/readiness"},
+         {{Post}, "/draft/readiness"},
+         {{Post}, "/draft/auto-draft"},
+         {{Get}, "/draft"},
+         {{Put, Post}, "/draft/order"},
+         {{Post}, "/draft/start"},
+         {{Post}, "/draft/picks"},
+         {{Post}, "/draft/reset"},
+         {{Post}, "/draft/undo"}},
+        // roster transactions
+        {{{Get}, "/roster/state"},
+         {{Post}, "/roster/transactions"},
+         {{Post}, "/roster/drop"},
+         {{Post, Put}, "/roster/{}/slot"},
+         {{Post}, "/roster"}},
+        // waivers
+        {{{Get}, "/waivers/state"},
+         {{Post}, "/waivers/transactions"},
+         {{Get}, "/waiver-priority"},
+         {{Post}, "/waiver-priority/reset"},
+         {{Post}, "/waivers/process"},
+         {{Post}, "/waivers/reorder"},
+         {{Post}, "/waivers/{}/process"},
+         {{Post}, "/waivers/{}/status"},
+         {{Get}, "/waivers"},
+         {{Post}, "/waivers"}},
+        // trades
+        {{{Get}, "/trades/state"},
+         {{Post}, "/trades/transactions"},
+         {{Post}, "/trades/{}/status"},
+         {{Get}, "/trades"},
+         {{Post}, "/trades"}},
+        // scoring
+        {{{Get}, "/scoring/state"},
+         {{Get}, "/standings"},
+         {{Post}, "/scoring/transactions"},
+         {{Post}, "/score/week/{}/finalize"},
+         {{Post}, "/score/week/{}"}},
+        // onboarding (league-scoped part)
+        {{{Post}, "/join"},
+         {{Post}, "/members"},
+         {{Put, Post}, "/members/{}"}},
+        // stat ingestion matched exact admin paths for any method
+        {{{Get, Post, Put, Delete, Patch, Head}, "!/api/admin/ingest/cfbd/stats/status"},
+         {{Get, Post, Put, Delete, Patch, Head}, "!/api/admin/ingest/cfbd/stats/transactions"}},
+    };
+}
+
+// The legacy helper, verbatim in behaviour: allocates the suffix argument,
+// compares it against the path tail and copies the league id out.
+std::string pathLeagueId(const std::string &path, const std::string &suffix) {
+    const std::string prefix = "/api/leagues/";
+    if (path.rfind(prefix, 0) != 0 || suffix.empty()) return "";
+    if (path.size() <= prefix.size() + suffix.size()) return "";
+    if (path.substr(path.size() - suffix.size()) != suffix) return "";
+    return path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
+}
+
+// Shape of the legacy parse*Path helpers for suffixes with an inner id.
+bool parseNestedPath(const std::string &path, const std::string &suffix) {
+    const auto hole = suffix.find("{}");
+    const std::string marker = suffix.substr(0, hole);
+    const std::string tail = suffix.substr(hole + 2);
+    const std::string prefix = "/api/leagues/";
+    if (path.rfind(prefix, 0) != 0) return false;
+    const auto markerAt = path.find(marker, prefix.size());
+    if (markerAt == std::string::npos || markerAt == prefix.size()) return false;
+    const auto idStart = markerAt + marker.size();
+    if (tail.empty()) {
+        return idStart < path.size() && path.find('/', idStart) == std::string::npos;
+    }
+    if (path.size() <= idStart + tail.size()) return false;
+    return path.compare(path.size() - tail.size(), tail.size(), tail) == 0;
+}
+
+bool chainedMatch(const std::vector<Module> &modules, drogon::HttpMethod method, const std::string &path) {
+    for (const auto &module : modules) {
+        for (const auto &route : module) {
+            bool methodMatches = false;
+            for (const auto candidate : route.methods) methodMatches = methodMatches || candidate == method;
+            if (!methodMatches) continue;
+            if (route.suffix.front() == '!') {
+                if (path == route.suffix.substr(1)) return true;
+            } else if (route.suffix.find("{}") != std::string::npos) {
+                if (parseNestedPath(path, route.suffix)) return true;
+            } else if (!pathLeagueId(path, route.suffix).empty()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+cff::http::RouteTable buildTable(const std::vector<Module> &modules) {
+    cff::http::RouteTable table;
+    std::size_t target = 0;
+    for (const auto &module : modules) {
+        for (const auto &route : module) {
+            const auto pattern = route.suffix.front() == '!'
+                ? route.suffix.substr(1)
+                : "/api/leagues/{}" + route.suffix;
+            for (const auto method : route.methods) table.add(method, pattern, target);
+            ++target;
+        }
+    }
+    return table;
+}
+
+// Realistic mix: most traffic is live scores, player search and league reads
+// that no lifecycle module owns, so the chained advices paid full price for
+// each of them before falling through.
+std::vector<std::pair<drogon::HttpMethod, std::string>> requestMix() {
+    return {
+        {drogon::Get, "/api/scores/live"},
+        {drogon::Get, "/api/scores/live"},
+        {drogon::Get, "/api/scores/live"},
+        {drogon::Get, "/api/players/search"},
+        {drogon::Get, "/api/leagues"},
+        {drogon::Get, "/api/leagues/0f5c7d8e-league/draft"},
+        {drogon::Post, "/api/leagues/0f5c7d8e-league/draft/picks"},
+        {drogon::Get, "/api/leagues/0f5c7d8e-league/roster/state"},
+        {drogon::Get, "/api/leagues/0f5c7d8e-league/standings"},
+        {drogon::Post, "/api/leagues/0f5c7d8e-league/waivers/claim-42/process"},
+        {drogon::Get, "/api/leagues/0f5c7d8e-league/lineups/week/7"},
+        {drogon::Get, "/api/auth/session"},
+    };
+}
+
+template <typename Match>
+double nanosPerRequest(std::size_t iterations,
+                       const std::vector<std::pair<drogon::HttpMethod, std::string>> &mix,
+                       Match match,
+                       std::size_t &matched) {
+    matched = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        for (const auto &[method, path] : mix) {
+            if (match(method, path)) ++matched;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+    return elapsed.count() / static_cast<double>(iterations * mix.size());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const auto modules = lifecycleModules();
+    const auto table = buildTable(modules);
+    const auto mix = requestMix();
+
+    std::size_t chainedHits = 0;
+    const auto chained = nanosPerRequest(iterations, mix, [&](drogon::HttpMethod method, const std::string &path) {
+        return chainedMatch(modules, method, path);
+    }, chainedHits);
+
+    std::size_t tableHits = 0;
+    cff::http::RouteParams params;
+    const auto dispatched = nanosPerRequest(iterations, mix, [&](drogon::HttpMethod method, const std::string &path) {
+        return table.match(method, path, params) != nullptr;
+    }, tableHits);
+
+    std::cout << "routes:            " << table.size() << '\n'
+              << "requests per pass: " << mix.size() << '\n'
+              << "chained advices:   " << chained << " ns/request\n"
+              << "dispatch table:    " << dispatched << " ns/request\n";
+    if (chainedHits != tableHits) {
+        std::cerr << "route sets disagree: chained=" << chainedHits << " table=" << tableHits << '\n';
+        return 1;
+    }
+    return 0;
+}
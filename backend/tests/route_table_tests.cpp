@@ -0,0 +1,109 @@
+#include "route_table.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        ++failures;
+        std::cerr << "FAIL: " << message << '\n';
+    }
+}
+
+std::vector<std::size_t> targets(const cff::http::RouteTable &table,
+                                 drogon::HttpMethod method,
+                                 const std::string &path,
+                                 cff::http::RouteParams &params) {
+    const auto *found = table.match(method, path, params);
+    return found ? *found : std::vector<std::size_t>{};
+}
+
+} // namespace
+
+int main() {
+    using cff::http::RouteParams;
+    using cff::http::RouteTable;
+
+    RouteTable table;
+    table.add(drogon::Post, "/api/leagues", 0);
+    table.add(drogon::Post, "/api/leagues/{}/join", 1);
+    table.add(drogon::Get, "/api/leagues/{}/draft", 2);
+    table.add(drogon::Post, "/api/leagues/{}/waivers/process", 3);
+    table.add(drogon::Post, "/api/leagues/{}/waivers/{}/process", 4);
+    table.add(drogon::Post, "/api/leagues/{}/roster/{}/slot", 5);
+    table.add(drogon::Put, "/api/leagues/{}/roster/{}/slot", 5);
+    table.add(drogon::Post, "/api/leagues/{}/roster/{}/slot", 6);
+    table.add(drogon::Get, "/api/admin/ingest/cfbd/stats/status", 7);
+    expect(table.size() == 9, "every registration is counted");
+
+    RouteParams params;
+    expect(targets(table, drogon::Post, "/api/leagues", params) == std::vector<std::size_t>{0},
+           "literal collection route matches");
+    expect(params.empty(), "literal route captures nothing");
+
+    expect(targets(table, drogon::Post, "/api/leagues/join", params).empty(),
+           "a bare league collection suffix does not shadow a league id");
+    expect(targets(table, drogon::Post, "/api/leagues/league-1/join", params)
+               == std::vector<std::size_t>{1},
+           "league join resolves");
+    expect(params == RouteParams{"league-1"}, "league id is captured");
+
+    expect(targets(table, drogon::Post, "/api/leagues/league-1/draft", params).empty(),
+           "method is part of the key");
+    expect(params.empty(), "failed matches leave no captured params");
+    expect(targets(table, drogon::Get, "/api/leagues/league-1/draft", params)
+               == std::vector<std::size_t>{2},
+           "draft read resolves by method");
+
+    expect(targets(table, drogon::Post, "/api/leagues/league-1/waivers/process", params)
+               == std::vector<std::size_t>{3},
+           "literal segments win over placeholders");
+    expect(params == RouteParams{"league-1"}, "literal waiver route captures only the league");
+    expect(targets(table, drogon::Post, "/api/leagues/league-1/waivers/claim-9/process", params)
+               == std::vector<std::size_t>{4},
+           "placeholder claim route resolves");
+    expect(params == RouteParams{"league-1", "claim-9"}, "league and claim ids are captured in order");
+
+    table.add(drogon::Post, "/api/leagues/{}/waivers/process/all", 8);
+    expect(targets(table, drogon::Post, "/api/leagues/league-1/waivers/process/process", params)
+               == std::vector<std::size_t>{4},
+           "a dead-end literal branch backtracks to the placeholder");
+    expect(params == RouteParams{"league-1", "process"}, "backtracking discards stale captures");
+
+    expect(targets(table, drogon::Put, "/api/leagues/league-1/roster/player-2/slot", params)
+               == std::vector<std::size_t>{5},
+           "multi-method registration resolves for PUT");
+    expect(targets(table, drogon::Post, "/api/leagues/league-1/roster/player-2/slot", params)
+               == std::vector<std::size_t>{5, 6},
+           "handlers sharing a route keep registration order");
+
+    expect(targets(table, drogon::Get, "/api/leagues/league-1/draft/", params).empty(),
+           "trailing slash is not a match");
+    expect(targets(table, drogon::Get, "/api/leagues//draft", params).empty(),
+           "placeholders reject empty segments");
+    expect(targets(table, drogon::Get, "/api/leagues/a/b/draft", params).empty(),
+           "placeholders span exactly one segment");
+    expect(targets(table, drogon::Get, "api/leagues/league-1/draft", params).empty(),
+           "unrooted paths are rejected");
+    expect(targets(table, drogon::Get, "", params).empty(), "empty paths are rejected");
+    expect(targets(table, drogon::Get, "/api/scores/live", params).empty(),
+           "unregistered paths fall through");
+
+    expect(targets(table, drogon::Get, "/api/admin/ingest/cfbd/stats/status", params)
+               == std::vector<std::size_t>{7},
+           "exact admin routes resolve");
+    expect(targets(table, drogon::Get, "/api/admin/ingest/cfbd/stats", params).empty(),
+           "route prefixes are not matches");
+
+    if (failures != 0) {
+        std::cerr << failures << " route table assertion(s) failed\n";
+        return 1;
+    }
+    std::cout << "Route table contracts passed\n";
+    return 0;
+}
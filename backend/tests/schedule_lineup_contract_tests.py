@@ -43,7 +43,7 @@ def main() -> None:
         'schedule_lineup_hardening_mutations.inc',
         'schedule_lineup_hardening_advice.inc',
         'prepareLineupsForScoringInternal',
-        'const std::string marker = "/lineups/week/"',
+        'parseWeekSegment',
     )
     require(
         db_helpers,
@@ -71,10 +71,10 @@ def main() -> None:
         '/schedule/state',
         '/schedule/transactions',
         '/matchups/generate-season',
-        'parseLineupPath',
+        '"/lineups/week/{}"',
         'RosterSlotGuard',
         'RosterDropGuard',
-        'registerSyncAdvice',
+        'cff::http::addDispatchRoute(',
     )
     require(
         scoring_advice,
@@ -14,11 +14,11 @@ def require(path: str, *needles: str) -> None:
 def main() -> None:
     require(
         "backend/src/scoring_lifecycle_hardening_advice.inc",
-        'pathLeagueId(path, "/scoring/state")',
-        'pathLeagueId(path, "/standings")',
-        'pathLeagueId(path, "/scoring/transactions")',
-        'parseScoreWeekPath(path, "/finalize"',
-        "registerSyncAdvice(scoringLifecycleAdvice)",
+        '"/scoring/state", ScoringRoute::State',
+        '"/standings", ScoringRoute::Standings',
+        '"/scoring/transactions", ScoringRoute::Transaction',
+        '"/score/week/{}/finalize", ScoringRoute::LegacyFinalize',
+        "cff::http::addDispatchRoute(",
     )
     require(
         "backend/src/scoring_lifecycle_hardening_db.inc",
@@ -43,6 +43,8 @@ def main() -> None:
         "week_not_scored",
         "scoring_state_conflict",
         "alreadyFinal",
+        "jsonb_to_recordset($4::jsonb)",
+        "lastRowPerKey",
     )
     require(
         "backend/db/migrations/017_scoring_standings_reliability.sql",
@@ -70,8 +72,18 @@ def main() -> None:
         "backend/CMakeLists.txt",
         "src/scoring_lifecycle.cpp",
         "src/scoring_lifecycle_hardening.cpp",
+        "src/bulk_scoring.cpp",
         "scoring_lifecycle_tests",
+        "bulk_scoring_tests",
     )
+    require(
+        "backend/src/scoring_lifecycle_hardening_bulk.inc",
+        "scoring_recalculation_queue",
+        "jsonb_array_elements_text($3::jsonb)",
+        "ProfilePoints",
+        "forEachPartitioned",
+    )
+    require("backend/src/stat_ingestion_hardening_mutations.inc", "requestDrain(season, week)")
     print("scoring lifecycle source contracts passed")
 
 
@@ -55,6 +55,34 @@ int main() {
     assert(closeTo(cff::scoring_lifecycle::fantasyPointsForStat(settings, "receiving", "receptions", 8), 8));
     assert(closeTo(cff::scoring_lifecycle::fantasyPointsForStat(settings, "misc", "fumbles lost", 1), -2));
 
+    using cff::scoring_lifecycle::StatRule;
+    const auto passYards = cff::scoring_lifecycle::internStat("passing", "passYards");
+    assert(passYards.rule == StatRule::PassingYards);
+    assert(cff::scoring_lifecycle::internStat("passing", "passYards").id == passYards.id);
+    assert(cff::scoring_lifecycle::internStat("Passing", "pass yards").rule == StatRule::PassingYards);
+    assert(cff::scoring_lifecycle::internStat("passing", "passInt").rule == StatRule::Interception);
+    assert(cff::scoring_lifecycle::internStat("rushing", "rushTwoPt").rule == StatRule::TwoPoint);
+    assert(cff::scoring_lifecycle::internStat("rushing", "rushAttempts").rule == StatRule::None);
+    assert(cff::scoring_lifecycle::internStat("defense", "recYards").rule == StatRule::None);
+    assert(cff::scoring_lifecycle::internStat("defense", "recYards").id == 0);
+    assert(cff::scoring_lifecycle::internStat("misc", "fumbles lost").rule == StatRule::FumbleLost);
+    assert(cff::scoring_lifecycle::internStat("rushing", "yds").id
+           != cff::scoring_lifecycle::internStat("receiving", "yds").id);
+
+    const auto compiled = cff::scoring_lifecycle::compiledScoringFor("league-1", settings);
+    assert(compiled == cff::scoring_lifecycle::compiledScoringFor("league-1", settings));
+    double total = 0.0;
+    total = compiled->accumulate(total, passYards, 250);
+    total = compiled->accumulate(total, cff::scoring_lifecycle::internStat("passing", "passTD"), 2);
+    total = compiled->accumulate(total, cff::scoring_lifecycle::internStat("rushing", "rushAttempts"), 12);
+    assert(closeTo(total, 18));
+
+    Json::Value changed = settings;
+    changed["passingYardsPerPoint"] = 0;
+    const auto recompiled = cff::scoring_lifecycle::compiledScoringFor("league-1", changed);
+    assert(recompiled != compiled);
+    assert(closeTo(recompiled->points(passYards, 250), 0));
+
     Json::Value body(Json::objectValue);
     body["expectedVersion"] = Json::Int64(4);
     assert(cff::scoring_lifecycle::expectedVersionMatches(4, body, true));
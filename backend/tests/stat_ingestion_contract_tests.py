@@ -13,7 +13,11 @@ db = read("backend/src/stat_ingestion_hardening_db.inc")
 payload = read("backend/src/stat_ingestion_hardening_payload.inc")
 mutations = read("backend/src/stat_ingestion_hardening_mutations.inc")
 advice = read("backend/src/stat_ingestion_hardening_advice.inc")
+provider = read("backend/src/stat_ingestion_hardening_provider.inc")
+mapping = read("backend/src/cfbd_stat_mapping.cpp")
 migration = read("backend/db/migrations/019_stat_ingestion_reliability.sql")
+roster_index = read("backend/db/migrations/022_roster_player_index.sql")
+schema = read("backend/db/schema.sql")
 cmake = read("backend/CMakeLists.txt")
 
 assert "statRecordKey" in rules
@@ -43,11 +47,25 @@ assert "final_week_immutable" in rules
 assert "source_hash" in mutations
 assert "source_revision" in mutations
 assert "recover" in mutations
+assert "r.player_id = ANY($1::text[])" in mutations
+assert "WHERE r.player_id = $1\"" not in mutations
+assert "jsonb_to_recordset($1::jsonb)" in mutations
+
+# The in-process CFBD adapter shares the transactions API's lease and
+# queueing instead of writing player_stats on its own.
+for helper in ("claimRunLease(", "renewLease(", "completeRun(", "failRun(", "enqueueAffectedLeagues("):
+    assert helper in mutations, helper
+    assert helper in provider, helper
+assert "WHERE player_stats.source_hash <> EXCLUDED.source_hash" in provider
+assert "player_stat_revisions" in provider
+assert "requestDrain" in provider
+assert "statSourceHash" in mapping
+assert "statRecordKey" in mapping
 
 assert "/api/admin/ingest/cfbd/stats/status" in advice
 assert "/api/admin/ingest/cfbd/stats/transactions" in advice
 assert "isAdminRequest" in advice
-assert "registerSyncAdvice" in advice
+assert "cff::http::addDispatchRoute(" in advice
 
 assert "CREATE TABLE IF NOT EXISTS stat_ingestion_states" in migration
 assert "CREATE TABLE IF NOT EXISTS stat_ingestion_operations" in migration
@@ -57,9 +75,14 @@ assert "source_hash" in migration
 assert "lease_expires_at" in migration
 assert "next_retry_at" in migration
 assert "cff_mark_stat_source_stale" in migration
+assert "idx_rosters_player" in roster_index
+assert "idx_rosters_player" in schema
 
 assert "src/stat_ingestion_lifecycle.cpp" in cmake
 assert "src/stat_ingestion_hardening.cpp" in cmake
 assert "stat_ingestion_lifecycle_tests" in cmake
+assert "src/cfbd_stat_mapping.cpp" in cmake
+assert "src/cfbd_player_stats.cpp" in cmake
+assert "cfbd_stat_mapping_tests" in cmake
 
 print("stat ingestion source contracts passed")
@@ -20,10 +20,10 @@ def main() -> None:
     )
     require(
         "backend/src/trade_lifecycle_hardening_advice.inc",
-        'pathLeagueId(path, "/trades/state")',
-        'pathLeagueId(path, "/trades/transactions")',
-        'parseTradePath(path, "/status"',
-        "registerSyncAdvice(tradeLifecycleAdvice)",
+        '"/trades/state", TradeRoute::State',
+        '"/trades/transactions", TradeRoute::Transaction',
+        '"/trades/{}/status", TradeRoute::Status',
+        "cff::http::addDispatchRoute(",
     )
     require(
         "backend/src/trade_lifecycle_hardening_db.inc",
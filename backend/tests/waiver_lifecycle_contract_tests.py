@@ -33,14 +33,17 @@ def main() -> None:
             "monotonic waiver version is absent")
     require("ROW_NUMBER() OVER (ORDER BY priority" in db, "dense priority rotation is absent")
 
-    require("SAVEPOINT waiver_claim_step" in mutations, "per-claim savepoint is absent")
-    require("ROLLBACK TO SAVEPOINT waiver_claim_step" in mutations,
-            "failed claim rollback is absent")
+    require("cff::waiver_lifecycle::resolveWaiverRun(" in mutations,
+            "waiver runs are not resolved from one in-memory snapshot")
+    require("applyWaiverRun(" in mutations and "jsonb_to_recordset" in mutations,
+            "waiver run outcomes are not written as one batch")
+    require("affectedRows(resolved) != static_cast<long long>(outcomes.size())" in mutations,
+            "batched claim outcomes are not checked against the resolved run")
     require("waiver_claim_out_of_order" in mutations,
             "single-claim processing can bypass deterministic order")
-    require("moveManagerToBackDb" in mutations,
+    require("UPDATE waiver_priorities w SET priority = b.priority" in mutations,
             "winning manager priority advancement is absent")
-    require("advanceRosterVersion" in mutations,
+    require("SET version = roster_states.version + 1" in mutations,
             "waiver processing does not advance roster revision")
     require("ON CONFLICT (league_id, player_id) DO NOTHING" in mutations,
             "one-owner database conflict handling is absent")
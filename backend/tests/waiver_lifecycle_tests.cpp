@@ -102,6 +102,107 @@ void testPriorityRotationContracts() {
            "priority rotation did not remain dense");
 }
 
+Json::Value runClaim(const std::string &id,
+                     const std::string &manager,
+                     const std::string &addPlayerId,
+                     const std::string &dropPlayerId,
+                     int order) {
+    auto value = claim(id, manager, order, "2026-08-04T00:00:0" + std::to_string(order) + "Z");
+    value["addPlayerId"] = addPlayerId;
+    value["addPlayer"]["name"] = "Player " + addPlayerId;
+    value["dropPlayerId"] = dropPlayerId;
+    return value;
+}
+
+Json::Value rosteredPlayer(const std::string &id) {
+    Json::Value player(Json::objectValue);
+    player["id"] = id;
+    player["rosterSlot"] = "BN";
+    return player;
+}
+
+void testInMemoryWaiverRun() {
+    Json::Value board(Json::arrayValue);
+    for (const auto *email : {"a@example.com", "b@example.com"}) {
+        Json::Value entry(Json::objectValue);
+        entry["managerEmail"] = email;
+        entry["priority"] = static_cast<int>(board.size()) + 1;
+        board.append(entry);
+    }
+    Json::Value rosters(Json::objectValue);
+    rosters["a@example.com"].append(rosteredPlayer("a-bench"));
+    rosters["b@example.com"].append(rosteredPlayer("b-bench"));
+    rosters["b@example.com"].append(rosteredPlayer("b-spare"));
+
+    Json::Value claims(Json::arrayValue);
+    claims.append(runClaim("a1", "a@example.com", "star", "", 1));
+    claims.append(runClaim("a2", "a@example.com", "sleeper", "", 2));
+    claims.append(runClaim("b1", "b@example.com", "star", "", 1));
+    claims.append(runClaim("b2", "b@example.com", "sleeper", "b-bench", 2));
+    claims.append(runClaim("b3", "b@example.com", "rookie", "not-mine", 3));
+    claims.append(runClaim("a3", "a@example.com", "rookie", "", 3));
+
+    // Each roster holds at most two players.
+    const auto assign = [](const Json::Value &, const Json::Value &roster, const std::string &dropPlayerId)
+        -> std::optional<std::string> {
+        if (roster.size() - (dropPlayerId.empty() ? 0 : 1) >= 2) return std::nullopt;
+        return std::string{"BN"};
+    };
+    const auto run = cff::waiver_lifecycle::resolveWaiverRun(claims, board, rosters, assign, 1000);
+    std::string trace;
+    for (const auto &outcome : run.outcomes) {
+        trace += outcome.claimId + ":" + (outcome.failureCode.empty() ? outcome.status : outcome.failureCode) + " ";
+    }
+    expect(trace == "a1:processed b1:player_unavailable b2:processed a2:player_unavailable "
+                    "a3:roster_full b3:drop_player_not_rostered ",
+           "in-memory run order or outcomes changed: " + trace);
+    expect(run.outcomes[2].dropPlayerId == "b-bench" && run.outcomes[2].rosterSlot == "BN",
+           "processed claim lost its drop or slot");
+    expect(run.priorityBoard[0]["managerEmail"].asString() == "a@example.com"
+           && run.priorityBoard[1]["managerEmail"].asString() == "b@example.com",
+           "winners did not rotate to the back in order");
+    expect(run.rosters["b@example.com"].size() == 2
+           && run.rosters["b@example.com"][1]["id"].asString() == "sleeper",
+           "in-memory roster did not apply the drop and add");
+
+    const auto single = cff::waiver_lifecycle::resolveWaiverRun(claims, board, rosters, assign, 1);
+    expect(single.outcomes.size() == 1 && single.outcomes[0].claimId == "a1",
+           "single-claim run did not take the first claim in priority order");
+}
+
+cff::waiver_lifecycle::ClaimOutcome processedClaim(const std::string &claimId,
+                                                   const std::string &managerEmail,
+                                                   const std::string &playerId,
+                                                   const std::string &dropPlayerId) {
+    cff::waiver_lifecycle::ClaimOutcome outcome;
+    outcome.claimId = claimId;
+    outcome.managerEmail = managerEmail;
+    outcome.playerId = playerId;
+    outcome.dropPlayerId = dropPlayerId;
+    outcome.rosterSlot = "BN";
+    outcome.status = "processed";
+    return outcome;
+}
+
+void testNetRosterChanges() {
+    cff::waiver_lifecycle::WaiverRun run;
+    run.outcomes.push_back(processedClaim("a1", "a@example.com", "star", "a-bench"));
+    run.outcomes.push_back(processedClaim("a2", "a@example.com", "sleeper", "star"));
+    auto failed = processedClaim("c1", "c@example.com", "star", "");
+    failed.status = "failed";
+    failed.failureCode = "player_unavailable";
+    run.outcomes.push_back(failed);
+    run.outcomes.push_back(processedClaim("b1", "b@example.com", "star", "b-bench"));
+
+    const auto net = cff::waiver_lifecycle::netRosterChanges(run);
+    expect(net.drops.size() == 2 && net.drops[0].playerId == "a-bench" && net.drops[1].playerId == "b-bench",
+           "only players rostered before the run are dropped");
+    expect(net.adds.size() == 2, "a player added, dropped and claimed again is inserted once");
+    expect(net.adds[0]->playerId == "star" && net.adds[0]->claimId == "b1"
+               && net.adds[1]->playerId == "sleeper",
+           "a re-claimed player is inserted for its final owner");
+}
+
 void testIdentityNormalization() {
     expect(cff::waiver_lifecycle::canonicalEmail("  USER@Example.COM ") == "user@example.com",
            "email normalization changed");
@@ -115,6 +216,8 @@ int main() {
     testVersionContracts();
     testExactReorderContracts();
     testPriorityRotationContracts();
+    testInMemoryWaiverRun();
+    testNetRosterChanges();
     testIdentityNormalization();
     std::cout << "waiver lifecycle policy contracts passed" << std::endl;
     return 0;
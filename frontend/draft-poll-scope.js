@@ -1,13 +1,120 @@
-(() => {
+(function initDraftPollScope(root) {
   'use strict';
 
-  const pageName = window.location.pathname.split('/').pop() || '';
+  const RECONNECT_BASE_MS = 1000;
+  const RECONNECT_MAX_MS = 30000;
+
+  function draftSocketUrl(apiBase, location) {
+    const base = String(apiBase || '/api').replace(/\/+$/, '');
+    const url = new URL(`${base}/draft/socket`, location?.href || 'http://localhost/');
+    url.protocol = url.protocol === 'https:' ? 'wss:' : 'ws:';
+    return url.toString();
+  }
+
+  function reconnectDelay(attempt) {
+    return Math.min(RECONNECT_MAX_MS, RECONNECT_BASE_MS * 2 ** Math.max(0, Number(attempt) || 0));
+  }
+
+  // Decides whether a room message should trigger a refetch of this manager's
+  // draft payload. Deltas only carry shared board state, so the client still
+  // reads its own queue and readiness through GET, but only when something
+  // actually moved.
+  function roomMessageAction(message, room) {
+    if (!message || typeof message !== 'object') return 'ignore';
+    const sequence = Number(message.sequence) || 0;
+    const version = Number(message.version) || 0;
+    if (message.type === 'subscribed') {
+      room.sequence = sequence;
+      if (message.resync === true || version > room.version) {
+        room.version = Math.max(room.version, version);
+        return 'refetch';
+      }
+      return 'ignore';
+    }
+    if (message.type === 'error') return 'close';
+    if (sequence <= room.sequence) return 'ignore';
+    room.sequence = sequence;
+    if (version > room.version) {
+      room.version = version;
+      return 'refetch';
+    }
+    // Readiness and auto-draft toggles do not bump the draft version.
+    return message.type === 'readiness_changed' ? 'refetch' : 'ignore';
+  }
+
+  const helpers = { draftSocketUrl, reconnectDelay, roomMessageAction };
+  if (typeof module !== 'undefined' && module.exports) module.exports = helpers;
+  if (typeof document === 'undefined') return;
+
+  const pageName = root.location.pathname.split('/').pop() || '';
   if (pageName !== 'draft.html') return;
 
-  const nativeSetInterval = window.setInterval.bind(window);
+  const nativeSetInterval = root.setInterval.bind(root);
+  const room = { sequence: 0, version: 0, leagueId: '' };
+  let socket = null;
+  let socketLive = false;
+  let reconnectAttempts = 0;
+  let reconnectTimer = null;
   let draftPollIntercepted = false;
 
-  window.setInterval = function scopedDraftSetInterval(callback, delay, ...args) {
+  async function refreshDraft() {
+    try {
+      await root.syncDraftFromApi?.();
+    } catch {
+      // Keep the last authoritative draft snapshot visible during an outage.
+    }
+    root.renderAll?.();
+  }
+
+  function scheduleReconnect() {
+    if (reconnectTimer || typeof root.WebSocket !== 'function') return;
+    reconnectTimer = root.setTimeout(() => {
+      reconnectTimer = null;
+      connectRoom();
+    }, reconnectDelay(reconnectAttempts++));
+  }
+
+  function connectRoom() {
+    const token = root.getAuthState?.()?.token;
+    const leagueId = root.getLeagueState?.()?.id;
+    if (!token || !leagueId || typeof root.WebSocket !== 'function' || socket) return;
+    if (room.leagueId !== leagueId) Object.assign(room, { sequence: 0, version: 0, leagueId });
+    room.version = Math.max(room.version, Number(root.CFFDraftLifecycle?.currentVersion?.()) || 0);
+
+    let current;
+    try {
+      current = new root.WebSocket(draftSocketUrl(root.CFF_API_BASE, root.location));
+    } catch {
+      scheduleReconnect();
+      return;
+    }
+    socket = current;
+    current.addEventListener('open', () => {
+      current.send(JSON.stringify({ type: 'subscribe', leagueId, token, sinceSequence: room.sequence }));
+    });
+    current.addEventListener('message', (event) => {
+      let message;
+      try {
+        message = JSON.parse(event.data);
+      } catch {
+        return;
+      }
+      if (message?.type === 'subscribed') {
+        socketLive = true;
+        reconnectAttempts = 0;
+      }
+      const action = roomMessageAction(message, room);
+      if (action === 'refetch') void refreshDraft();
+      if (action === 'close') current.close();
+    });
+    current.addEventListener('close', () => {
+      if (socket === current) socket = null;
+      socketLive = false;
+      scheduleReconnect();
+    });
+  }
+
+  root.setInterval = function scopedDraftSetInterval(callback, delay, ...args) {
     const isDraftPoll = !draftPollIntercepted
       && Number(delay) === 2000
       && typeof callback === 'function'
@@ -18,16 +125,16 @@
     }
 
     draftPollIntercepted = true;
-    window.setInterval = nativeSetInterval;
+    root.setInterval = nativeSetInterval;
+    connectRoom();
 
+    // The poll stays as the fallback: while the room socket is live the ticks
+    // are skipped and deltas drive refreshes instead.
     return nativeSetInterval(async () => {
-      if (document.visibilityState !== 'visible' || !window.getAuthState?.()?.token) return;
-      try {
-        await window.syncDraftFromApi?.();
-      } catch {
-        // Keep the last authoritative draft snapshot visible during an outage.
-      }
-      window.renderAll?.();
+      if (document.visibilityState !== 'visible' || !root.getAuthState?.()?.token) return;
+      if (socketLive) return;
+      connectRoom();
+      await refreshDraft();
     }, delay, ...args);
   };
-})();
+})(typeof window !== 'undefined' ? window : globalThis);
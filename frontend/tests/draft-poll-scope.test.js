@@ -0,0 +1,27 @@
+'use strict';
+
+const assert = require('node:assert/strict');
+const path = require('node:path');
+
+const { draftSocketUrl, reconnectDelay, roomMessageAction } = require(path.join('..', 'draft-poll-scope.js'));
+
+assert.equal(draftSocketUrl('/api', { href: 'https://app.example.test/draft.html' }), 'wss://app.example.test/api/draft/socket');
+assert.equal(draftSocketUrl('http://localhost:8080/api/', { href: 'http://localhost:3000/draft.html' }), 'ws://localhost:8080/api/draft/socket');
+assert.equal(reconnectDelay(0), 1000);
+assert.equal(reconnectDelay(3), 8000);
+assert.equal(reconnectDelay(20), 30000, 'reconnect backoff must be capped');
+
+const room = { sequence: 0, version: 4 };
+assert.equal(roomMessageAction({ type: 'subscribed', sequence: 3, version: 4 }, room), 'ignore', 'an unchanged room must not refetch');
+assert.equal(room.sequence, 3);
+assert.equal(roomMessageAction({ type: 'pick_made', sequence: 2, version: 5 }, room), 'ignore', 'replayed deltas already covered by the hello are skipped');
+assert.equal(roomMessageAction({ type: 'pick_made', sequence: 4, version: 5 }, room), 'refetch');
+assert.equal(room.version, 5);
+assert.equal(roomMessageAction({ type: 'pick_made', sequence: 4, version: 5 }, room), 'ignore', 'duplicate deltas must not refetch');
+assert.equal(roomMessageAction({ type: 'clock_reset', sequence: 5, version: 5 }, room), 'ignore', 'deltas without a newer version must not refetch');
+assert.equal(roomMessageAction({ type: 'readiness_changed', sequence: 6, version: 5 }, room), 'refetch', 'readiness does not bump the draft version');
+assert.equal(roomMessageAction({ type: 'subscribed', sequence: 9, version: 5, resync: true }, room), 'refetch', 'a resync must refetch');
+assert.equal(roomMessageAction({ type: 'error', code: 'authentication_required' }, room), 'close');
+assert.equal(roomMessageAction(null, room), 'ignore');
+
+console.log('draft poll scope runtime tests passed');
@@ -46,7 +46,7 @@ assert 'response.status_code == 429' in cfbd_ingest
 assert 'cpr::Parameters{{"year", season}, {"classification", "fbs"}}' in cfbd_ingest
 assert 'CFBD bulk FBS roster' in cfbd_ingest
 assert 'cpr::Parameters{{"team", team.school}' not in cfbd_ingest
-run_start = cfbd_ingest.index('IngestResult runCfbdIngestOnce')
+run_start = cfbd_ingest.index('IngestResult ingestPlayers')
 assert cfbd_ingest.index('if (players.empty()) {', run_start) < cfbd_ingest.index('upsertPlayersToPostgres(', run_start)
 assert 'Json::Value cachedLiveScoreMeta();' in live_h
 assert 'id="scoreboard-freshness"' in index
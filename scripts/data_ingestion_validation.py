@@ -103,8 +103,14 @@ def main() -> int:
             "POST",
             "/api/admin/ingest/cfbd",
             token=admin_token,
-            expected=(200,),
+            expected=(202,),
         ).payload
+        # The refresh runs as a background job; poll it until it finishes.
+        job_path = f"/api/admin/ingest/cfbd/jobs/{ingest_result.get('jobId', '')}"
+        ingest_deadline = started + int_env("CFF_INGEST_TIMEOUT_SECONDS", 900, 1)
+        while ingest_result.get("status") in ("queued", "running") and time.monotonic() < ingest_deadline:
+            time.sleep(5)
+            ingest_result = client.request("GET", job_path, token=admin_token).payload
         evidence["playerIngest"] = ingest_result
         add_check(checks, "Triggered player ingestion completed", ingest_result.get("status") == "ok", str(ingest_result))
         evidence["playerIngestSeconds"] = round(time.monotonic() - started, 2)
@@ -26,6 +26,11 @@ def main() -> None:
         "mayStartRun",
         "aggregateStatus",
         "scoringRefreshReady",
+        "runCfbdPlayerStatIngestOnce",
+        "kPlayerStatSource",
+        "nextCadence",
+        "loadLiveWindow",
+        "CFF_CFBD_MONTHLY_CALL_BUDGET",
     )
     require(
         "backend/src/live_stat_routes.cpp",
@@ -55,14 +60,24 @@ def main() -> None:
         "CFF_LIVE_STAT_INTERVAL_MINUTES",
         "CFF_LIVE_STAT_MAX_ATTEMPTS",
         "CFF_LIVE_STAT_DEDUPE_MINUTES",
+        "CFF_LIVE_STAT_LIVE_SECONDS",
+        "CFF_LIVE_STAT_KICKOFF_LEAD_MINUTES",
+        "CFF_CFBD_MONTHLY_CALL_BUDGET",
     )
 
-    # Score refresh must not be queued from scoreboard-only data. That remains
-    # gated until the player-stat adapter supplies authoritative stat changes.
+    # Score refresh must not be queued from scoreboard-only data; leagues are
+    # queued only by the stat ingestion lease when player stats change.
     if "INSERT INTO scoring_refresh_queue" in worker:
         raise AssertionError(
             "scoreboard-only worker must not enqueue fantasy scoring refreshes"
         )
+    # Retry backoff belongs to the scheduler; a run never sleeps while it
+    # holds its claim.
+    run_body = worker.split("Json::Value runCfbdLiveStatWorker(", 1)[1].split(
+        "Json::Value liveStatOperatorStatus(", 1
+    )[0]
+    if "sleep_for" in run_body:
+        raise AssertionError("live stat runs must not block on retry backoff")
     if "CFF_LIVE_STAT_INTERVAL_MINUTES" not in env:
         raise AssertionError("scheduled worker configuration is undocumented")
 
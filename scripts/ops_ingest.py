@@ -91,6 +91,20 @@ def request_with_retries(method, path, *, admin=False, timeout=120, retries=5, r
     raise RuntimeError(f"{method} {path} failed after {retries} attempts: {last_error}")
 
 
+def wait_for_ingest_job(job, timeout, poll_interval):
+    """Polls a background ingest job until it leaves queued/running."""
+    job_id = job.get("jobId")
+    if not job_id:
+        return job
+    deadline = time.monotonic() + timeout
+    while str(job.get("status", "")).lower() in ("queued", "running"):
+        if time.monotonic() >= deadline:
+            raise RuntimeError(f"CFBD ingestion job {job_id} did not finish within {timeout}s: {job}")
+        time.sleep(poll_interval)
+        job = request("GET", f"/api/admin/ingest/cfbd/jobs/{job_id}", admin=True, timeout=30)
+    return job
+
+
 def main():
     parser = argparse.ArgumentParser(description="Private CFBD ingestion operations helper.")
     parser.add_argument("--run", action="store_true", help="Trigger a one-off CFBD ingest before reading status.")
@@ -126,12 +140,13 @@ def main():
             retry_delay=retry_delay,
         )
     if args.run:
-        result["ingest"] = request(
+        started = request(
             "POST",
             "/api/admin/ingest/cfbd",
             admin=True,
             timeout=ingest_timeout,
         )
+        result["ingest"] = wait_for_ingest_job(started, ingest_timeout, retry_delay)
         ingest_status = str(result["ingest"].get("status", "")).lower()
         if ingest_status != "ok" and not args.allow_partial:
             raise RuntimeError(f"CFBD ingestion did not complete successfully: {result['ingest']}")
@@ -64,6 +64,45 @@ class OpsIngestTests(unittest.TestCase):
         self.assertIn(("POST", "/api/admin/ingest/cfbd", True, 900), calls)
         self.assertIn(("GET", "/api/admin/ingest/cfbd/status", True, 30), calls)
 
+    def test_background_job_is_polled_until_it_finishes(self):
+        job_path = "/api/admin/ingest/cfbd/jobs/cfbd-1-1"
+        polls = iter([
+            {"jobId": "cfbd-1-1", "status": "running", "phase": "staging"},
+            {"jobId": "cfbd-1-1", "status": "ok", "ingested": 100},
+        ])
+        calls = []
+
+        def fake_request(method, path, admin=False, timeout=120):
+            calls.append((method, path, admin, timeout))
+            if path == job_path:
+                return next(polls)
+            return {
+                ("GET", "/health"): {"status": "ok", "database": "ok"},
+                ("GET", "/api/health"): {"status": "ok", "database": "ok"},
+                ("POST", "/api/admin/ingest/cfbd"): {"jobId": "cfbd-1-1", "status": "running"},
+                ("GET", "/api/admin/ingest/cfbd/status"): {"status": "ok"},
+            }[(method, path)]
+
+        stdout = io.StringIO()
+        with mock.patch.object(OPS_INGEST, "request", side_effect=fake_request), \
+             mock.patch.object(OPS_INGEST.time, "sleep"), \
+             mock.patch.object(sys, "argv", [str(SCRIPT_PATH), "--run"]), \
+             contextlib.redirect_stdout(stdout):
+            OPS_INGEST.main()
+
+        self.assertIn('"ingested": 100', stdout.getvalue())
+        self.assertEqual(sum(1 for call in calls if call[1] == job_path), 2)
+
+    def test_cancelled_job_fails_the_cron_run(self):
+        with self.assertRaisesRegex(RuntimeError, "did not complete successfully"):
+            self.run_main({
+                ("GET", "/health"): {"status": "ok", "database": "ok"},
+                ("GET", "/api/health"): {"status": "ok", "database": "ok"},
+                ("POST", "/api/admin/ingest/cfbd"): {"jobId": "cfbd-1-1", "status": "running"},
+                ("GET", "/api/admin/ingest/cfbd/jobs/cfbd-1-1"): {"jobId": "cfbd-1-1", "status": "cancelled"},
+                ("GET", "/api/admin/ingest/cfbd/status"): {"status": "ok"},
+            })
+
     def test_partial_ingest_fails_the_cron_run(self):
         with self.assertRaisesRegex(RuntimeError, "did not complete successfully"):
             self.run_main({
@@ -89,7 +89,9 @@ def main() -> int:
     require("requireAdmin" not in source, "public endpoints became administrator-protected")
 
     required_behavior = (
-        "cachedLiveScorePayload()",
+        "cff::liveScoreSnapshot()",
+        "etagMatches(request->getHeader(\"if-none-match\")",
+        "drogon::k304NotModified",
         "cachedLiveScoreMeta()",
         "playerCatalogMeta()",
         'getParameter("query")',